@@ -128,6 +128,16 @@ enum class EGWTEnemyType : uint8
     Boss        UMETA(DisplayName = "Boss")
 };
 
+// Enemy AI level of detail, from the player's rooms outward
+UENUM(BlueprintType)
+enum class EGWTAILOD : uint8
+{
+    Full        UMETA(DisplayName = "Full"),
+    Reduced     UMETA(DisplayName = "Reduced"),
+    Minimal     UMETA(DisplayName = "Minimal"),
+    Dormant     UMETA(DisplayName = "Dormant")
+};
+
 // Item rarity
 UENUM(BlueprintType)
 enum class EGWTItemRarity : uint8
@@ -195,6 +205,14 @@ enum class EGWTSpellComponentType : uint8
     Flow        UMETA(DisplayName = "Flow")
 };
 
+// How a spell node fires when several connections activate it in one pass
+UENUM(BlueprintType)
+enum class EGWTJoinMode : uint8
+{
+    Once            UMETA(DisplayName = "Once"),
+    PerActivation   UMETA(DisplayName = "Once Per Activation")
+};
+
 // Trigger types for spell nodes
 UENUM(BlueprintType)
 enum class EGWTTriggerType : uint8
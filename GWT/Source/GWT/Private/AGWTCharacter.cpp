@@ -5,6 +5,10 @@
 #include "UGWTWand.h"
 #include "UGWTHat.h"
 #include "UGWTRobe.h"
+#include "UGWTSpellScheduler.h"
+#include "UGWTRandomService.h"
+#include "UGWTCharacterSpatialHash.h"
+#include "AGWTRoom.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -50,6 +54,16 @@ void AGWTCharacter::BeginPlay()
 {
     Super::BeginPlay();
 
+    // Actor names follow spawn order, so a replayed match gets the same streams
+    RandomStreamID = UGWTRandomService::GetStreamID(this);
+
+    // Living characters are found through the world's spatial hash rather than actor iteration
+    SpatialHash = UGWTCharacterSpatialHash::Get(this);
+    if (SpatialHash)
+    {
+        SpatialHash->AddCharacter(this);
+    }
+
     // Start mana regeneration timer
     GetWorld()->GetTimerManager().SetTimer(
         ManaRegenTimerHandle,
@@ -62,10 +76,37 @@ void AGWTCharacter::BeginPlay()
     UE_LOG(LogTemp, Verbose, TEXT("Character BeginPlay"));
 }
 
+void AGWTCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (SpatialHash)
+    {
+        SpatialHash->RemoveCharacter(this);
+        SpatialHash = nullptr;
+    }
+
+    if (CurrentRoom)
+    {
+        CurrentRoom->RemoveOccupant(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void AGWTCharacter::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
+    TickCharacterState(DeltaTime);
+}
+
+void AGWTCharacter::TickCharacterState(float DeltaTime)
+{
+    // Only does work when the character crossed into another cell
+    if (SpatialHash)
+    {
+        SpatialHash->UpdateCharacter(this);
+    }
+
     // Process status effects
     ProcessStatusEffects(DeltaTime);
 }
@@ -113,7 +154,9 @@ void AGWTCharacter::TakeDamage(float Damage, EGWTElementType DamageType, AActor*
         // Chance for elemental damage to apply status effect
         float StatusChance = 0.3f; // 30% chance
 
-        if (FMath::FRand() < StatusChance)
+        // Rolled on this character's own stream so the outcome only depends on the seed and its damage history
+        const FGWTRandomKey Key(EGWTRandomDomain::StatusProc, RandomStreamID, DamageEventCount++);
+        if (UGWTRandomService::FRand(this, Key) < StatusChance)
         {
             FGWTStatusEffect NewEffect;
             NewEffect.Duration = 5.0f;
@@ -269,6 +312,20 @@ void AGWTCharacter::RemoveStatusEffect(EGWTStatusEffectType EffectType)
     }
 }
 
+void AGWTCharacter::ClearStatusEffects()
+{
+    TArray<EGWTStatusEffectType, TInlineAllocator<8>> EffectTypes;
+    for (const FGWTStatusEffect& Effect : ActiveEffects)
+    {
+        EffectTypes.AddUnique(Effect.EffectType);
+    }
+
+    for (EGWTStatusEffectType EffectType : EffectTypes)
+    {
+        RemoveStatusEffect(EffectType);
+    }
+}
+
 void AGWTCharacter::ProcessStatusEffects(float DeltaTime)
 {
     // Apply damage over time effects
@@ -278,13 +335,69 @@ void AGWTCharacter::ProcessStatusEffects(float DeltaTime)
     UpdateStatusEffectDurations(DeltaTime);
 }
 
+void AGWTCharacter::Revive()
+{
+    CurrentHealth = MaxHealth;
+    CurrentMana = MaxMana;
+    ClearStatusEffects();
+
+    // Base speed, whatever slowed the character when it died
+    if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
+    {
+        MoveComp->MaxWalkSpeed = MovementSpeed;
+    }
+
+    // Put the ragdoll back on the capsule where the class default has it
+    USkeletalMeshComponent* MeshComp = GetMesh();
+    if (MeshComp && MeshComp->IsSimulatingPhysics())
+    {
+        MeshComp->SetSimulatePhysics(false);
+        MeshComp->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+        MeshComp->SetRelativeTransform(GetClass()->GetDefaultObject<ACharacter>()->GetMesh()->GetRelativeTransform());
+    }
+    GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+
+    // Back in the proximity index
+    if (SpatialHash)
+    {
+        SpatialHash->AddCharacter(this);
+    }
+
+    // Restart mana regeneration
+    GetWorld()->GetTimerManager().SetTimer(
+        ManaRegenTimerHandle,
+        this,
+        &AGWTCharacter::ManaRegenTick,
+        1.0f, // Every 1 second
+        true // Looping
+    );
+}
+
 void AGWTCharacter::OnDeath()
 {
     // Implement death behavior
     UE_LOG(LogTemp, Display, TEXT("%s has died"), *GetName());
 
     // Clear status effects
-    ActiveEffects.Empty();
+    ClearStatusEffects();
+
+    // The dead are no longer targets for proximity queries
+    if (SpatialHash)
+    {
+        SpatialHash->RemoveCharacter(this);
+    }
+
+    // Nor do they occupy their room
+    if (CurrentRoom)
+    {
+        CurrentRoom->RemoveOccupant(this);
+    }
+
+    // Dead characters stop channelling
+    if (UGWTSpellScheduler* SpellScheduler = UGWTSpellScheduler::Get(this))
+    {
+        SpellScheduler->CancelCastsFor(this);
+    }
 
     // Stop timers
     GetWorld()->GetTimerManager().ClearTimer(ManaRegenTimerHandle);
@@ -308,6 +421,10 @@ void AGWTCharacter::EquipWand(UGWTWand* Wand)
         WandMesh->SetStaticMesh(Wand->EquipmentMesh);
     }
 
+    // Wands change spell costs
+    EquippedWand = Wand;
+    MarkManaCostChanged();
+
     UE_LOG(LogTemp, Display, TEXT("%s equipped wand: %s"),
         *GetName(), *Wand->ItemName.ToString());
 }
@@ -338,10 +455,32 @@ void AGWTCharacter::EquipRobe(UGWTRobe* Robe)
     // Set the robe mesh
     // In a real implementation, this would set the skeletal mesh
 
+    // Robes change spell costs
+    EquippedRobe = Robe;
+    MarkManaCostChanged();
+
     UE_LOG(LogTemp, Display, TEXT("%s equipped robe: %s"),
         *GetName(), *Robe->ItemName.ToString());
 }
 
+float AGWTCharacter::GetManaCostMultiplier() const
+{
+    // Wand and robe reductions stack multiplicatively
+    float Multiplier = 1.0f;
+
+    if (EquippedWand)
+    {
+        Multiplier *= EquippedWand->GetManaCostMultiplier();
+    }
+
+    if (EquippedRobe)
+    {
+        Multiplier *= EquippedRobe->GetManaCostMultiplier();
+    }
+
+    return FMath::Max(0.0f, Multiplier);
+}
+
 float AGWTCharacter::GetHealthPercent() const
 {
     return (MaxHealth > 0.0f) ? (CurrentHealth / MaxHealth) : 0.0f;
@@ -8,10 +8,11 @@
 #include "AGWTPlayerController.h"
 #include "AGWTGameMode.h"
 #include "AGWTGameState.h"
-#include "Perception/AIPerceptionComponent.h"
-#include "Perception/AISenseConfig_Sight.h"
-#include "Perception/AISenseConfig_Hearing.h"
-#include "Components/PawnSensingComponent.h"
+#include "UGWTLineOfSightService.h"
+#include "UGWTEnemyAIManager.h"
+#include "UGWTSensingService.h"
+#include "UGWTFlowFieldService.h"
+#include "UGWTCharacterSpatialHash.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -41,30 +42,10 @@ AGWTEnemyCharacter::AGWTEnemyCharacter()
     ManaRegenRate = 3.0f;
     MovementSpeed = 500.0f;
 
-    // Create AI perception component
-    PerceptionComponent = CreateDefaultSubobject<UAIPerceptionComponent>(TEXT("PerceptionComponent"));
-
-    // Set up sight config
-    UAISenseConfig_Sight* SightConfig = CreateDefaultSubobject<UAISenseConfig_Sight>(TEXT("Sight Config"));
-    SightConfig->SightRadius = DetectionRadius;
-    SightConfig->LoseSightRadius = DetectionRadius * 1.5f;
-    SightConfig->PeripheralVisionAngleDegrees = 90.0f;
-    SightConfig->DetectionByAffiliation.bDetectEnemies = true;
-    SightConfig->DetectionByAffiliation.bDetectNeutrals = true;
-    SightConfig->DetectionByAffiliation.bDetectFriendlies = false;
-
-    if (PerceptionComponent)
-    {
-        PerceptionComponent->ConfigureSense(*SightConfig);
-        PerceptionComponent->SetDominantSense(SightConfig->GetSenseImplementation());
-    }
-
-    // Create pawn sensing component for simpler sensing
-    SensingComponent = CreateDefaultSubobject<UPawnSensingComponent>(TEXT("SensingComponent"));
-    SensingComponent->SetPeripheralVisionAngle(90.0f);
-    SensingComponent->SightRadius = DetectionRadius;
-    SensingComponent->HearingThreshold = 500.0f;
-    SensingComponent->LOSHearingThreshold = 1000.0f;
+    // Sight and hearing, the sensing service does the looking and listening
+    PeripheralVisionAngle = 90.0f;
+    HearingThreshold = 500.0f;
+    LOSHearingThreshold = 1000.0f;
 
     // Set movement speed
     UCharacterMovementComponent* MoveComp = GetCharacterMovement();
@@ -88,60 +69,42 @@ void AGWTEnemyCharacter::BeginPlay()
 {
     Super::BeginPlay();
 
-    // Initialize AI behavior
-    InitializeAI();
-
-    // Set up patrol points
-    SetupPatrolPoints();
-
     // Create spells
     InitializeSpells();
 
-    // Register sensory events
-    if (SensingComponent)
+    // Start thinking and sensing
+    ActivateAI();
+
+    UE_LOG(LogTemp, Verbose, TEXT("Enemy Character BeginPlay: %s"), *GetName());
+}
+
+void AGWTEnemyCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UGWTEnemyAIManager* AIManager = UGWTEnemyAIManager::Get(this))
     {
-        SensingComponent->OnSeePawn.AddDynamic(this, &AGWTEnemyCharacter::OnSeePlayer);
-        SensingComponent->OnHearNoise.AddDynamic(this, &AGWTEnemyCharacter::OnHearNoise);
+        AIManager->UnregisterEnemy(this);
     }
 
-    // Set up initial patrol timer
-    GetWorld()->GetTimerManager().SetTimer(
-        PatrolTimerHandle,
-        this,
-        &AGWTEnemyCharacter::PatrolTimerCallback,
-        1.0f, // Start patrolling after 1 second
-        false // Don't loop (will be reset in callback)
-    );
+    if (UGWTSensingService* SensingService = UGWTSensingService::Get(this))
+    {
+        SensingService->UnregisterEnemy(this);
+    }
 
-    UE_LOG(LogTemp, Verbose, TEXT("Enemy Character BeginPlay: %s"), *GetName());
+    Super::EndPlay(EndPlayReason);
 }
 
 void AGWTEnemyCharacter::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
-    // AI behavior logic
+    // Only reached when no AI manager drives this enemy, the manager makes the same decisions
     if (CurrentTarget)
     {
         // Check if target is still in range
         if (!IsTargetInRange(MaxAggroRange))
         {
             // Target is out of aggro range, lose interest
-            UE_LOG(LogTemp, Verbose, TEXT("Enemy %s lost target - out of range"), *GetName());
-            CurrentTarget = nullptr;
-            bIsAttacking = false;
-
-            // Start patrolling again
-            if (!GetWorld()->GetTimerManager().IsTimerActive(PatrolTimerHandle))
-            {
-                GetWorld()->GetTimerManager().SetTimer(
-                    PatrolTimerHandle,
-                    this,
-                    &AGWTEnemyCharacter::PatrolTimerCallback,
-                    1.0f,
-                    false
-                );
-            }
+            LoseTarget();
         }
         else
         {
@@ -149,12 +112,7 @@ void AGWTEnemyCharacter::Tick(float DeltaTime)
             if (IsTargetInRange(AttackRange))
             {
                 // Target is in attack range
-                if (!bIsAttacking)
-                {
-                    // Start attacking
-                    bIsAttacking = true;
-                    AttackTarget();
-                }
+                BeginAttack();
             }
             else
             {
@@ -176,9 +134,8 @@ void AGWTEnemyCharacter::OnDeath()
     // Enemy-specific death handling
     UE_LOG(LogTemp, Display, TEXT("Enemy %s has died"), *GetName());
 
-    // Stop all timers
-    GetWorld()->GetTimerManager().ClearTimer(AttackTimerHandle);
-    GetWorld()->GetTimerManager().ClearTimer(PatrolTimerHandle);
+    // The dead make no more decisions and sense nothing
+    DeactivateAI();
 
     // Grant rewards to player(s)
     DropLoot();
@@ -196,28 +153,137 @@ void AGWTEnemyCharacter::OnDeath()
     }
 
     // Update room if in one
-    TArray<AActor*> OverlappingActors;
-    GetOverlappingActors(OverlappingActors, AGWTRoom::StaticClass());
-
-    for (AActor* Actor : OverlappingActors)
+    // If this was the last enemy, the room marks itself as cleared
+    if (CurrentRoom)
     {
-        AGWTRoom* Room = Cast<AGWTRoom>(Actor);
-        if (Room)
-        {
-            // Decrement enemy count in the room
-            // If this was the last enemy, mark room as cleared
-            Room->OnEnemyKilled(this);
-            break;
-        }
+        CurrentRoom->OnEnemyKilled(this);
     }
 
     // Call base implementation
     Super::OnDeath();
+
+    // Pooled enemies go back once the body has lain for a while, others stay where they fell
+    UGWTActorPool* Pool = UGWTActorPool::Get(this);
+    if (Pool && Pool->IsInUse(this))
+    {
+        GetWorld()->GetTimerManager().SetTimer(
+            PoolReleaseTimerHandle,
+            this,
+            &AGWTEnemyCharacter::ReturnToPool,
+            CorpseDuration,
+            false
+        );
+    }
+}
+
+void AGWTEnemyCharacter::OnAcquiredFromPool()
+{
+    // Back on its feet where the spawner placed it, the spawner sets the difficulty
+    Revive();
+    SetAILOD(EGWTAILOD::Full);
+
+    if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
+    {
+        MoveComp->SetMovementMode(MOVE_Walking);
+    }
+
+    CurrentSpellIndex = 0;
+    CurrentPatrolIndex = 0;
+
+    // Spells survive the pool, everything else starts over
+    ActivateAI();
+
+    UE_LOG(LogTemp, Verbose, TEXT("Enemy %s taken from the pool"), *GetName());
+}
+
+void AGWTEnemyCharacter::OnReleasedToPool()
+{
+    // Living enemies can be released too, so leave everything OnDeath would have left
+    GetWorld()->GetTimerManager().ClearTimer(PoolReleaseTimerHandle);
+    GetWorld()->GetTimerManager().ClearTimer(ManaRegenTimerHandle);
+    DeactivateAI();
+
+    if (SpatialHash)
+    {
+        SpatialHash->RemoveCharacter(this);
+    }
+
+    if (CurrentRoom)
+    {
+        CurrentRoom->RemoveOccupant(this);
+    }
+
+    CurrentTarget = nullptr;
+    bIsAttacking = false;
+
+    // Parked enemies neither animate nor move
+    if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
+    {
+        MoveComp->StopMovementImmediately();
+    }
+    SetAILOD(EGWTAILOD::Dormant);
+
+    UE_LOG(LogTemp, Verbose, TEXT("Enemy %s returned to the pool"), *GetName());
+}
+
+void AGWTEnemyCharacter::ActivateAI()
+{
+    // Initialize AI behavior
+    InitializeAI();
+
+    // Set up patrol points
+    SetupPatrolPoints();
+
+    // Register for sight and hearing
+    if (UGWTSensingService* SensingService = UGWTSensingService::Get(this))
+    {
+        SensingService->RegisterEnemy(this);
+    }
+
+    // The AI manager runs this enemy's decisions together with all the others
+    if (UGWTEnemyAIManager* AIManager = UGWTEnemyAIManager::Get(this))
+    {
+        AIManager->RegisterEnemy(this);
+    }
+
+    // Set up initial patrol timer
+    GetWorld()->GetTimerManager().SetTimer(
+        PatrolTimerHandle,
+        this,
+        &AGWTEnemyCharacter::PatrolTimerCallback,
+        1.0f, // Start patrolling after 1 second
+        false // Don't loop (will be reset in callback)
+    );
+}
+
+void AGWTEnemyCharacter::DeactivateAI()
+{
+    // Stop all timers
+    GetWorld()->GetTimerManager().ClearTimer(AttackTimerHandle);
+    GetWorld()->GetTimerManager().ClearTimer(PatrolTimerHandle);
+
+    if (UGWTEnemyAIManager* AIManager = UGWTEnemyAIManager::Get(this))
+    {
+        AIManager->UnregisterEnemy(this);
+    }
+
+    if (UGWTSensingService* SensingService = UGWTSensingService::Get(this))
+    {
+        SensingService->UnregisterEnemy(this);
+    }
+}
+
+void AGWTEnemyCharacter::ReturnToPool()
+{
+    if (UGWTActorPool* Pool = UGWTActorPool::Get(this))
+    {
+        Pool->Release(this);
+    }
 }
 
 void AGWTEnemyCharacter::DetectPlayer()
 {
-    // This is primarily handled by the pawn sensing component
+    // This is primarily handled by the sensing service
     // But we can manually check for players in detection radius
 
     APawn* NearestPlayer = GetClosestPlayer();
@@ -227,26 +293,88 @@ void AGWTEnemyCharacter::DetectPlayer()
 
         if (Distance <= DetectionRadius)
         {
-            // Check line of sight
-            FHitResult HitResult;
-            bool bHit = GetWorld()->LineTraceSingleByChannel(
-                HitResult,
-                GetActorLocation(),
-                NearestPlayer->GetActorLocation(),
-                ECC_Visibility
-            );
-
-            if (!bHit || HitResult.GetActor() == NearestPlayer)
-            {
-                // Player is visible, set as target
-                CurrentTarget = NearestPlayer;
-                UE_LOG(LogTemp, Verbose, TEXT("Enemy %s detected player %s"),
-                    *GetName(), *NearestPlayer->GetName());
-            }
+            TryDetect(NearestPlayer);
         }
     }
 }
 
+void AGWTEnemyCharacter::TryDetect(APawn* Player)
+{
+    // Check line of sight, answered from the batched traces of recent frames
+    // A player seen for the first time is only detected once its trace has landed
+    bool bVisible = false;
+    UGWTLineOfSightService* LineOfSight = UGWTLineOfSightService::Get(this);
+    if (Player && LineOfSight && LineOfSight->GetLineOfSight(this, Player, bVisible) && bVisible)
+    {
+        // Player is visible, set as target
+        CurrentTarget = Player;
+        UE_LOG(LogTemp, Verbose, TEXT("Enemy %s detected player %s"),
+            *GetName(), *Player->GetName());
+    }
+}
+
+void AGWTEnemyCharacter::LoseTarget()
+{
+    UE_LOG(LogTemp, Verbose, TEXT("Enemy %s lost target - out of range"), *GetName());
+    CurrentTarget = nullptr;
+    bIsAttacking = false;
+
+    // Start patrolling again
+    if (!GetWorld()->GetTimerManager().IsTimerActive(PatrolTimerHandle))
+    {
+        GetWorld()->GetTimerManager().SetTimer(
+            PatrolTimerHandle,
+            this,
+            &AGWTEnemyCharacter::PatrolTimerCallback,
+            1.0f,
+            false
+        );
+    }
+}
+
+void AGWTEnemyCharacter::BeginAttack()
+{
+    if (!bIsAttacking)
+    {
+        // Start attacking
+        bIsAttacking = true;
+        AttackTarget();
+    }
+}
+
+void AGWTEnemyCharacter::SetAILOD(EGWTAILOD NewLOD)
+{
+    if (AILOD == NewLOD)
+    {
+        return;
+    }
+
+    const FGWTAILODSettings& Settings = UGWTEnemyAIManager::GetLODSettings(NewLOD);
+    const bool bDormant = NewLOD == EGWTAILOD::Dormant;
+    AILOD = NewLOD;
+
+    // Animation
+    if (USkeletalMeshComponent* MeshComp = GetMesh())
+    {
+        MeshComp->SetComponentTickInterval(Settings.AnimationInterval);
+        MeshComp->SetComponentTickEnabled(!bDormant);
+    }
+
+    // Dormant enemies stand still until they are woken
+    if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
+    {
+        MoveComp->SetComponentTickEnabled(!bDormant);
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("Enemy %s AI level of detail: %s"), *GetName(), *UEnum::GetValueAsString(NewLOD));
+}
+
+void AGWTEnemyCharacter::MoveAndFace(const FVector& Direction, const FRotator& Facing)
+{
+    AddMovementInput(Direction);
+    SetActorRotation(Facing);
+}
+
 void AGWTEnemyCharacter::ChaseTarget()
 {
     // Move toward the target
@@ -256,22 +384,23 @@ void AGWTEnemyCharacter::ChaseTarget()
         UCharacterMovementComponent* MoveComp = GetCharacterMovement();
         if (MoveComp)
         {
-            // Calculate direction to target
-            FVector Direction = CurrentTarget->GetActorLocation() - GetActorLocation();
-            Direction.Normalize();
-
-            // Move in that direction
-            AddMovementInput(Direction);
+            // Follow the shared flow field toward the target, straight at it when there is none
+            FVector Direction;
+            const UGWTFlowFieldService* FlowFields = UGWTFlowFieldService::Get(this);
+            const FGWTFlowField* Field = FlowFields ? FlowFields->FindField(CurrentTarget) : nullptr;
+            if (!Field || !Field->GetDirection(GetActorLocation(), Direction))
+            {
+                Direction = CurrentTarget->GetActorLocation() - GetActorLocation();
+                Direction.Normalize();
+            }
 
-            // Set view rotation to face target
-            FRotator NewRotation = UKismetMathLibrary::FindLookAtRotation(
-                GetActorLocation(),
-                CurrentTarget->GetActorLocation()
-            );
+            // Face the way we are going
+            FRotator NewRotation = Direction.Rotation();
             NewRotation.Pitch = 0.0f; // Keep level
             NewRotation.Roll = 0.0f;  // No roll
 
-            SetActorRotation(NewRotation);
+            // Move in that direction
+            MoveAndFace(Direction, NewRotation);
 
             UE_LOG(LogTemp, Verbose, TEXT("Enemy %s chasing target %s"),
                 *GetName(), *CurrentTarget->GetName());
@@ -390,23 +519,17 @@ void AGWTEnemyCharacter::DropLoot()
         *GetName(), GoldValue);
 
     // Determine players who should receive loot
-    TArray<AActor*> NearbyPlayers;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AGWTPlayerCharacter::StaticClass(), NearbyPlayers);
+    TArray<AGWTPlayerCharacter*> NearbyPlayers;
+    GetPlayersInRange(1000.0f, NearbyPlayers); // Loot range
 
-    for (AActor* Player : NearbyPlayers)
+    for (AGWTPlayerCharacter* PlayerChar : NearbyPlayers)
     {
-        // Check if player is in loot range
-        float Distance = FVector::Dist(GetActorLocation(), Player->GetActorLocation());
-        if (Distance <= 1000.0f) // Loot range
+        // Grant gold to player
+        if (PlayerChar && PlayerChar->Inventory)
         {
-            // Grant gold to player
-            AGWTPlayerCharacter* PlayerChar = Cast<AGWTPlayerCharacter>(Player);
-            if (PlayerChar && PlayerChar->Inventory)
-            {
-                PlayerChar->Inventory->AddGold(GoldValue);
-                UE_LOG(LogTemp, Display, TEXT("Granted %d gold to player %s"),
-                    GoldValue, *PlayerChar->GetName());
-            }
+            PlayerChar->Inventory->AddGold(GoldValue);
+            UE_LOG(LogTemp, Display, TEXT("Granted %d gold to player %s"),
+                GoldValue, *PlayerChar->GetName());
         }
     }
 }
@@ -420,23 +543,17 @@ void AGWTEnemyCharacter::GrantExperience()
         *GetName(), ExperienceValue);
 
     // Determine players who should receive XP
-    TArray<AActor*> NearbyPlayers;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AGWTPlayerCharacter::StaticClass(), NearbyPlayers);
+    TArray<AGWTPlayerCharacter*> NearbyPlayers;
+    GetPlayersInRange(1500.0f, NearbyPlayers); // XP range
 
-    for (AActor* Player : NearbyPlayers)
+    for (AGWTPlayerCharacter* PlayerChar : NearbyPlayers)
     {
-        // Check if player is in XP range
-        float Distance = FVector::Dist(GetActorLocation(), Player->GetActorLocation());
-        if (Distance <= 1500.0f) // XP range
+        // Grant XP to player
+        if (PlayerChar && PlayerChar->Progression)
         {
-            // Grant XP to player
-            AGWTPlayerCharacter* PlayerChar = Cast<AGWTPlayerCharacter>(Player);
-            if (PlayerChar && PlayerChar->Progression)
-            {
-                PlayerChar->Progression->AddXP(ExperienceValue);
-                UE_LOG(LogTemp, Display, TEXT("Granted %d XP to player %s"),
-                    ExperienceValue, *PlayerChar->GetName());
-            }
+            PlayerChar->Progression->AddXP(ExperienceValue);
+            UE_LOG(LogTemp, Display, TEXT("Granted %d XP to player %s"),
+                ExperienceValue, *PlayerChar->GetName());
         }
     }
 }
@@ -500,25 +617,19 @@ bool AGWTEnemyCharacter::IsTargetInRange(float Range) const
 
 APawn* AGWTEnemyCharacter::GetClosestPlayer() const
 {
-    // Find all players
-    TArray<AActor*> Players;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AGWTPlayerCharacter::StaticClass(), Players);
+    // Players beyond aggro range are never targeted, so the search stops there
+    AGWTGameState* GWTGameState = GetWorld()->GetGameState<AGWTGameState>();
+    return GWTGameState ? GWTGameState->FindClosestPlayer(GetActorLocation(), MaxAggroRange) : nullptr;
+}
 
-    // Find closest player
-    APawn* ClosestPlayer = nullptr;
-    float ClosestDistance = MAX_FLT;
+void AGWTEnemyCharacter::GetPlayersInRange(float Range, TArray<AGWTPlayerCharacter*>& OutPlayers) const
+{
+    OutPlayers.Reset();
 
-    for (AActor* Player : Players)
+    if (AGWTGameState* GWTGameState = GetWorld()->GetGameState<AGWTGameState>())
     {
-        float Distance = FVector::Dist(GetActorLocation(), Player->GetActorLocation());
-        if (Distance < ClosestDistance)
-        {
-            ClosestPlayer = Cast<APawn>(Player);
-            ClosestDistance = Distance;
-        }
+        GWTGameState->GetPlayersInRange(GetActorLocation(), Range, OutPlayers);
     }
-
-    return ClosestPlayer;
 }
 
 void AGWTEnemyCharacter::InitializeAI()
@@ -2,6 +2,7 @@
 // Implementation of the game state
 
 #include "AGWTGameState.h"
+#include "AGWTPlayerCharacter.h"
 #include "Net/UnrealNetwork.h"
 
 AGWTGameState::AGWTGameState()
@@ -75,4 +76,81 @@ void AGWTGameState::EnemySpawned()
 
     // Log enemy spawned
     UE_LOG(LogTemp, Verbose, TEXT("Enemy spawned. Total enemies: %d"), RemainingEnemies);
+}
+
+void AGWTGameState::RegisterPlayer(AGWTPlayerCharacter* Player)
+{
+    if (!Player || LivePlayers.Contains(Player))
+    {
+        return;
+    }
+
+    LivePlayers.Add(Player);
+    LocationsFrame = MAX_uint64;
+
+    UE_LOG(LogTemp, Verbose, TEXT("Player %s registered. Live players: %d"), *Player->GetName(), LivePlayers.Num());
+}
+
+void AGWTGameState::UnregisterPlayer(AGWTPlayerCharacter* Player)
+{
+    // Keep the order stable for everyone iterating the registry
+    if (LivePlayers.RemoveSingle(Player) > 0)
+    {
+        LocationsFrame = MAX_uint64;
+
+        UE_LOG(LogTemp, Verbose, TEXT("Player %s unregistered. Live players: %d"), *Player->GetName(), LivePlayers.Num());
+    }
+}
+
+const TArray<FVector>& AGWTGameState::GetLivePlayerLocations()
+{
+    // Every enemy asks each frame, only the first one pays for the reads
+    if (LocationsFrame != GFrameCounter)
+    {
+        LivePlayerLocations.Reset(LivePlayers.Num());
+        for (const AGWTPlayerCharacter* Player : LivePlayers)
+        {
+            LivePlayerLocations.Add(Player->GetActorLocation());
+        }
+
+        LocationsFrame = GFrameCounter;
+    }
+
+    return LivePlayerLocations;
+}
+
+AGWTPlayerCharacter* AGWTGameState::FindClosestPlayer(const FVector& Location, float MaxRange)
+{
+    const TArray<FVector>& Locations = GetLivePlayerLocations();
+
+    AGWTPlayerCharacter* ClosestPlayer = nullptr;
+    float ClosestDistanceSquared = FMath::Square(MaxRange);
+
+    for (int32 i = 0; i < Locations.Num(); i++)
+    {
+        const float DistanceSquared = FVector::DistSquared(Location, Locations[i]);
+        if (DistanceSquared <= ClosestDistanceSquared)
+        {
+            ClosestDistanceSquared = DistanceSquared;
+            ClosestPlayer = LivePlayers[i];
+        }
+    }
+
+    return ClosestPlayer;
+}
+
+void AGWTGameState::GetPlayersInRange(const FVector& Location, float Range, TArray<AGWTPlayerCharacter*>& OutPlayers)
+{
+    OutPlayers.Reset();
+
+    const TArray<FVector>& Locations = GetLivePlayerLocations();
+    const float RangeSquared = FMath::Square(Range);
+
+    for (int32 i = 0; i < Locations.Num(); i++)
+    {
+        if (FVector::DistSquared(Location, Locations[i]) <= RangeSquared)
+        {
+            OutPlayers.Add(LivePlayers[i]);
+        }
+    }
 }
\ No newline at end of file
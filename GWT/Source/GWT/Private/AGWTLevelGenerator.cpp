@@ -540,6 +540,70 @@ AGWTRoom* AGWTLevelGenerator::GetRoom(int32 X, int32 Y, int32 Z) const
     return RoomGrid[X][Y][Z];
 }
 
+FIntVector AGWTLevelGenerator::WorldToGridPosition(const FVector& WorldPosition) const
+{
+    // Rooms are spawned centred on multiples of RoomSize
+    return FIntVector(
+        FMath::RoundToInt(WorldPosition.X / RoomSize),
+        FMath::RoundToInt(WorldPosition.Y / RoomSize),
+        FMath::RoundToInt(WorldPosition.Z / RoomSize));
+}
+
+AGWTRoom* AGWTLevelGenerator::GetRoomAtLocation(const FVector& WorldPosition) const
+{
+    const FIntVector GridPos = WorldToGridPosition(WorldPosition);
+    return GetRoom(GridPos.X, GridPos.Y, GridPos.Z);
+}
+
+void AGWTLevelGenerator::GetRoomDistances(const TArray<const AGWTRoom*>& SourceRooms, int32 MaxDistance,
+    TMap<const AGWTRoom*, int32>& OutDistances) const
+{
+    OutDistances.Reset();
+
+    // Breadth-first through open doors, every room is reached first along its shortest route
+    TArray<const AGWTRoom*> Frontier;
+    for (const AGWTRoom* Room : SourceRooms)
+    {
+        if (Room && !OutDistances.Contains(Room))
+        {
+            OutDistances.Add(Room, 0);
+            Frontier.Add(Room);
+        }
+    }
+
+    TArray<const AGWTRoom*> NextFrontier;
+    for (int32 Distance = 1; Distance <= MaxDistance && Frontier.Num() > 0; Distance++)
+    {
+        NextFrontier.Reset();
+        for (const AGWTRoom* Room : Frontier)
+        {
+            for (const TPair<EGWTDirection, bool>& Door : Room->DoorStates)
+            {
+                const AGWTRoom* Neighbour = Door.Value ? GetRoomThroughDoor(Room, Door.Key) : nullptr;
+                if (Neighbour && !OutDistances.Contains(Neighbour))
+                {
+                    OutDistances.Add(Neighbour, Distance);
+                    NextFrontier.Add(Neighbour);
+                }
+            }
+        }
+        Swap(Frontier, NextFrontier);
+    }
+}
+
+AGWTRoom* AGWTLevelGenerator::GetRoomThroughDoor(const AGWTRoom* Room, EGWTDirection Direction) const
+{
+    if (!Room || !Room->HasDoor(Direction))
+    {
+        return nullptr;
+    }
+
+    const FVector Step = Room->GetDirectionVector(Direction);
+    const FIntVector Neighbour = Room->GridPosition +
+        FIntVector(FMath::RoundToInt(Step.X), FMath::RoundToInt(Step.Y), FMath::RoundToInt(Step.Z));
+    return GetRoom(Neighbour.X, Neighbour.Y, Neighbour.Z);
+}
+
 FIntVector AGWTLevelGenerator::GetSpawnRoomPosition() const
 {
     // Spawn room is at the center of the grid
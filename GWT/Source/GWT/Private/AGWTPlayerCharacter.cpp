@@ -8,6 +8,8 @@
 #include "UGWTSpell.h"
 #include "UGWTItem.h"
 #include "UGWTEquipment.h"
+#include "AGWTGameState.h"
+#include "UGWTSensingService.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -125,6 +127,12 @@ void AGWTPlayerCharacter::OnDeath()
     // Player-specific death behavior
     UE_LOG(LogTemp, Display, TEXT("Player character has died"));
 
+    // Enemies stop looking for this player
+    if (AGWTGameState* GWTGameState = GetWorld()->GetGameState<AGWTGameState>())
+    {
+        GWTGameState->UnregisterPlayer(this);
+    }
+
     // Call base implementation
     Super::OnDeath();
 
@@ -132,6 +140,29 @@ void AGWTPlayerCharacter::OnDeath()
     // In a full game, we would trigger a game over screen or respawn sequence
 }
 
+void AGWTPlayerCharacter::PossessedBy(AController* NewController)
+{
+    Super::PossessedBy(NewController);
+
+    // Only living, controlled players are visible to enemy AI
+    AGWTGameState* GWTGameState = GetWorld()->GetGameState<AGWTGameState>();
+    if (GWTGameState && CurrentHealth > 0.0f)
+    {
+        GWTGameState->RegisterPlayer(this);
+    }
+}
+
+void AGWTPlayerCharacter::UnPossessed()
+{
+    // Also runs when the pawn is destroyed while possessed
+    if (AGWTGameState* GWTGameState = GetWorld()->GetGameState<AGWTGameState>())
+    {
+        GWTGameState->UnregisterPlayer(this);
+    }
+
+    Super::UnPossessed();
+}
+
 void AGWTPlayerCharacter::MoveForward(float Value)
 {
     if ((Controller != NULL) && (Value != 0.0f))
@@ -206,6 +237,12 @@ void AGWTPlayerCharacter::EndSpellCast()
         // Cast the spell
         CastSpell();
 
+        // Spellcasting is loud, nearby enemies hear it
+        if (UGWTSensingService* SensingService = UGWTSensingService::Get(this))
+        {
+            SensingService->ReportNoise(this, GetActorLocation(), 1.0f);
+        }
+
         // Visual feedback
         OnEndCasting();
 
@@ -344,6 +381,8 @@ void AGWTPlayerCharacter::UnequipItem(EGWTEquipmentSlot Slot)
     case EGWTEquipmentSlot::Wand:
         // Clear wand mesh and effects
         WandMesh->SetStaticMesh(nullptr);
+        EquippedWand = nullptr;
+        MarkManaCostChanged();
         break;
 
     case EGWTEquipmentSlot::Hat:
@@ -353,6 +392,8 @@ void AGWTPlayerCharacter::UnequipItem(EGWTEquipmentSlot Slot)
 
     case EGWTEquipmentSlot::Robe:
         // Clear robe mesh and effects
+        EquippedRobe = nullptr;
+        MarkManaCostChanged();
         break;
 
     default:
@@ -363,6 +404,20 @@ void AGWTPlayerCharacter::UnequipItem(EGWTEquipmentSlot Slot)
     UE_LOG(LogTemp, Display, TEXT("Unequipped item from slot: %d"), (int32)Slot);
 }
 
+float AGWTPlayerCharacter::GetManaCostMultiplier() const
+{
+    float Multiplier = Super::GetManaCostMultiplier();
+
+    // Each Mana Efficiency level reduces spell costs by 10%
+    if (Progression)
+    {
+        const int32 SkillLevel = Progression->GetSkillLevel(EGWTSkillTreeCategory::ManaEfficiency);
+        Multiplier *= FMath::Max(0.0f, 1.0f - SkillLevel * 0.1f);
+    }
+
+    return Multiplier;
+}
+
 void AGWTPlayerCharacter::ToggleInventory()
 {
     // This would be implemented to show/hide the inventory UI
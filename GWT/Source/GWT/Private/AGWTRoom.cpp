@@ -4,12 +4,16 @@
 #include "GWTRoom.h"
 #include "GWTCharacter.h"
 #include "GWTEnemyCharacter.h"
+#include "AGWTPlayerCharacter.h"
+#include "UGWTSpawnQueue.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/BoxComponent.h"
 #include "Components/SceneComponent.h"
 #include "Components/ChildActorComponent.h"
 #include "Kismet/GameplayStatics.h"
 
+const FName AGWTRoom::ItemTag(TEXT("GWTItem"));
+
 AGWTRoom::AGWTRoom()
 {
     // Set this actor to call Tick() every frame
@@ -63,12 +67,40 @@ void AGWTRoom::BeginPlay()
     {
         TriggerBox->OnComponentBeginOverlap.AddDynamic(this, &AGWTRoom::OnRoomBeginOverlap);
         TriggerBox->OnComponentEndOverlap.AddDynamic(this, &AGWTRoom::OnRoomEndOverlap);
+
+        SeedOccupants(TriggerBox);
     }
 
     UE_LOG(LogTemp, Verbose, TEXT("Room initialized at grid position (%d, %d, %d)"),
         GridPosition.X, GridPosition.Y, GridPosition.Z);
 }
 
+void AGWTRoom::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // Characters must not keep pointing at a room that is going away
+    for (AGWTCharacter* Player : PlayerOccupants)
+    {
+        if (Player && Player->CurrentRoom == this)
+        {
+            Player->CurrentRoom = nullptr;
+        }
+    }
+
+    for (AGWTEnemyCharacter* Enemy : EnemyOccupants)
+    {
+        if (Enemy && Enemy->CurrentRoom == this)
+        {
+            Enemy->CurrentRoom = nullptr;
+        }
+    }
+
+    PlayerOccupants.Empty();
+    EnemyOccupants.Empty();
+    ItemOccupants.Empty();
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void AGWTRoom::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
@@ -136,16 +168,13 @@ void AGWTRoom::SpawnEnemies(int32 WaveNumber)
         EnemyCount = FMath::Min(MaxEnemies / 2, 1 + WaveNumber / 4);
     }
 
-    UE_LOG(LogTemp, Display, TEXT("Spawning %d enemies in room (%d, %d, %d)"),
+    UE_LOG(LogTemp, Display, TEXT("Queueing %d enemies in room (%d, %d, %d)"),
         EnemyCount, GridPosition.X, GridPosition.Y, GridPosition.Z);
 
-    // In a real implementation, this would use an enemy spawner to create appropriate enemies
-    // For this example, we'll just log that enemies would be spawned
-
-    for (int32 i = 0; i < EnemyCount; i++)
+    // The spawn queue spreads the spawns over frames, nearest rooms to the players first
+    if (UGWTSpawnQueue* SpawnQueue = UGWTSpawnQueue::Get(this))
     {
-        UE_LOG(LogTemp, Verbose, TEXT("Would spawn enemy %d of %d at %s"),
-            i + 1, EnemyCount, *EnemySpawnPoint->GetComponentLocation().ToString());
+        SpawnQueue->EnqueueRoom(this, WaveNumber, EnemyCount);
     }
 }
 
@@ -242,6 +271,25 @@ void AGWTRoom::OnPlayerExited(AGWTCharacter* Player)
     UpdateRoomAppearance();
 }
 
+void AGWTRoom::OnEnemyKilled(AGWTEnemyCharacter* Enemy)
+{
+    RemoveOccupant(Enemy);
+
+    // Only combat and boss rooms are cleared by fighting
+    if (bIsCleared || (RoomType != EGWTRoomType::Combat && RoomType != EGWTRoomType::Boss))
+    {
+        return;
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("Enemy killed in room (%d, %d, %d), %d remaining"),
+        GridPosition.X, GridPosition.Y, GridPosition.Z, EnemyOccupants.Num());
+
+    if (EnemyOccupants.Num() == 0)
+    {
+        MarkAsCleared();
+    }
+}
+
 void AGWTRoom::MarkAsCleared()
 {
     // Mark room as cleared
@@ -264,6 +312,65 @@ void AGWTRoom::MarkAsCleared()
     UpdateRoomAppearance();
 }
 
+bool AGWTRoom::AddOccupant(AActor* Actor)
+{
+    bool bAlreadyInSet = false;
+
+    if (AGWTPlayerCharacter* Player = Cast<AGWTPlayerCharacter>(Actor))
+    {
+        PlayerOccupants.Add(Player, &bAlreadyInSet);
+    }
+    else if (AGWTEnemyCharacter* Enemy = Cast<AGWTEnemyCharacter>(Actor))
+    {
+        // Corpses do not keep a room from being cleared
+        if (Enemy->CurrentHealth <= 0.0f)
+        {
+            return false;
+        }
+
+        EnemyOccupants.Add(Enemy, &bAlreadyInSet);
+    }
+    else if (Actor && Actor->ActorHasTag(ItemTag))
+    {
+        ItemOccupants.Add(Actor, &bAlreadyInSet);
+    }
+    else
+    {
+        return false;
+    }
+
+    // Characters remember their room so nobody has to search for it
+    if (AGWTCharacter* Character = Cast<AGWTCharacter>(Actor))
+    {
+        Character->CurrentRoom = this;
+    }
+
+    return !bAlreadyInSet;
+}
+
+bool AGWTRoom::RemoveOccupant(AActor* Actor)
+{
+    int32 NumRemoved = ItemOccupants.Remove(Actor);
+
+    AGWTCharacter* Character = Cast<AGWTCharacter>(Actor);
+    if (AGWTEnemyCharacter* Enemy = Cast<AGWTEnemyCharacter>(Character))
+    {
+        NumRemoved += EnemyOccupants.Remove(Enemy);
+    }
+    else if (Character)
+    {
+        NumRemoved += PlayerOccupants.Remove(Character);
+    }
+
+    // The character may already have entered the next room's trigger
+    if (Character && Character->CurrentRoom == this)
+    {
+        Character->CurrentRoom = nullptr;
+    }
+
+    return NumRemoved > 0;
+}
+
 int32 AGWTRoom::GetDoorIndex(EGWTDirection Direction) const
 {
     // Convert direction to index
@@ -456,12 +563,31 @@ void AGWTRoom::InitializeRoomState()
     }
 }
 
+void AGWTRoom::SeedOccupants(UBoxComponent* TriggerBox)
+{
+    // One query at startup, from here on the overlap events keep the sets current
+    // Entry events are not raised, nobody walked in
+    TArray<AActor*> OverlappingActors;
+    TriggerBox->GetOverlappingActors(OverlappingActors);
+
+    for (AActor* Actor : OverlappingActors)
+    {
+        AddOccupant(Actor);
+    }
+}
+
 void AGWTRoom::OnRoomBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
     UPrimitiveComponent* OtherComp, int32 OtherBodyIndex,
     bool bFromSweep, const FHitResult& SweepResult)
 {
+    // Several components of one actor can overlap, only the first one enters
+    if (!AddOccupant(OtherActor))
+    {
+        return;
+    }
+
     // Check if the overlapping actor is a player
-    AGWTCharacter* Player = Cast<AGWTCharacter>(OtherActor);
+    AGWTPlayerCharacter* Player = Cast<AGWTPlayerCharacter>(OtherActor);
     if (Player)
     {
         OnPlayerEntered(Player);
@@ -471,8 +597,19 @@ void AGWTRoom::OnRoomBeginOverlap(UPrimitiveComponent* OverlappedComponent, AAct
 void AGWTRoom::OnRoomEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
     UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
 {
+    // The actor is still inside while any of its components overlap
+    if (OverlappedComponent && OverlappedComponent->IsOverlappingActor(OtherActor))
+    {
+        return;
+    }
+
+    if (!RemoveOccupant(OtherActor))
+    {
+        return;
+    }
+
     // Check if the overlapping actor is a player
-    AGWTCharacter* Player = Cast<AGWTCharacter>(OtherActor);
+    AGWTPlayerCharacter* Player = Cast<AGWTPlayerCharacter>(OtherActor);
     if (Player)
     {
         OnPlayerExited(Player);
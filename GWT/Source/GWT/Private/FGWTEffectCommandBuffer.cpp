@@ -0,0 +1,347 @@
+// FGWTEffectCommandBuffer.cpp
+// Implementation of the deferred effect command buffer
+
+#include "FGWTEffectCommandBuffer.h"
+#include "AGWTCharacter.h"
+#include "Components/PrimitiveComponent.h"
+#include "Algo/StableSort.h"
+
+void FGWTEffectCommandBuffer::AddDamage(AActor* Target, float Damage, EGWTElementType Element, AActor* Causer)
+{
+    FGWTEffectCommand& Command = AddCommand(EGWTEffectCommandType::Damage, Target);
+    Command.Element = Element;
+    Command.Causer = Causer;
+    Command.Value = Damage;
+}
+
+void FGWTEffectCommandBuffer::AddHeal(AActor* Target, float Amount)
+{
+    FGWTEffectCommand& Command = AddCommand(EGWTEffectCommandType::Heal, Target);
+    Command.Value = Amount;
+}
+
+void FGWTEffectCommandBuffer::AddStatus(AActor* Target, EGWTStatusEffectType StatusType, float Strength, float Duration, AActor* Causer)
+{
+    FGWTEffectCommand& Command = AddCommand(EGWTEffectCommandType::Status, Target);
+    Command.StatusType = StatusType;
+    Command.Causer = Causer;
+    Command.Value = Strength;
+    Command.Duration = Duration;
+}
+
+void FGWTEffectCommandBuffer::AddKnockback(AActor* Target, float Strength, AActor* Causer)
+{
+    FGWTEffectCommand& Command = AddCommand(EGWTEffectCommandType::Knockback, Target);
+    Command.Causer = Causer;
+    Command.Value = Strength;
+}
+
+void FGWTEffectCommandBuffer::AddTeleport(AActor* Target, const FVector& Location)
+{
+    FGWTEffectCommand& Command = AddCommand(EGWTEffectCommandType::Teleport, Target);
+    Command.Location = Location;
+}
+
+void FGWTEffectCommandBuffer::AddSummon(const FVector& Location, AActor* Causer)
+{
+    FGWTEffectCommand& Command = AddCommand(EGWTEffectCommandType::Summon, nullptr);
+    Command.Causer = Causer;
+    Command.Location = Location;
+}
+
+FGWTEffectCommand& FGWTEffectCommandBuffer::AddCommand(EGWTEffectCommandType Type, AActor* Target)
+{
+    FGWTEffectCommand& Command = Commands.AddDefaulted_GetRef();
+    Command.Type = Type;
+    Command.Target = Target;
+    return Command;
+}
+
+void FGWTEffectCommandBuffer::Flush()
+{
+    if (Commands.Num() == 0)
+    {
+        return;
+    }
+
+    // Swap rather than move so both arrays keep their allocations between batches
+    Applying.Reset();
+    Swap(Applying, Commands);
+
+    // Targets are visited in the order they were first hit, which keeps the outcome deterministic
+    TargetOrders.Reset();
+    for (FGWTEffectCommand& Command : Applying)
+    {
+        const AActor* Target = Command.Target.Get();
+        const int32* ExistingOrder = TargetOrders.Find(Target);
+        Command.TargetOrder = ExistingOrder ? *ExistingOrder : TargetOrders.Add(Target, TargetOrders.Num());
+    }
+
+    // Group per target, stable so each target still receives its commands in issue order
+    Algo::StableSort(Applying, [](const FGWTEffectCommand& A, const FGWTEffectCommand& B)
+    {
+        return A.TargetOrder < B.TargetOrder;
+    });
+
+    int32 NumUpdates = 0;
+    for (int32 First = 0; First < Applying.Num();)
+    {
+        int32 End = First + 1;
+        while (End < Applying.Num() && Applying[End].TargetOrder == Applying[First].TargetOrder)
+        {
+            End++;
+        }
+
+        const TArrayView<const FGWTEffectCommand> TargetCommands(&Applying[First], End - First);
+        const bool bPerHitDamage = HasPerHitDamage(Applying[First].Target.Get(), TargetCommands);
+
+        // Fold each command into the newest matching update, unless something issued since does not commute with it
+        Updates.Reset();
+        for (const FGWTEffectCommand& Command : TargetCommands)
+        {
+            int32 MergeInto = INDEX_NONE;
+            if (!bPerHitDamage || Command.Type != EGWTEffectCommandType::Damage)
+            {
+                for (int32 UpdateIndex = Updates.Num() - 1; UpdateIndex >= 0; UpdateIndex--)
+                {
+                    if (CanMerge(Updates[UpdateIndex], Command))
+                    {
+                        MergeInto = UpdateIndex;
+                        break;
+                    }
+                    if (!Commutes(Updates[UpdateIndex], Command))
+                    {
+                        break;
+                    }
+                }
+            }
+
+            if (MergeInto != INDEX_NONE)
+            {
+                Merge(Updates[MergeInto], Command);
+            }
+            else
+            {
+                Updates.Add(Command);
+            }
+        }
+
+        for (const FGWTEffectCommand& Update : Updates)
+        {
+            ApplyCommand(Update);
+        }
+
+        NumUpdates += Updates.Num();
+        First = End;
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("Effect commands: applied %d as %d updates across %d targets"),
+        Applying.Num(), NumUpdates, TargetOrders.Num());
+
+    Applying.Reset();
+}
+
+void FGWTEffectCommandBuffer::Reset()
+{
+    Commands.Reset();
+}
+
+bool FGWTEffectCommandBuffer::CanMerge(const FGWTEffectCommand& Into, const FGWTEffectCommand& From)
+{
+    if (Into.Type != From.Type || Into.Target != From.Target)
+    {
+        return false;
+    }
+
+    switch (Into.Type)
+    {
+    case EGWTEffectCommandType::Damage:
+        // Damage is credited to its causer, and resistances depend on the element
+        return Into.Element == From.Element && Into.Causer == From.Causer;
+
+    case EGWTEffectCommandType::Status:
+        return Into.StatusType == From.StatusType;
+
+    case EGWTEffectCommandType::Knockback:
+        return Into.Causer == From.Causer;
+
+    case EGWTEffectCommandType::Heal:
+    case EGWTEffectCommandType::Teleport:
+        return true;
+
+    default:
+        // Every summon is its own minion
+        return false;
+    }
+}
+
+bool FGWTEffectCommandBuffer::Commutes(const FGWTEffectCommand& A, const FGWTEffectCommand& B)
+{
+    const bool bStatusA = A.Type == EGWTEffectCommandType::Status;
+    const bool bStatusB = B.Type == EGWTEffectCommandType::Status;
+
+    // Different status effects are tracked separately
+    if (bStatusA && bStatusB)
+    {
+        return A.StatusType != B.StatusType;
+    }
+
+    // Damage only looks at the shield, and a shielded target's damage is never merged
+    if ((bStatusA && B.Type == EGWTEffectCommandType::Damage) || (bStatusB && A.Type == EGWTEffectCommandType::Damage))
+    {
+        return (bStatusA ? A.StatusType : B.StatusType) != EGWTStatusEffectType::Shielded;
+    }
+
+    // Damage from one causer adds up the same in any order, whoever lands the killing blow is unchanged
+    if (A.Type == EGWTEffectCommandType::Damage && B.Type == EGWTEffectCommandType::Damage)
+    {
+        return A.Causer == B.Causer;
+    }
+
+    // Healing against damage clamps differently, and movement depends on where the target stands
+    return false;
+}
+
+bool FGWTEffectCommandBuffer::HasPerHitDamage(const AActor* Target, TArrayView<const FGWTEffectCommand> TargetCommands)
+{
+    const AGWTCharacter* TargetCharacter = Cast<AGWTCharacter>(Target);
+    if (TargetCharacter && TargetCharacter->HasStatusEffect(EGWTStatusEffectType::Shielded))
+    {
+        return true;
+    }
+
+    for (const FGWTEffectCommand& Command : TargetCommands)
+    {
+        if (Command.Type == EGWTEffectCommandType::Status && Command.StatusType == EGWTStatusEffectType::Shielded)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void FGWTEffectCommandBuffer::Merge(FGWTEffectCommand& Into, const FGWTEffectCommand& From)
+{
+    switch (Into.Type)
+    {
+    case EGWTEffectCommandType::Status:
+        // Same rule as refreshing an active effect, the stronger and longer one wins
+        Into.Value = FMath::Max(Into.Value, From.Value);
+        Into.Duration = FMath::Max(Into.Duration, From.Duration);
+        break;
+
+    case EGWTEffectCommandType::Teleport:
+        // Only the last destination matters
+        Into.Location = From.Location;
+        break;
+
+    default:
+        // Damage, healing and knockback add up
+        Into.Value += From.Value;
+        break;
+    }
+}
+
+void FGWTEffectCommandBuffer::ApplyCommand(const FGWTEffectCommand& Command)
+{
+    if (Command.Type == EGWTEffectCommandType::Summon)
+    {
+        ApplySummon(Command.Location);
+        return;
+    }
+
+    AActor* Target = Command.Target.Get();
+    if (!Target)
+    {
+        return;
+    }
+
+    // A target killed earlier in the batch takes nothing more, so death is handled once
+    AGWTCharacter* TargetCharacter = Cast<AGWTCharacter>(Target);
+    if (TargetCharacter && TargetCharacter->CurrentHealth <= 0.0f)
+    {
+        return;
+    }
+
+    switch (Command.Type)
+    {
+    case EGWTEffectCommandType::Damage:
+        if (TargetCharacter)
+        {
+            TargetCharacter->TakeDamage(Command.Value, Command.Element, Command.Causer.Get());
+        }
+        break;
+
+    case EGWTEffectCommandType::Heal:
+        if (TargetCharacter)
+        {
+            TargetCharacter->Heal(Command.Value);
+        }
+        break;
+
+    case EGWTEffectCommandType::Status:
+        if (TargetCharacter)
+        {
+            FGWTStatusEffect StatusEffect;
+            StatusEffect.EffectType = Command.StatusType;
+            StatusEffect.Duration = Command.Duration;
+            StatusEffect.Strength = Command.Value;
+            StatusEffect.Causer = Command.Causer.Get();
+            StatusEffect.TimeRemaining = Command.Duration;
+
+            TargetCharacter->ApplyStatusEffect(StatusEffect);
+        }
+        break;
+
+    case EGWTEffectCommandType::Knockback:
+        ApplyKnockback(Target, Command.Causer.Get(), Command.Value);
+        break;
+
+    case EGWTEffectCommandType::Teleport:
+        Target->SetActorLocation(Command.Location, false, nullptr, ETeleportType::TeleportPhysics);
+
+        UE_LOG(LogTemp, Verbose, TEXT("Applied teleport effect to %s: New location (%f, %f, %f)"),
+            *Target->GetName(), Command.Location.X, Command.Location.Y, Command.Location.Z);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void FGWTEffectCommandBuffer::ApplyKnockback(AActor* Target, AActor* Causer, float Strength)
+{
+    if (!Causer)
+    {
+        return;
+    }
+
+    // Push away from the caster, scaled up for an appropriate force
+    FVector Direction = Target->GetActorLocation() - Causer->GetActorLocation();
+    Direction.Normalize();
+    const FVector KnockbackForce = Direction * Strength * 1000.0f;
+
+    UPrimitiveComponent* TargetPrimitive = Cast<UPrimitiveComponent>(Target->GetRootComponent());
+    if (TargetPrimitive && TargetPrimitive->IsSimulatingPhysics())
+    {
+        TargetPrimitive->AddImpulse(KnockbackForce, NAME_None, true);
+
+        UE_LOG(LogTemp, Verbose, TEXT("Applied physics knockback to %s with force (%f, %f, %f)"),
+            *Target->GetName(), KnockbackForce.X, KnockbackForce.Y, KnockbackForce.Z);
+    }
+    else
+    {
+        // For non-physics actors, we can manually move them
+        // This would typically be implemented with character movement component
+        UE_LOG(LogTemp, Verbose, TEXT("Applied movement knockback to %s with force (%f, %f, %f)"),
+            *Target->GetName(), KnockbackForce.X, KnockbackForce.Y, KnockbackForce.Z);
+    }
+}
+
+void FGWTEffectCommandBuffer::ApplySummon(const FVector& Location)
+{
+    // In a full implementation, we would spawn an actual minion actor here
+    UE_LOG(LogTemp, Verbose, TEXT("Applied summon effect at location (%f, %f, %f)"),
+        Location.X, Location.Y, Location.Z);
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+// FGWTRuntimeValue.cpp
+// Implementation of the compact spell variable value
+
+#include "FGWTRuntimeValue.h"
+#include "GameFramework/Actor.h"
+
+FGWTRuntimeValue FGWTRuntimeValue::MakeFloat(float Value)
+{
+    FGWTRuntimeValue Result;
+    Result.Type = EGWTVariableType::Float;
+    Result.FloatValue = Value;
+    return Result;
+}
+
+FGWTRuntimeValue FGWTRuntimeValue::MakeInt(int32 Value)
+{
+    FGWTRuntimeValue Result;
+    Result.Type = EGWTVariableType::Int;
+    Result.IntValue = Value;
+    return Result;
+}
+
+FGWTRuntimeValue FGWTRuntimeValue::MakeBool(bool Value)
+{
+    FGWTRuntimeValue Result;
+    Result.Type = EGWTVariableType::Bool;
+    Result.BoolValue = Value;
+    return Result;
+}
+
+FGWTRuntimeValue FGWTRuntimeValue::MakeVector(const FVector& Value)
+{
+    FGWTRuntimeValue Result;
+    Result.Type = EGWTVariableType::Vector;
+    Result.VectorValue = FVector3f(Value);
+    return Result;
+}
+
+FGWTRuntimeValue FGWTRuntimeValue::MakeTarget(AActor* Value)
+{
+    FGWTRuntimeValue Result;
+    Result.Type = EGWTVariableType::Target;
+    Result.TargetValue = FWeakObjectPtr(Value);
+    return Result;
+}
+
+FGWTRuntimeValue FGWTRuntimeValue::FromVariableValue(const FGWTVariableValue& Value)
+{
+    // Keep only the field the type says is live
+    switch (Value.Type)
+    {
+    case EGWTVariableType::Int:
+        return MakeInt(Value.IntValue);
+
+    case EGWTVariableType::Bool:
+        return MakeBool(Value.BoolValue);
+
+    case EGWTVariableType::Vector:
+        return MakeVector(Value.VectorValue);
+
+    case EGWTVariableType::Target:
+        return MakeTarget(Value.TargetValue);
+
+    default:
+        return MakeFloat(Value.FloatValue);
+    }
+}
+
+FGWTVariableValue FGWTRuntimeValue::ToVariableValue() const
+{
+    FGWTVariableValue Result;
+    Result.Type = Type;
+
+    switch (Type)
+    {
+    case EGWTVariableType::Float:
+        Result.FloatValue = FloatValue;
+        break;
+
+    case EGWTVariableType::Int:
+        Result.IntValue = IntValue;
+        break;
+
+    case EGWTVariableType::Bool:
+        Result.BoolValue = BoolValue;
+        break;
+
+    case EGWTVariableType::Vector:
+        Result.VectorValue = GetVector();
+        break;
+
+    case EGWTVariableType::Target:
+        Result.TargetValue = GetTarget();
+        break;
+
+    default:
+        break;
+    }
+
+    return Result;
+}
+
+AActor* FGWTRuntimeValue::GetTarget() const
+{
+    // Destroyed actors read back as null
+    return Type == EGWTVariableType::Target ? Cast<AActor>(TargetValue.Get()) : nullptr;
+}
+
+FString FGWTRuntimeValue::ToString() const
+{
+    switch (Type)
+    {
+    case EGWTVariableType::Float:
+        return FString::Printf(TEXT("%f"), FloatValue);
+
+    case EGWTVariableType::Int:
+        return FString::Printf(TEXT("%d"), IntValue);
+
+    case EGWTVariableType::Bool:
+        return BoolValue ? TEXT("True") : TEXT("False");
+
+    case EGWTVariableType::Vector:
+        return FString::Printf(TEXT("(%f, %f, %f)"), VectorValue.X, VectorValue.Y, VectorValue.Z);
+
+    case EGWTVariableType::Target:
+    {
+        AActor* Target = GetTarget();
+        return Target ? Target->GetName() : TEXT("None");
+    }
+
+    default:
+        return TEXT("Unknown type");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,745 @@
+// FGWTSpellCompiler.cpp
+// Implementation of the spell graph compiler
+
+#include "FGWTSpellCompiler.h"
+#include "UGWTSpell.h"
+#include "UGWTSpellNode.h"
+#include "UGWTMagicNode.h"
+#include "UGWTEffectNode.h"
+#include "UGWTTriggerNode.h"
+#include "UGWTConditionNode.h"
+#include "UGWTVariableNode.h"
+#include "UGWTFlowNode.h"
+#include "FGWTSpellSerializer.h"
+
+FGWTSpellCompiler::FGWTSpellCompiler(FGWTSpellProgram& InProgram)
+    : Program(InProgram)
+{
+}
+
+EGWTSpellCompileResult FGWTSpellCompiler::Compile(const UGWTSpell* Spell, TSharedPtr<const FGWTSpellProgram>& OutProgram)
+{
+    if (!Spell || Spell->RootNodes.Num() == 0)
+    {
+        return EGWTSpellCompileResult::EmptyGraph;
+    }
+
+    TSharedPtr<FGWTSpellProgram> NewProgram = MakeShared<FGWTSpellProgram>();
+    FGWTSpellCompiler Compiler(*NewProgram);
+
+    // Assign every reachable node an index, rejecting cycles up front
+    for (UGWTSpellNode* RootNode : Spell->RootNodes)
+    {
+        if (RootNode && !Compiler.CollectNodes(RootNode))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Spell '%s' has a cycle and cannot be compiled"), *Spell->SpellName.ToString());
+            return EGWTSpellCompileResult::CycleDetected;
+        }
+    }
+
+    // Instructions address their node with 16 bits
+    if (Compiler.Nodes.Num() > MAX_uint16)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Spell '%s' has too many nodes to compile (%d)"),
+            *Spell->SpellName.ToString(), Compiler.Nodes.Num());
+        return EGWTSpellCompileResult::TooManyNodes;
+    }
+
+    // Fold constants and drop dead nodes before lowering
+    FGWTSpellOptimizer::Optimize(Spell, Compiler.Optimization);
+
+    // Region 0 runs the spell's live roots, loop bodies add more regions as they are found
+    TArray<UGWTSpellNode*> EntryRoots;
+    for (UGWTSpellNode* RootNode : Spell->RootNodes)
+    {
+        if (Compiler.Optimization.IsLive(RootNode))
+        {
+            EntryRoots.AddUnique(RootNode);
+        }
+    }
+
+    // Independent root groups get an entry region each, called in order from a dispatcher at index 0
+    TArray<TArray<UGWTSpellNode*>> EntryGroups;
+    Compiler.PartitionEntryRoots(EntryRoots, EntryGroups);
+
+    if (EntryGroups.Num() > 1)
+    {
+        for (const TArray<UGWTSpellNode*>& Group : EntryGroups)
+        {
+            Compiler.EmitRegionCall(Compiler.RegionRoots.Add(Group), Compiler.NodeIndices[Group[0]]);
+        }
+        Compiler.Emit(EGWTSpellOpCode::Return, Compiler.NodeIndices[EntryGroups[0][0]]);
+    }
+    else
+    {
+        Compiler.RegionRoots.Add(EntryRoots);
+    }
+
+    for (int32 RegionIndex = 0; RegionIndex < Compiler.RegionRoots.Num(); RegionIndex++)
+    {
+        if (!Compiler.EmitRegion(RegionIndex))
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("Spell '%s' uses an unsupported node type"), *Spell->SpellName.ToString());
+            return EGWTSpellCompileResult::UnsupportedNode;
+        }
+    }
+
+    // Resolve region calls now that every region has an address
+    for (const TPair<int32, int32>& Fixup : Compiler.CallFixups)
+    {
+        NewProgram->Instructions[Fixup.Key].Jump = Compiler.RegionStarts[Fixup.Value];
+    }
+
+    // Group regions were added first, so they are regions 0 to N-1
+    if (EntryGroups.Num() > 1)
+    {
+        for (int32 GroupIndex = 0; GroupIndex < EntryGroups.Num(); GroupIndex++)
+        {
+            NewProgram->ParallelEntries.Add(Compiler.RegionStarts[GroupIndex]);
+        }
+    }
+
+    // Node table for diagnostics, by structural index so any spell sharing the program can name its own nodes
+    TArray<UGWTSpellNode*> StructureNodes;
+    FGWTSpellSerializer::GetStructureNodes(Spell, StructureNodes);
+
+    TMap<const UGWTSpellNode*, int32> SourceIndices;
+    for (int32 i = 0; i < StructureNodes.Num(); i++)
+    {
+        SourceIndices.Add(StructureNodes[i], i);
+    }
+
+    NewProgram->NodeSourceIndices.Reserve(Compiler.Nodes.Num());
+    for (UGWTSpellNode* Node : Compiler.Nodes)
+    {
+        const int32* SourceIndex = SourceIndices.Find(Node);
+        NewProgram->NodeSourceIndices.Add(SourceIndex ? *SourceIndex : INDEX_NONE);
+    }
+
+    NewProgram->NumMemoSlots = Compiler.Optimization.NumMemoSlots;
+    NewProgram->OptimizationReport = Compiler.Optimization.Report;
+    NewProgram->Instructions.Shrink();
+
+    UE_LOG(LogTemp, Verbose, TEXT("Optimized spell '%s': %s"), *Spell->SpellName.ToString(),
+        *NewProgram->OptimizationReport.ToString());
+    for (const FGWTSpellRemovedNode& Removed : NewProgram->OptimizationReport.RemovedNodes)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("  Removed node '%s': %s"), *Removed.NodeTitle, *Removed.Reason);
+
+    }
+
+    // The shared copy must not name this spell's nodes
+    TArray<FGWTSpellRemovedNode>& RemovedNodes = NewProgram->OptimizationReport.RemovedNodes;
+    for (int32 i = 0; i < RemovedNodes.Num(); i++)
+    {
+        const int32* SourceIndex = SourceIndices.Find(Compiler.Optimization.RemovedNodes[i]);
+        RemovedNodes[i].SourceIndex = SourceIndex ? *SourceIndex : INDEX_NONE;
+        RemovedNodes[i].NodeID.Invalidate();
+        RemovedNodes[i].NodeTitle.Reset();
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("Compiled spell '%s': %d nodes, %d regions, %d instructions, %d variable slots, %d parallel groups"),
+        *Spell->SpellName.ToString(), Compiler.Nodes.Num(), Compiler.RegionRoots.Num(),
+        NewProgram->Instructions.Num(), NewProgram->SlotNames.Num(), FMath::Max(1, NewProgram->ParallelEntries.Num()));
+
+    OutProgram = NewProgram;
+    return EGWTSpellCompileResult::Success;
+}
+
+const TCHAR* FGWTSpellCompiler::GetResultString(EGWTSpellCompileResult Result)
+{
+    switch (Result)
+    {
+    case EGWTSpellCompileResult::Success: return TEXT("Success");
+    case EGWTSpellCompileResult::EmptyGraph: return TEXT("Empty graph");
+    case EGWTSpellCompileResult::CycleDetected: return TEXT("Cycle detected");
+    case EGWTSpellCompileResult::UnsupportedNode: return TEXT("Unsupported node");
+    case EGWTSpellCompileResult::TooManyNodes: return TEXT("Too many nodes");
+    default: return TEXT("Unknown");
+    }
+}
+
+bool FGWTSpellCompiler::CollectNodes(UGWTSpellNode* Node)
+{
+    // A node already on the current path means execution would loop back to it
+    if (ActivePath.Contains(Node))
+    {
+        return false;
+    }
+
+    // Already collected through another path
+    if (NodeIndices.Contains(Node))
+    {
+        return true;
+    }
+
+    NodeIndices.Add(Node, Nodes.Add(Node));
+    ActivePath.Add(Node);
+
+    TArray<UGWTSpellNode*> Successors;
+    GetExecutionSuccessors(Node, Successors);
+
+    for (UGWTSpellNode* Successor : Successors)
+    {
+        if (!CollectNodes(Successor))
+        {
+            return false;
+        }
+    }
+
+    ActivePath.Remove(Node);
+    return true;
+}
+
+void FGWTSpellCompiler::GetExecutionSuccessors(UGWTSpellNode* Node, TArray<UGWTSpellNode*>& OutSuccessors)
+{
+    // Conditions only ever follow their true and false paths
+    if (UGWTConditionNode* ConditionNode = Cast<UGWTConditionNode>(Node))
+    {
+        if (ConditionNode->TruePathNode)
+        {
+            OutSuccessors.Add(ConditionNode->TruePathNode);
+        }
+        if (ConditionNode->FalsePathNode)
+        {
+            OutSuccessors.Add(ConditionNode->FalsePathNode);
+        }
+        return;
+    }
+
+    for (UGWTSpellNode* OutputNode : Node->OutputNodes)
+    {
+        if (OutputNode)
+        {
+            OutSuccessors.Add(OutputNode);
+        }
+    }
+}
+
+void FGWTSpellCompiler::GetRegionSuccessors(UGWTSpellNode* Node, TArray<UGWTSpellNode*>& OutSuccessors) const
+{
+    FGWTSpellOptimizer::GetLiveSuccessors(Node, Optimization, OutSuccessors);
+
+    // Dead nodes are never scheduled
+    OutSuccessors.RemoveAll([this](UGWTSpellNode* Successor) { return !Optimization.IsLive(Successor); });
+
+    // A loop's body belongs to the loop's own region
+    if (IsLoopNode(Node))
+    {
+        OutSuccessors.Remove(CastChecked<UGWTFlowNode>(Node)->BodyNode);
+    }
+}
+
+bool FGWTSpellCompiler::IsLoopNode(UGWTSpellNode* Node) const
+{
+    // Folded while loops behave like a plain pass-through
+    const UGWTFlowNode* FlowNode = Cast<UGWTFlowNode>(Node);
+    return FlowNode && FlowNode->BodyNode && FlowNode->FlowType != EGWTFlowType::Delay &&
+        !Optimization.SkippedLoops.Contains(Node);
+}
+
+int32 FGWTSpellCompiler::GetLoopBodyRegion(UGWTSpellNode* LoopNode)
+{
+    // One region per loop node, shared if the loop appears in several regions
+    if (const int32* Existing = LoopBodyRegions.Find(LoopNode))
+    {
+        return *Existing;
+    }
+
+    TArray<UGWTSpellNode*> BodyRoots;
+    BodyRoots.Add(CastChecked<UGWTFlowNode>(LoopNode)->BodyNode);
+
+    const int32 RegionIndex = RegionRoots.Add(BodyRoots);
+    LoopBodyRegions.Add(LoopNode, RegionIndex);
+    return RegionIndex;
+}
+
+void FGWTSpellCompiler::AddNodeAccess(UGWTSpellNode* Node, FNodeAccess& Access) const
+{
+    if (Node->IsA<UGWTMagicNode>())
+    {
+        // Range check reads positions, the payload changes vitals
+        Access.Reads |= AccessLocation;
+        Access.Writes |= AccessVitals;
+    }
+    else if (const UGWTEffectNode* EffectNode = Cast<UGWTEffectNode>(Node))
+    {
+        const bool bMoves = EffectNode->EffectType == EGWTEffectType::Teleport || EffectNode->EffectType == EGWTEffectType::Knockback;
+        Access.Writes |= bMoves ? AccessLocation : AccessVitals;
+    }
+    else if (const UGWTConditionNode* ConditionNode = Cast<UGWTConditionNode>(Node))
+    {
+        // Folded conditions never run, random rolls only read the seed
+        if (!Optimization.FoldedConditions.Contains(Node) && ConditionNode->ConditionType != EGWTConditionType::RandomChance)
+        {
+            Access.Reads |= ConditionNode->ConditionType == EGWTConditionType::DistanceCheck ? AccessLocation : AccessVitals;
+        }
+    }
+    else if (const UGWTTriggerNode* TriggerNode = Cast<UGWTTriggerNode>(Node))
+    {
+        // Hit triggers read the context's hit result, which every task gets a copy of
+        if (TriggerNode->TriggerType == EGWTTriggerType::OnHealthBelow || TriggerNode->TriggerType == EGWTTriggerType::OnManaAbove)
+        {
+            Access.Reads |= AccessVitals;
+        }
+    }
+    else if (const UGWTVariableNode* VariableNode = Cast<UGWTVariableNode>(Node))
+    {
+        if (!Optimization.ElidedNodes.Contains(Node))
+        {
+            Access.Variables.Add(VariableNode->VariableName);
+        }
+    }
+    else if (const UGWTFlowNode* FlowNode = Cast<UGWTFlowNode>(Node))
+    {
+        if (IsLoopNode(Node) && FlowNode->FlowType == EGWTFlowType::While)
+        {
+            Access.Variables.Add(FlowNode->ConditionVariableName);
+        }
+        else if (IsLoopNode(Node) && FlowNode->FlowType == EGWTFlowType::ForEach)
+        {
+            Access.Variables.Add(UGWTFlowNode::IndexVariableName);
+        }
+    }
+}
+
+void FGWTSpellCompiler::PartitionEntryRoots(const TArray<UGWTSpellNode*>& EntryRoots, TArray<TArray<UGWTSpellNode*>>& OutGroups) const
+{
+    OutGroups.Reset();
+    if (EntryRoots.Num() < 2)
+    {
+        OutGroups.Add(EntryRoots);
+        return;
+    }
+
+    // Group of each root, roots are merged by pointing at the lower index
+    TArray<int32> GroupOf;
+    for (int32 i = 0; i < EntryRoots.Num(); i++)
+    {
+        GroupOf.Add(i);
+    }
+
+    auto FindGroup = [&GroupOf](int32 Index)
+    {
+        while (GroupOf[Index] != Index)
+        {
+            Index = GroupOf[Index];
+        }
+        return Index;
+    };
+
+    auto MergeGroups = [&GroupOf, &FindGroup](int32 A, int32 B)
+    {
+        A = FindGroup(A);
+        B = FindGroup(B);
+        if (A != B)
+        {
+            GroupOf[FMath::Max(A, B)] = FMath::Min(A, B);
+        }
+    };
+
+    // Roots that reach a shared node, loop bodies included, run in the same group
+    TMap<UGWTSpellNode*, int32> Owners;
+    TArray<FNodeAccess> RootAccess;
+    RootAccess.SetNum(EntryRoots.Num());
+    TArray<UGWTSpellNode*> Pending;
+    TArray<UGWTSpellNode*> Successors;
+
+    for (int32 RootIndex = 0; RootIndex < EntryRoots.Num(); RootIndex++)
+    {
+        Pending.Reset();
+        Pending.Add(EntryRoots[RootIndex]);
+
+        while (Pending.Num() > 0)
+        {
+            UGWTSpellNode* Node = Pending.Pop(false);
+            if (const int32* Owner = Owners.Find(Node))
+            {
+                MergeGroups(*Owner, RootIndex);
+                continue;
+            }
+
+            Owners.Add(Node, RootIndex);
+            AddNodeAccess(Node, RootAccess[RootIndex]);
+
+            Successors.Reset();
+            FGWTSpellOptimizer::GetLiveSuccessors(Node, Optimization, Successors);
+            for (UGWTSpellNode* Successor : Successors)
+            {
+                if (Optimization.IsLive(Successor))
+                {
+                    Pending.Add(Successor);
+                }
+            }
+        }
+    }
+
+    // Merge groups until none reads what another writes or shares a variable with it
+    bool bMerged = true;
+    while (bMerged)
+    {
+        bMerged = false;
+
+        TMap<int32, FNodeAccess> GroupAccess;
+        for (int32 RootIndex = 0; RootIndex < EntryRoots.Num(); RootIndex++)
+        {
+            FNodeAccess& Access = GroupAccess.FindOrAdd(FindGroup(RootIndex));
+            Access.Reads |= RootAccess[RootIndex].Reads;
+            Access.Writes |= RootAccess[RootIndex].Writes;
+            Access.Variables.Append(RootAccess[RootIndex].Variables);
+        }
+
+        for (auto A = GroupAccess.CreateConstIterator(); A && !bMerged; ++A)
+        {
+            for (auto B = GroupAccess.CreateConstIterator(); B && !bMerged; ++B)
+            {
+                if (A.Key() < B.Key() && ((A.Value().Writes & B.Value().Reads) || (B.Value().Writes & A.Value().Reads) ||
+                    A.Value().Variables.Intersect(B.Value().Variables).Num() > 0))
+                {
+                    MergeGroups(A.Key(), B.Key());
+                    bMerged = true;
+                }
+            }
+        }
+
+        // Tasks defer their payloads, so a group must never read what it writes itself
+        if (!bMerged)
+        {
+            for (const TPair<int32, FNodeAccess>& Group : GroupAccess)
+            {
+                if (Group.Value.Reads & Group.Value.Writes)
+                {
+                    OutGroups.Add(EntryRoots);
+                    return;
+                }
+            }
+        }
+    }
+
+    // Groups in order of their first root, keeping the serial order stable
+    TMap<int32, int32> GroupSlots;
+    for (int32 RootIndex = 0; RootIndex < EntryRoots.Num(); RootIndex++)
+    {
+        const int32 Group = FindGroup(RootIndex);
+        if (!GroupSlots.Contains(Group))
+        {
+            GroupSlots.Add(Group, OutGroups.AddDefaulted());
+        }
+        OutGroups[GroupSlots[Group]].Add(EntryRoots[RootIndex]);
+    }
+}
+
+bool FGWTSpellCompiler::EmitRegion(int32 RegionIndex)
+{
+    const TArray<UGWTSpellNode*> Roots = RegionRoots[RegionIndex];
+    RegionStarts.SetNum(FMath::Max(RegionStarts.Num(), RegionIndex + 1));
+    RegionStarts[RegionIndex] = Program.Instructions.Num();
+
+    // Gather the region's nodes in discovery order
+    TArray<UGWTSpellNode*> RegionNodes;
+    TMap<UGWTSpellNode*, int32> Positions;
+    TArray<UGWTSpellNode*> Successors;
+
+    for (UGWTSpellNode* Root : Roots)
+    {
+        Positions.Add(Root, RegionNodes.Add(Root));
+    }
+    for (int32 i = 0; i < RegionNodes.Num(); i++)
+    {
+        Successors.Reset();
+        GetRegionSuccessors(RegionNodes[i], Successors);
+        for (UGWTSpellNode* Successor : Successors)
+        {
+            if (!Positions.Contains(Successor))
+            {
+                Positions.Add(Successor, RegionNodes.Add(Successor));
+            }
+        }
+    }
+
+    // Count incoming edges inside the region
+    TArray<int32> InDegree;
+    InDegree.SetNumZeroed(RegionNodes.Num());
+    for (UGWTSpellNode* Node : RegionNodes)
+    {
+        Successors.Reset();
+        GetRegionSuccessors(Node, Successors);
+        for (UGWTSpellNode* Successor : Successors)
+        {
+            InDegree[Positions[Successor]]++;
+        }
+    }
+
+    // Topological order, ties broken by discovery order so the schedule is stable
+    TArray<int32> Ready;
+    for (int32 i = 0; i < RegionNodes.Num(); i++)
+    {
+        if (InDegree[i] == 0)
+        {
+            Ready.HeapPush(i);
+        }
+    }
+
+    TArray<UGWTSpellNode*> Schedule;
+    Schedule.Reserve(RegionNodes.Num());
+    while (Ready.Num() > 0)
+    {
+        int32 Position;
+        Ready.HeapPop(Position, false);
+        Schedule.Add(RegionNodes[Position]);
+
+        Successors.Reset();
+        GetRegionSuccessors(RegionNodes[Position], Successors);
+        for (UGWTSpellNode* Successor : Successors)
+        {
+            const int32 SuccessorPosition = Positions[Successor];
+            if (--InDegree[SuccessorPosition] == 0)
+            {
+                Ready.HeapPush(SuccessorPosition);
+            }
+        }
+    }
+
+    // One join counter per node in this region
+    TMap<UGWTSpellNode*, int32> Counters;
+    const int32 CounterBase = Program.NumJoinCounters;
+    for (int32 i = 0; i < Schedule.Num(); i++)
+    {
+        Counters.Add(Schedule[i], CounterBase + i);
+    }
+    Program.NumJoinCounters += Schedule.Num();
+
+    const int32 EntryNodeIndex = Roots.Num() > 0 ? NodeIndices[Roots[0]] : 0;
+    const int32 BeginIndex = Emit(EGWTSpellOpCode::RegionBegin, EntryNodeIndex);
+    Program.Instructions[BeginIndex].Arg = CounterBase;
+    Program.Instructions[BeginIndex].Aux = Schedule.Num();
+
+    for (UGWTSpellNode* Root : Roots)
+    {
+        EmitActivate(Root, Counters, EntryNodeIndex);
+    }
+
+    // Each node: fire while its join counter allows, then fall through to the next node
+    for (UGWTSpellNode* Node : Schedule)
+    {
+        const int32 NodeIndex = NodeIndices[Node];
+        const int32 JoinCheck = Emit(EGWTSpellOpCode::TakeActivation, NodeIndex);
+        Program.Instructions[JoinCheck].Arg = Counters[Node];
+        Program.Instructions[JoinCheck].SubType = (uint8)Node->JoinMode;
+
+        if (!EmitNodeBody(Node, Counters, JoinCheck))
+        {
+            return false;
+        }
+
+        Program.Instructions[JoinCheck].Jump = Program.Instructions.Num();
+    }
+
+    Emit(EGWTSpellOpCode::Return, EntryNodeIndex);
+    return true;
+}
+
+bool FGWTSpellCompiler::EmitNodeBody(UGWTSpellNode* Node, const TMap<UGWTSpellNode*, int32>& Counters, int32 JoinCheck)
+{
+    const int32 NodeIndex = NodeIndices[Node];
+
+    if (UGWTMagicNode* MagicNode = Cast<UGWTMagicNode>(Node))
+    {
+        // Channel for the cast time before the payload goes off
+        if (MagicNode->CastTime > 0.0f)
+        {
+            Program.Instructions[Emit(EGWTSpellOpCode::Wait, NodeIndex)].ValueA = MagicNode->CastTime;
+        }
+
+        // Magic payload, skips its outputs when there is nothing to hit
+        const int32 OpIndex = Emit(EGWTSpellOpCode::Magic, NodeIndex);
+        Program.Instructions[OpIndex].SubType = (uint8)MagicNode->ElementType;
+        Program.Instructions[OpIndex].ValueA = MagicNode->BaseDamage;
+        Program.Instructions[OpIndex].ValueB = MagicNode->Range;
+
+        for (UGWTSpellNode* OutputNode : Node->OutputNodes)
+        {
+            EmitActivate(OutputNode, Counters, NodeIndex);
+        }
+
+        Program.Instructions[OpIndex].Jump = Program.Instructions.Num();
+        Program.Instructions[Emit(EGWTSpellOpCode::Jump, NodeIndex)].Jump = JoinCheck;
+        return true;
+    }
+
+    if (UGWTEffectNode* EffectNode = Cast<UGWTEffectNode>(Node))
+    {
+        const int32 OpIndex = Emit(EGWTSpellOpCode::Effect, NodeIndex);
+        Program.Instructions[OpIndex].SubType = (uint8)EffectNode->EffectType;
+        Program.Instructions[OpIndex].Aux = (int32)EffectNode->ElementType;
+        Program.Instructions[OpIndex].ValueA = EffectNode->EffectValue;
+        Program.Instructions[OpIndex].ValueB = EffectNode->EffectDuration;
+
+        for (UGWTSpellNode* OutputNode : Node->OutputNodes)
+        {
+            EmitActivate(OutputNode, Counters, NodeIndex);
+        }
+
+        Program.Instructions[OpIndex].Jump = Program.Instructions.Num();
+        Program.Instructions[Emit(EGWTSpellOpCode::Jump, NodeIndex)].Jump = JoinCheck;
+        return true;
+    }
+
+    if (UGWTTriggerNode* TriggerNode = Cast<UGWTTriggerNode>(Node))
+    {
+        const int32 OpIndex = Emit(EGWTSpellOpCode::Trigger, NodeIndex);
+        Program.Instructions[OpIndex].SubType = (uint8)TriggerNode->TriggerType;
+        Program.Instructions[OpIndex].ValueA = TriggerNode->TriggerValue;
+
+        for (UGWTSpellNode* OutputNode : Node->OutputNodes)
+        {
+            EmitActivate(OutputNode, Counters, NodeIndex);
+        }
+
+        Program.Instructions[OpIndex].Jump = Program.Instructions.Num();
+        Program.Instructions[Emit(EGWTSpellOpCode::Jump, NodeIndex)].Jump = JoinCheck;
+        return true;
+    }
+
+    if (UGWTConditionNode* ConditionNode = Cast<UGWTConditionNode>(Node))
+    {
+        // Folded conditions only activate the path they always take
+        if (const bool* FoldedResult = Optimization.FoldedConditions.Find(Node))
+        {
+            EmitActivate(*FoldedResult ? ConditionNode->TruePathNode : ConditionNode->FalsePathNode, Counters, NodeIndex);
+            Program.Instructions[Emit(EGWTSpellOpCode::Jump, NodeIndex)].Jump = JoinCheck;
+            return true;
+        }
+
+        // Branch: true path falls through, false path is jumped to
+        const int32 OpIndex = Emit(EGWTSpellOpCode::Branch, NodeIndex);
+        Program.Instructions[OpIndex].SubType = (uint8)ConditionNode->ConditionType;
+        Program.Instructions[OpIndex].ValueA = ConditionNode->ComparisonValue;
+
+        const int32* MemoSlot = Optimization.MemoSlots.Find(Node);
+        Program.Instructions[OpIndex].Arg = MemoSlot ? *MemoSlot : INDEX_NONE;
+
+        EmitActivate(ConditionNode->TruePathNode, Counters, NodeIndex);
+        Program.Instructions[Emit(EGWTSpellOpCode::Jump, NodeIndex)].Jump = JoinCheck;
+
+        Program.Instructions[OpIndex].Jump = Program.Instructions.Num();
+        EmitActivate(ConditionNode->FalsePathNode, Counters, NodeIndex);
+        Program.Instructions[Emit(EGWTSpellOpCode::Jump, NodeIndex)].Jump = JoinCheck;
+        return true;
+    }
+
+    if (UGWTVariableNode* VariableNode = Cast<UGWTVariableNode>(Node))
+    {
+        // Nothing reads this variable, keep the node only for its connections
+        if (Optimization.ElidedNodes.Contains(Node))
+        {
+            for (UGWTSpellNode* OutputNode : Node->OutputNodes)
+            {
+                EmitActivate(OutputNode, Counters, NodeIndex);
+            }
+
+            Program.Instructions[Emit(EGWTSpellOpCode::Jump, NodeIndex)].Jump = JoinCheck;
+            return true;
+        }
+
+        const int32 OpIndex = Emit(EGWTSpellOpCode::Variable, NodeIndex);
+        Program.Instructions[OpIndex].SubType = (uint8)VariableNode->Operation;
+        Program.Instructions[OpIndex].Arg = AddSlot(VariableNode->VariableName);
+        Program.Instructions[OpIndex].Aux = Program.Constants.Add(FGWTRuntimeValue::FromVariableValue(VariableNode->DefaultValue));
+
+        for (UGWTSpellNode* OutputNode : Node->OutputNodes)
+        {
+            EmitActivate(OutputNode, Counters, NodeIndex);
+        }
+
+        Program.Instructions[Emit(EGWTSpellOpCode::Jump, NodeIndex)].Jump = JoinCheck;
+        return true;
+    }
+
+    if (UGWTFlowNode* FlowNode = Cast<UGWTFlowNode>(Node))
+    {
+        if (IsLoopNode(FlowNode))
+        {
+            // LoopBegin, then a loop head that runs the body region until the loop is done
+            const int32 BeginIndex = Emit(EGWTSpellOpCode::LoopBegin, NodeIndex);
+            int32 HeadIndex = INDEX_NONE;
+
+            switch (FlowNode->FlowType)
+            {
+            case EGWTFlowType::While:
+                Program.Instructions[BeginIndex].Arg = UGWTFlowNode::MaxWhileIterations;
+                HeadIndex = Emit(EGWTSpellOpCode::WhileNext, NodeIndex);
+                Program.Instructions[HeadIndex].Arg = AddSlot(FlowNode->ConditionVariableName);
+                break;
+
+            case EGWTFlowType::ForEach:
+                Program.Instructions[BeginIndex].Arg = FMath::Max(0, FlowNode->IterationCount);
+                HeadIndex = Emit(EGWTSpellOpCode::ForEachNext, NodeIndex);
+                Program.Instructions[HeadIndex].Arg = AddSlot(UGWTFlowNode::IndexVariableName);
+                break;
+
+            default:
+                Program.Instructions[BeginIndex].Arg = FMath::Max(0, FlowNode->IterationCount);
+                HeadIndex = Emit(EGWTSpellOpCode::RepeatNext, NodeIndex);
+                break;
+            }
+
+            EmitRegionCall(GetLoopBodyRegion(FlowNode), NodeIndex);
+            Program.Instructions[Emit(EGWTSpellOpCode::Jump, NodeIndex)].Jump = HeadIndex;
+            Program.Instructions[HeadIndex].Jump = Program.Instructions.Num();
+        }
+        else if (FlowNode->BodyNode && FlowNode->FlowType == EGWTFlowType::Delay)
+        {
+            // Wait out the delay, then activate the body
+            Program.Instructions[Emit(EGWTSpellOpCode::Wait, NodeIndex)].ValueA = FlowNode->TimeLimit;
+            EmitActivate(FlowNode->BodyNode, Counters, NodeIndex);
+        }
+
+        // Remaining outputs run after the loop completes, a folded loop never runs its body
+        for (UGWTSpellNode* OutputNode : Node->OutputNodes)
+        {
+            if (OutputNode != FlowNode->BodyNode)
+            {
+                EmitActivate(OutputNode, Counters, NodeIndex);
+            }
+        }
+
+        Program.Instructions[Emit(EGWTSpellOpCode::Jump, NodeIndex)].Jump = JoinCheck;
+        return true;
+    }
+
+    // Node type the VM does not know about
+    return false;
+}
+
+int32 FGWTSpellCompiler::Emit(EGWTSpellOpCode OpCode, int32 NodeIndex)
+{
+    FGWTSpellInstruction Instruction;
+    Instruction.OpCode = OpCode;
+    Instruction.NodeIndex = (uint16)NodeIndex;
+
+    return Program.Instructions.Add(Instruction);
+}
+
+void FGWTSpellCompiler::EmitActivate(UGWTSpellNode* Target, const TMap<UGWTSpellNode*, int32>& Counters, int32 NodeIndex)
+{
+    // Activating a dead node would do nothing
+    if (!Optimization.IsLive(Target))
+    {
+        return;
+    }
+
+    Program.Instructions[Emit(EGWTSpellOpCode::Activate, NodeIndex)].Arg = Counters[Target];
+}
+
+void FGWTSpellCompiler::EmitRegionCall(int32 RegionIndex, int32 NodeIndex)
+{
+    const int32 OpIndex = Emit(EGWTSpellOpCode::Call, NodeIndex);
+    CallFixups.Add(TPair<int32, int32>(OpIndex, RegionIndex));
+}
+
+int32 FGWTSpellCompiler::AddSlot(FName Name)
+{
+    // Every use of the same name shares one slot
+    return Program.SlotNames.AddUnique(Name);
+}
\ No newline at end of file
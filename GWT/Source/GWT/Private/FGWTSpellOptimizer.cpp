@@ -0,0 +1,320 @@
+// FGWTSpellOptimizer.cpp
+// Implementation of the spell graph optimizer
+
+#include "FGWTSpellOptimizer.h"
+#include "UGWTSpell.h"
+#include "UGWTSpellNode.h"
+#include "UGWTMagicNode.h"
+#include "UGWTEffectNode.h"
+#include "UGWTTriggerNode.h"
+#include "UGWTConditionNode.h"
+#include "UGWTVariableNode.h"
+#include "UGWTFlowNode.h"
+
+void FGWTSpellOptimizer::Optimize(const UGWTSpell* Spell, FGWTSpellOptimization& OutOptimization)
+{
+    OutOptimization = FGWTSpellOptimization();
+    if (!Spell)
+    {
+        return;
+    }
+
+    // Everything reachable before any folding, in discovery order
+    TArray<UGWTSpellNode*> Reachable;
+    TSet<UGWTSpellNode*> Seen;
+    TArray<UGWTSpellNode*> Successors;
+
+    for (UGWTSpellNode* RootNode : Spell->RootNodes)
+    {
+        if (RootNode && !Seen.Contains(RootNode))
+        {
+            Seen.Add(RootNode);
+            Reachable.Add(RootNode);
+        }
+    }
+    for (int32 i = 0; i < Reachable.Num(); i++)
+    {
+        Successors.Reset();
+        GetLiveSuccessors(Reachable[i], OutOptimization, Successors);
+        for (UGWTSpellNode* Successor : Successors)
+        {
+            if (!Seen.Contains(Successor))
+            {
+                Seen.Add(Successor);
+                Reachable.Add(Successor);
+            }
+        }
+    }
+
+    // Variables only matter when a while loop reads them, spell variables never outlive the cast
+    TSet<FName> ObservedNames;
+    for (UGWTSpellNode* Node : Reachable)
+    {
+        const UGWTFlowNode* FlowNode = Cast<UGWTFlowNode>(Node);
+        if (FlowNode && FlowNode->BodyNode && FlowNode->FlowType == EGWTFlowType::While)
+        {
+            ObservedNames.Add(FlowNode->ConditionVariableName);
+        }
+    }
+
+    // Find the writers of each observed variable, and drop operations on everything else
+    TMap<FName, bool> CanBeTrue;
+    for (UGWTSpellNode* Node : Reachable)
+    {
+        if (const UGWTVariableNode* VariableNode = Cast<UGWTVariableNode>(Node))
+        {
+            if (!ObservedNames.Contains(VariableNode->VariableName))
+            {
+                OutOptimization.ElidedNodes.Add(Node);
+                continue;
+            }
+
+            // Reads store their default when unset, writes store it outright, anything else is unknown
+            const bool bConstantWrite = VariableNode->Operation == UGWTVariableNode::EVariableOperation::Read ||
+                VariableNode->Operation == UGWTVariableNode::EVariableOperation::Write;
+            const bool bWritesTrue = !bConstantWrite ||
+                !IsFalseCondition(FGWTRuntimeValue::FromVariableValue(VariableNode->DefaultValue));
+
+            CanBeTrue.FindOrAdd(VariableNode->VariableName) |= bWritesTrue;
+        }
+        else if (const UGWTFlowNode* FlowNode = Cast<UGWTFlowNode>(Node))
+        {
+            // ForEach publishes its index, which is non-zero after the first iteration
+            if (FlowNode->BodyNode && FlowNode->FlowType == EGWTFlowType::ForEach &&
+                ObservedNames.Contains(UGWTFlowNode::IndexVariableName))
+            {
+                CanBeTrue.Add(UGWTFlowNode::IndexVariableName, true);
+            }
+        }
+    }
+
+    // Fold while loops nothing can ever make true, and conditions with a fixed outcome
+    for (UGWTSpellNode* Node : Reachable)
+    {
+        if (const UGWTFlowNode* FlowNode = Cast<UGWTFlowNode>(Node))
+        {
+            if (FlowNode->BodyNode && FlowNode->FlowType == EGWTFlowType::While &&
+                !CanBeTrue.FindRef(FlowNode->ConditionVariableName))
+            {
+                OutOptimization.SkippedLoops.Add(Node);
+                OutOptimization.Report.FoldedLoops++;
+            }
+        }
+        else if (const UGWTConditionNode* ConditionNode = Cast<UGWTConditionNode>(Node))
+        {
+            bool bResult = false;
+            if (TryFoldCondition(ConditionNode->ConditionType, ConditionNode->ComparisonValue, bResult))
+            {
+                OutOptimization.FoldedConditions.Add(Node, bResult);
+                OutOptimization.Report.FoldedBranches++;
+            }
+        }
+    }
+
+    // Walk the folded graph, only entering nodes that lead to an observable effect
+    TMap<UGWTSpellNode*, bool> Useful;
+    TSet<UGWTSpellNode*> FoldedReachable;
+    TArray<UGWTSpellNode*> Pending;
+
+    for (UGWTSpellNode* RootNode : Spell->RootNodes)
+    {
+        if (RootNode && !FoldedReachable.Contains(RootNode))
+        {
+            FoldedReachable.Add(RootNode);
+            Pending.Add(RootNode);
+        }
+    }
+    for (int32 i = 0; i < Pending.Num(); i++)
+    {
+        UGWTSpellNode* Node = Pending[i];
+        if (IsUseful(Node, OutOptimization, Useful))
+        {
+            OutOptimization.LiveOrder.Add(Node);
+            OutOptimization.LiveNodes.Add(Node);
+        }
+
+        Successors.Reset();
+        GetLiveSuccessors(Node, OutOptimization, Successors);
+        for (UGWTSpellNode* Successor : Successors)
+        {
+            if (!FoldedReachable.Contains(Successor))
+            {
+                FoldedReachable.Add(Successor);
+                Pending.Add(Successor);
+            }
+        }
+    }
+
+    // Only elided nodes that survive as pass-throughs are worth reporting
+    for (auto It = OutOptimization.ElidedNodes.CreateIterator(); It; ++It)
+    {
+        if (!OutOptimization.IsLive(*It))
+        {
+            It.RemoveCurrent();
+        }
+    }
+    OutOptimization.Report.ElidedVariableOps = OutOptimization.ElidedNodes.Num();
+
+    // Identical pure checks share one cached result per cast
+    TMap<TPair<uint8, float>, int32> CheckSlots;
+    for (UGWTSpellNode* Node : OutOptimization.LiveOrder)
+    {
+        const UGWTConditionNode* ConditionNode = Cast<UGWTConditionNode>(Node);
+        if (!ConditionNode || OutOptimization.FoldedConditions.Contains(Node) || !IsPureCondition(ConditionNode->ConditionType))
+        {
+            continue;
+        }
+
+        const TPair<uint8, float> Key((uint8)ConditionNode->ConditionType, ConditionNode->ComparisonValue);
+        if (const int32* ExistingSlot = CheckSlots.Find(Key))
+        {
+            OutOptimization.MemoSlots.Add(Node, *ExistingSlot);
+            OutOptimization.Report.SharedChecks++;
+        }
+        else
+        {
+            OutOptimization.MemoSlots.Add(Node, CheckSlots.Add(Key, OutOptimization.NumMemoSlots++));
+        }
+        OutOptimization.Report.MemoizedChecks++;
+    }
+
+    // Report what was dropped
+    FGWTSpellOptimizationReport& Report = OutOptimization.Report;
+    Report.NodesBefore = Reachable.Num();
+    Report.NodesAfter = OutOptimization.LiveNodes.Num();
+
+    for (UGWTSpellNode* Node : Reachable)
+    {
+        if (OutOptimization.IsLive(Node))
+        {
+            continue;
+        }
+
+        OutOptimization.RemovedNodes.Add(Node);
+        FGWTSpellRemovedNode& Removed = Report.RemovedNodes.AddDefaulted_GetRef();
+        Removed.NodeID = Node->NodeID;
+        Removed.NodeTitle = Node->NodeTitle.ToString();
+        Removed.Reason = FoldedReachable.Contains(Node) ? TEXT("No observable effect") : TEXT("Unreachable after folding");
+    }
+}
+
+bool FGWTSpellOptimizer::TryFoldCondition(EGWTConditionType ConditionType, float ComparisonValue, bool& bOutResult)
+{
+    // Random chance rolls 0-100 inclusive, so the ends of the range are certain
+    if (ConditionType == EGWTConditionType::RandomChance)
+    {
+        if (ComparisonValue >= 100.0f)
+        {
+            bOutResult = true;
+            return true;
+        }
+        if (ComparisonValue <= 0.0f)
+        {
+            bOutResult = false;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool FGWTSpellOptimizer::IsPureCondition(EGWTConditionType ConditionType)
+{
+    switch (ConditionType)
+    {
+    case EGWTConditionType::HealthCheck:
+    case EGWTConditionType::ManaCheck:
+    case EGWTConditionType::DistanceCheck:
+    case EGWTConditionType::ElementalCheck:
+    case EGWTConditionType::StatusEffectCheck:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+void FGWTSpellOptimizer::GetLiveSuccessors(UGWTSpellNode* Node, const FGWTSpellOptimization& Optimization, TArray<UGWTSpellNode*>& OutSuccessors)
+{
+    // Conditions follow only their folded path when the outcome is known
+    if (UGWTConditionNode* ConditionNode = Cast<UGWTConditionNode>(Node))
+    {
+        const bool* FoldedResult = Optimization.FoldedConditions.Find(Node);
+        if (ConditionNode->TruePathNode && (!FoldedResult || *FoldedResult))
+        {
+            OutSuccessors.Add(ConditionNode->TruePathNode);
+        }
+        if (ConditionNode->FalsePathNode && (!FoldedResult || !*FoldedResult))
+        {
+            OutSuccessors.Add(ConditionNode->FalsePathNode);
+        }
+        return;
+    }
+
+    // Skipped loops never enter their body
+    const UGWTSpellNode* SkippedBody = Optimization.SkippedLoops.Contains(Node) ? CastChecked<UGWTFlowNode>(Node)->BodyNode : nullptr;
+
+    for (UGWTSpellNode* OutputNode : Node->OutputNodes)
+    {
+        if (OutputNode && OutputNode != SkippedBody)
+        {
+            OutSuccessors.Add(OutputNode);
+        }
+    }
+}
+
+bool FGWTSpellOptimizer::IsUseful(UGWTSpellNode* Node, const FGWTSpellOptimization& Optimization,
+    TMap<UGWTSpellNode*, bool>& Visited)
+{
+    if (const bool* Known = Visited.Find(Node))
+    {
+        return *Known;
+    }
+
+    // Guard against cycles, a node on the current path adds nothing
+    Visited.Add(Node, false);
+
+    // Payloads are always observable, variable operations only when something reads them
+    bool bUseful = Node->IsA<UGWTMagicNode>() || Node->IsA<UGWTEffectNode>() ||
+        (Node->IsA<UGWTVariableNode>() && !Optimization.ElidedNodes.Contains(Node));
+
+    // Unknown node types run through their own Execute, assume they matter
+    bUseful |= !Node->IsA<UGWTMagicNode>() && !Node->IsA<UGWTEffectNode>() && !Node->IsA<UGWTTriggerNode>() &&
+        !Node->IsA<UGWTConditionNode>() && !Node->IsA<UGWTVariableNode>() && !Node->IsA<UGWTFlowNode>();
+
+    if (!bUseful)
+    {
+        TArray<UGWTSpellNode*> Successors;
+        GetLiveSuccessors(Node, Optimization, Successors);
+        for (UGWTSpellNode* Successor : Successors)
+        {
+            if (IsUseful(Successor, Optimization, Visited))
+            {
+                bUseful = true;
+                break;
+            }
+        }
+    }
+
+    Visited.Add(Node, bUseful);
+    return bUseful;
+}
+
+bool FGWTSpellOptimizer::IsFalseCondition(const FGWTRuntimeValue& Value)
+{
+    // Mirrors UGWTFlowNode::EvaluateWhileValue without the logging
+    switch (Value.GetType())
+    {
+    case EGWTVariableType::Bool:
+        return !Value.GetBool();
+
+    case EGWTVariableType::Int:
+        return Value.GetInt() == 0;
+
+    case EGWTVariableType::Float:
+        return Value.GetFloat() == 0.0f;
+
+    default:
+        return true;
+    }
+}
\ No newline at end of file
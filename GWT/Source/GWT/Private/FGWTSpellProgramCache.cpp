@@ -0,0 +1,128 @@
+// FGWTSpellProgramCache.cpp
+// Implementation of the shared spell program cache
+
+#include "FGWTSpellProgramCache.h"
+#include "FGWTSpellSerializer.h"
+#include "UGWTSpell.h"
+#include "Serialization/MemoryWriter.h"
+
+FGWTSpellProgramCache& FGWTSpellProgramCache::Get()
+{
+    static FGWTSpellProgramCache Instance;
+    return Instance;
+}
+
+FSHAHash FGWTSpellProgramCache::ComputeStructuralHash(const UGWTSpell* Spell)
+{
+    // Same bytes as the save format minus names, titles, IDs and positions
+    TArray<uint8> Data;
+    FMemoryWriter Writer(Data);
+    FGWTSpellSerializer::WriteStructure(Writer, Spell);
+
+    FSHAHash Hash;
+    FSHA1::HashBuffer(Data.GetData(), Data.Num(), Hash.Hash);
+    return Hash;
+}
+
+EGWTSpellCompileResult FGWTSpellProgramCache::FindOrCompile(const UGWTSpell* Spell, TSharedPtr<const FGWTSpellProgram>& OutProgram)
+{
+    OutProgram.Reset();
+    if (!Spell)
+    {
+        return EGWTSpellCompileResult::EmptyGraph;
+    }
+
+    const FSHAHash Key = ComputeStructuralHash(Spell);
+
+    // Hit, hand out the shared program
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (FEntry* Entry = Entries.Find(Key))
+        {
+            Entry->LastUsed = ++UseCounter;
+            Stats.Hits++;
+            OutProgram = Entry->Program;
+            return Entry->Result;
+        }
+        Stats.Misses++;
+    }
+
+    // Compile outside the lock, it walks the spell's nodes and can take a while on big graphs
+    TSharedPtr<const FGWTSpellProgram> NewProgram;
+    const EGWTSpellCompileResult Result = FGWTSpellCompiler::Compile(Spell, NewProgram);
+
+    FScopeLock ScopeLock(&Lock);
+
+    // Another caller may have compiled the same structure meanwhile, keep the first one
+    if (FEntry* Entry = Entries.Find(Key))
+    {
+        Entry->LastUsed = ++UseCounter;
+        OutProgram = Entry->Program;
+        return Entry->Result;
+    }
+
+    FEntry& NewEntry = Entries.Add(Key);
+    NewEntry.Program = NewProgram;
+    NewEntry.Result = Result;
+    NewEntry.Size = NewProgram.IsValid() ? NewProgram->GetAllocatedSize() : 0;
+    NewEntry.LastUsed = ++UseCounter;
+    Stats.MemoryBytes += NewEntry.Size;
+
+    UE_LOG(LogTemp, Verbose, TEXT("Cached program for spell '%s' (%llu bytes), %d programs cached"),
+        *Spell->SpellName.ToString(), (uint64)NewEntry.Size, Entries.Num());
+
+    EvictToLimits();
+
+    OutProgram = NewProgram;
+    return Result;
+}
+
+void FGWTSpellProgramCache::SetLimits(int32 InMaxEntries, SIZE_T InMaxMemoryBytes)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    MaxEntries = FMath::Max(1, InMaxEntries);
+    MaxMemoryBytes = InMaxMemoryBytes;
+    EvictToLimits();
+}
+
+FGWTSpellProgramCacheStats FGWTSpellProgramCache::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+
+    FGWTSpellProgramCacheStats Result = Stats;
+    Result.NumEntries = Entries.Num();
+    return Result;
+}
+
+void FGWTSpellProgramCache::Empty()
+{
+    FScopeLock ScopeLock(&Lock);
+
+    Entries.Empty();
+    Stats.MemoryBytes = 0;
+}
+
+void FGWTSpellProgramCache::EvictToLimits()
+{
+    // Linear scan for the oldest entry, only runs when over a limit and the cache is small
+    while (Entries.Num() > 1 && (Entries.Num() > MaxEntries || Stats.MemoryBytes > MaxMemoryBytes))
+    {
+        const FSHAHash* OldestKey = nullptr;
+        uint64 OldestUse = MAX_uint64;
+        for (const TPair<FSHAHash, FEntry>& Pair : Entries)
+        {
+            if (Pair.Value.LastUsed < OldestUse)
+            {
+                OldestKey = &Pair.Key;
+                OldestUse = Pair.Value.LastUsed;
+            }
+        }
+
+        // Spells holding the program keep it alive, the cache just forgets it
+        const FSHAHash Key = *OldestKey;
+        Stats.MemoryBytes -= Entries.FindChecked(Key).Size;
+        Stats.Evictions++;
+        Entries.Remove(Key);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,470 @@
+// FGWTSpellSerializer.cpp
+// Implementation of the binary spell format
+
+#include "FGWTSpellSerializer.h"
+#include "UGWTSpell.h"
+#include "UGWTSpellNode.h"
+#include "UGWTMagicNode.h"
+#include "UGWTEffectNode.h"
+#include "UGWTTriggerNode.h"
+#include "UGWTConditionNode.h"
+#include "UGWTVariableNode.h"
+#include "UGWTFlowNode.h"
+#include "Engine/Texture2D.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "UObject/SoftObjectPath.h"
+
+void FGWTSpellSerializer::SaveSpell(const UGWTSpell* Spell, TArray<uint8>& OutData)
+{
+    OutData.Reset();
+
+    FMemoryWriter Writer(OutData);
+    WriteSpell(Writer, Spell);
+}
+
+UGWTSpell* FGWTSpellSerializer::LoadSpell(const TArray<uint8>& Data, UObject* Outer)
+{
+    // Older saves are the colon-separated text from SaveToString
+    if (!IsBinarySpell(Data))
+    {
+        FUTF8ToTCHAR Converter((const ANSICHAR*)Data.GetData(), Data.Num());
+        return UGWTSpell::LoadFromString(FString(Converter.Length(), Converter.Get()));
+    }
+
+    // No string or array in the blob can be longer than the blob itself
+    FMemoryReader Reader(Data);
+    Reader.ArMaxSerializeSize = Data.Num();
+    return ReadSpell(Reader, Outer);
+}
+
+bool FGWTSpellSerializer::IsBinarySpell(const TArray<uint8>& Data)
+{
+    uint32 Magic = 0;
+    if (Data.Num() >= (int32)sizeof(Magic))
+    {
+        FMemory::Memcpy(&Magic, Data.GetData(), sizeof(Magic));
+    }
+
+    return Magic == SpellMagic;
+}
+
+void FGWTSpellSerializer::WriteSpell(FArchive& Ar, const UGWTSpell* Spell)
+{
+    WriteSpellInternal(Ar, Spell, false);
+}
+
+void FGWTSpellSerializer::WriteStructure(FArchive& Ar, const UGWTSpell* Spell)
+{
+    WriteSpellInternal(Ar, Spell, true);
+}
+
+void FGWTSpellSerializer::WriteSpellInternal(FArchive& Ar, const UGWTSpell* Spell, bool bStructureOnly)
+{
+    check(Ar.IsSaving());
+
+    // Header
+    uint32 Magic = SpellMagic;
+    uint16 Version = CurrentVersion;
+    uint16 Flags = 0;
+    Ar << Magic << Version << Flags;
+
+    if (!bStructureOnly)
+    {
+        FString Name = Spell ? Spell->SpellName.ToString() : FString();
+        FString Description = Spell ? Spell->SpellDescription.ToString() : FString();
+        FString IconPath = Spell && Spell->SpellIcon ? Spell->SpellIcon->GetPathName() : FString();
+        Ar << Name << Description << IconPath;
+    }
+
+    // Assign table indices
+    TArray<UGWTSpellNode*> Nodes;
+    GetStructureNodes(Spell, Nodes);
+
+    TMap<const UGWTSpellNode*, int32> Indices;
+    for (int32 i = 0; i < Nodes.Num(); i++)
+    {
+        Indices.Add(Nodes[i], i);
+    }
+
+    // Node table
+    int32 NumNodes = Nodes.Num();
+    Ar << NumNodes;
+
+    for (int32 i = 0; i < NumNodes; i++)
+    {
+        UGWTSpellNode* Node = Nodes[i];
+
+        uint8 Kind = (uint8)GetNodeKind(Node);
+        Ar << Kind;
+
+        if ((ENodeKind)Kind == ENodeKind::Custom)
+        {
+            FString ClassPath = Node->GetClass()->GetPathName();
+            Ar << ClassPath;
+        }
+
+        if (!bStructureOnly)
+        {
+            FString Title = Node->NodeTitle.ToString();
+            Ar << Node->NodeID << Title << Node->NodePosition;
+        }
+
+        uint8 JoinMode = (uint8)Node->JoinMode;
+        Ar << JoinMode;
+
+        SerializeNodeParameters(Ar, Node, CurrentVersion);
+    }
+
+    // Edge table, in output order so execution order survives the round trip
+    TArray<uint16> EdgeFrom;
+    TArray<uint16> EdgeTo;
+    TArray<uint8> EdgeRoles;
+
+    for (int32 i = 0; i < NumNodes; i++)
+    {
+        UGWTSpellNode* Node = Nodes[i];
+        const UGWTConditionNode* ConditionNode = Cast<UGWTConditionNode>(Node);
+        const UGWTFlowNode* FlowNode = Cast<UGWTFlowNode>(Node);
+
+        for (UGWTSpellNode* OutputNode : Node->OutputNodes)
+        {
+            const int32* TargetIndex = Indices.Find(OutputNode);
+            if (!TargetIndex || *TargetIndex >= NumNodes)
+            {
+                continue;
+            }
+
+            uint8 Role = 0;
+            if (ConditionNode && ConditionNode->TruePathNode == OutputNode)
+            {
+                Role |= EdgeRoleTruePath;
+            }
+            if (ConditionNode && ConditionNode->FalsePathNode == OutputNode)
+            {
+                Role |= EdgeRoleFalsePath;
+            }
+            if (FlowNode && FlowNode->BodyNode == OutputNode)
+            {
+                Role |= EdgeRoleBody;
+            }
+
+            EdgeFrom.Add((uint16)i);
+            EdgeTo.Add((uint16)*TargetIndex);
+            EdgeRoles.Add(Role);
+        }
+    }
+
+    int32 NumEdges = EdgeFrom.Num();
+    Ar << NumEdges;
+    for (int32 i = 0; i < NumEdges; i++)
+    {
+        Ar << EdgeFrom[i] << EdgeTo[i] << EdgeRoles[i];
+    }
+
+    // Root list
+    TArray<uint16> Roots;
+    if (Spell)
+    {
+        for (UGWTSpellNode* RootNode : Spell->RootNodes)
+        {
+            const int32* RootIndex = Indices.Find(RootNode);
+            if (RootIndex && *RootIndex < NumNodes)
+            {
+                Roots.Add((uint16)*RootIndex);
+            }
+        }
+    }
+
+    int32 NumRoots = Roots.Num();
+    Ar << NumRoots;
+    for (uint16& RootIndex : Roots)
+    {
+        Ar << RootIndex;
+    }
+}
+
+void FGWTSpellSerializer::GetStructureNodes(const UGWTSpell* Spell, TArray<UGWTSpellNode*>& OutNodes)
+{
+    // AllNodes order, skipping empty and repeated entries, capped at what 16-bit edge indices can address
+    OutNodes.Reset();
+    if (!Spell)
+    {
+        return;
+    }
+
+    TSet<const UGWTSpellNode*> Seen;
+    for (UGWTSpellNode* Node : Spell->AllNodes)
+    {
+        bool bAlreadySeen = false;
+        if (Node)
+        {
+            Seen.Add(Node, &bAlreadySeen);
+        }
+
+        if (Node && !bAlreadySeen)
+        {
+            OutNodes.Add(Node);
+            if (OutNodes.Num() == MAX_uint16)
+            {
+                break;
+            }
+        }
+    }
+}
+
+UClass* FGWTSpellSerializer::FindNodeClass(const FString& ClassPath)
+{
+    // FindObject never loads, a path to anything not already in memory comes back null
+    UClass* NodeClass = ClassPath.IsEmpty() ? nullptr : FindObject<UClass>(nullptr, *ClassPath);
+    if (!NodeClass || !NodeClass->IsChildOf(UGWTSpellNode::StaticClass()) || NodeClass->HasAnyClassFlags(CLASS_Abstract))
+    {
+        return nullptr;
+    }
+
+    return NodeClass;
+}
+
+UGWTSpell* FGWTSpellSerializer::ReadSpell(FArchive& Ar, UObject* Outer)
+{
+    check(Ar.IsLoading());
+
+    // Header
+    uint32 Magic = 0;
+    uint16 Version = 0;
+    uint16 Flags = 0;
+    Ar << Magic << Version << Flags;
+
+    if (Ar.IsError() || Magic != SpellMagic || Version == 0 || Version > CurrentVersion)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Invalid binary spell header (version %d)"), Version);
+        return nullptr;
+    }
+
+    FString Name;
+    FString Description;
+    FString IconPath;
+    Ar << Name << Description << IconPath;
+
+    int32 NumNodes = 0;
+    Ar << NumNodes;
+    if (Ar.IsError() || NumNodes < 0 || NumNodes > MAX_uint16)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Invalid binary spell node count: %d"), NumNodes);
+        return nullptr;
+    }
+
+    UGWTSpell* NewSpell = NewObject<UGWTSpell>(Outer ? Outer : GetTransientPackage());
+    NewSpell->SpellName = FText::FromString(Name);
+    NewSpell->SpellDescription = FText::FromString(Description);
+    if (!IconPath.IsEmpty())
+    {
+        NewSpell->SpellIcon = Cast<UTexture2D>(FSoftObjectPath(IconPath).ResolveObject());
+    }
+
+    // Node table
+    TArray<UGWTSpellNode*> Nodes;
+    Nodes.Reserve(NumNodes);
+
+    for (int32 i = 0; i < NumNodes; i++)
+    {
+        uint8 Kind = 0;
+        Ar << Kind;
+
+        UClass* NodeClass = nullptr;
+        if ((ENodeKind)Kind == ENodeKind::Custom)
+        {
+            FString ClassPath;
+            Ar << ClassPath;
+            NodeClass = FindNodeClass(ClassPath);
+        }
+        else
+        {
+            NodeClass = GetNodeClass((ENodeKind)Kind);
+        }
+
+        if (Ar.IsError() || !NodeClass)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Binary spell '%s' has an unknown node type at %d"), *Name, i);
+            return nullptr;
+        }
+
+        UGWTSpellNode* Node = NewObject<UGWTSpellNode>(NewSpell, NodeClass);
+
+        FString Title;
+        uint8 JoinMode = 0;
+        Ar << Node->NodeID << Title << Node->NodePosition << JoinMode;
+        Node->NodeTitle = FText::FromString(Title);
+        Node->JoinMode = (EGWTJoinMode)JoinMode;
+        Node->OwningSpell = NewSpell;
+
+        SerializeNodeParameters(Ar, Node, Version);
+        Nodes.Add(Node);
+    }
+
+    // Edge table, each entry is 5 bytes so the count can be checked against what is left
+    int32 NumEdges = 0;
+    Ar << NumEdges;
+    if (Ar.IsError() || NumEdges < 0 || NumEdges > (Ar.TotalSize() - Ar.Tell()) / 5)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Binary spell '%s' has an invalid edge table"), *Name);
+        return nullptr;
+    }
+
+    for (int32 i = 0; i < NumEdges; i++)
+    {
+        uint16 From = 0;
+        uint16 To = 0;
+        uint8 Role = 0;
+        Ar << From << To << Role;
+
+        if (From >= NumNodes || To >= NumNodes || From == To)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Binary spell '%s' has an invalid edge %d -> %d"), *Name, From, To);
+            return nullptr;
+        }
+
+        // Wire both directions directly, the table is already known to be consistent
+        UGWTSpellNode* FromNode = Nodes[From];
+        UGWTSpellNode* ToNode = Nodes[To];
+        FromNode->OutputNodes.Add(ToNode);
+        ToNode->InputNodes.AddUnique(FromNode);
+
+        if (UGWTConditionNode* ConditionNode = Cast<UGWTConditionNode>(FromNode))
+        {
+            if (Role & EdgeRoleTruePath)
+            {
+                ConditionNode->TruePathNode = ToNode;
+            }
+            if (Role & EdgeRoleFalsePath)
+            {
+                ConditionNode->FalsePathNode = ToNode;
+            }
+        }
+        if (UGWTFlowNode* FlowNode = Cast<UGWTFlowNode>(FromNode))
+        {
+            if (Role & EdgeRoleBody)
+            {
+                FlowNode->BodyNode = ToNode;
+            }
+        }
+    }
+
+    // Root list
+    int32 NumRoots = 0;
+    Ar << NumRoots;
+    if (Ar.IsError() || NumRoots < 0 || NumRoots > NumNodes)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Binary spell '%s' has an invalid root list"), *Name);
+        return nullptr;
+    }
+
+    for (int32 i = 0; i < NumRoots; i++)
+    {
+        uint16 RootIndex = 0;
+        Ar << RootIndex;
+        if (RootIndex < NumNodes)
+        {
+            NewSpell->RootNodes.AddUnique(Nodes[RootIndex]);
+        }
+    }
+
+    if (Ar.IsError())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Binary spell '%s' is truncated"), *Name);
+        return nullptr;
+    }
+
+    NewSpell->AllNodes = MoveTemp(Nodes);
+    NewSpell->MarkGraphChanged();
+
+    UE_LOG(LogTemp, Verbose, TEXT("Loaded binary spell '%s': %d nodes, %d connections"), *Name, NumNodes, NumEdges);
+
+    return NewSpell;
+}
+
+FGWTSpellSerializer::ENodeKind FGWTSpellSerializer::GetNodeKind(const UGWTSpellNode* Node)
+{
+    // Only the exact native classes get a tag, subclasses are stored by path
+    const UClass* NodeClass = Node->GetClass();
+
+    for (uint8 Kind = (uint8)ENodeKind::Magic; Kind <= (uint8)ENodeKind::Flow; Kind++)
+    {
+        if (NodeClass == GetNodeClass((ENodeKind)Kind))
+        {
+            return (ENodeKind)Kind;
+        }
+    }
+
+    return ENodeKind::Custom;
+}
+
+UClass* FGWTSpellSerializer::GetNodeClass(ENodeKind Kind)
+{
+    switch (Kind)
+    {
+    case ENodeKind::Magic: return UGWTMagicNode::StaticClass();
+    case ENodeKind::Effect: return UGWTEffectNode::StaticClass();
+    case ENodeKind::Trigger: return UGWTTriggerNode::StaticClass();
+    case ENodeKind::Condition: return UGWTConditionNode::StaticClass();
+    case ENodeKind::Variable: return UGWTVariableNode::StaticClass();
+    case ENodeKind::Flow: return UGWTFlowNode::StaticClass();
+    default: return nullptr;
+    }
+}
+
+void FGWTSpellSerializer::SerializeNodeParameters(FArchive& Ar, UGWTSpellNode* Node, uint16 Version)
+{
+    // Enums go through a byte so the layout does not depend on the compiler
+    if (UGWTMagicNode* MagicNode = Cast<UGWTMagicNode>(Node))
+    {
+        uint8 Element = (uint8)MagicNode->ElementType;
+        Ar << MagicNode->BaseDamage << MagicNode->Range << MagicNode->CastTime << MagicNode->ManaCost << Element;
+        MagicNode->ElementType = (EGWTElementType)Element;
+    }
+    else if (UGWTEffectNode* EffectNode = Cast<UGWTEffectNode>(Node))
+    {
+        uint8 EffectType = (uint8)EffectNode->EffectType;
+        uint8 Element = (uint8)EffectNode->ElementType;
+        Ar << EffectType << EffectNode->EffectValue << EffectNode->EffectDuration << Element;
+        EffectNode->EffectType = (EGWTEffectType)EffectType;
+        EffectNode->ElementType = (EGWTElementType)Element;
+    }
+    else if (UGWTTriggerNode* TriggerNode = Cast<UGWTTriggerNode>(Node))
+    {
+        uint8 TriggerType = (uint8)TriggerNode->TriggerType;
+        Ar << TriggerType << TriggerNode->TriggerValue;
+        TriggerNode->TriggerType = (EGWTTriggerType)TriggerType;
+    }
+    else if (UGWTConditionNode* ConditionNode = Cast<UGWTConditionNode>(Node))
+    {
+        uint8 ConditionType = (uint8)ConditionNode->ConditionType;
+        Ar << ConditionType << ConditionNode->ComparisonValue;
+        ConditionNode->ConditionType = (EGWTConditionType)ConditionType;
+    }
+    else if (UGWTVariableNode* VariableNode = Cast<UGWTVariableNode>(Node))
+    {
+        // Names travel as strings so blobs do not depend on the name table
+        FString VariableName = VariableNode->VariableName.ToString();
+        uint8 VariableType = (uint8)VariableNode->VariableType;
+        uint8 Operation = (uint8)VariableNode->Operation;
+        Ar << VariableName << VariableType << Operation;
+        VariableNode->VariableName = FName(*VariableName);
+        VariableNode->VariableType = (EGWTVariableType)VariableType;
+        VariableNode->Operation = (UGWTVariableNode::EVariableOperation)Operation;
+
+        // Default value, actor targets are runtime only and are not saved
+        FGWTVariableValue& Value = VariableNode->DefaultValue;
+        uint8 ValueType = (uint8)Value.Type;
+        Ar << ValueType << Value.FloatValue << Value.IntValue << Value.BoolValue << Value.VectorValue;
+        Value.Type = (EGWTVariableType)ValueType;
+    }
+    else if (UGWTFlowNode* FlowNode = Cast<UGWTFlowNode>(Node))
+    {
+        FString ConditionVariableName = FlowNode->ConditionVariableName.ToString();
+        uint8 FlowType = (uint8)FlowNode->FlowType;
+        Ar << FlowType << FlowNode->IterationCount << FlowNode->TimeLimit << ConditionVariableName;
+        FlowNode->FlowType = (EGWTFlowType)FlowType;
+        FlowNode->ConditionVariableName = FName(*ConditionVariableName);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,410 @@
+// FGWTSpellVM.cpp
+// Implementation of the spell program interpreter
+
+#include "FGWTSpellVM.h"
+#include "UGWTSpellExecutionContext.h"
+#include "UGWTMagicNode.h"
+#include "UGWTEffectNode.h"
+#include "UGWTTriggerNode.h"
+#include "UGWTConditionNode.h"
+#include "UGWTVariableNode.h"
+#include "UGWTFlowNode.h"
+#include "Async/ParallelFor.h"
+
+EGWTSpellRunResult FGWTSpellVM::Run(FGWTSpellTask& Task, double CurrentTime, bool bAllowSuspend)
+{
+    UGWTSpellExecutionContext* Context = Task.Context;
+    if (!Context || !Task.Program.IsValid() || !Task.Program->IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Spell VM: Invalid program or context"));
+        return EGWTSpellRunResult::Failed;
+    }
+
+    const FGWTSpellProgram& Program = *Task.Program;
+
+    // First slice: variables live in dense slots for the duration of the program
+    if (Task.PC == INDEX_NONE)
+    {
+        Context->BindVariableSlots(Program.SlotNames);
+        Task.JoinCounters.SetNumZeroed(Program.NumJoinCounters);
+        Task.MemoEntries.SetNum(Program.NumMemoSlots);
+        Task.PC = Task.EntryPC;
+    }
+
+    const FGWTSpellInstruction* Instructions = Program.Instructions.GetData();
+    const int32 NumInstructions = Program.Instructions.Num();
+    int32 PC = Task.PC;
+    int32 LoopIterations = 0;
+
+    // Yield helper, ResumePC is where the task picks up next time
+    // The slice's effects land before the wait, and the world moves on meanwhile, so cached checks are stale afterwards
+    auto Suspend = [&Task, Context](int32 ResumePC, double ResumeTime)
+    {
+        if (!Task.bDeferPayloads)
+        {
+            Context->EffectCommands.Flush();
+        }
+        else
+        {
+            check(Context->EffectCommands.Num() == 0);
+        }
+        Task.PC = ResumePC;
+        Task.MemoEpoch++;
+        Task.ResumeTime = ResumeTime;
+        return EGWTSpellRunResult::Suspended;
+    };
+
+    // Payload budget, counted across all sibling tasks of a parallel cast
+    auto ExceedsEffectLimit = [&Task]()
+    {
+        ++Task.EffectsApplied;
+        const int32 Total = Task.SharedMeter.IsValid() ? Task.SharedMeter->EffectsApplied.fetch_add(1) + 1 : Task.EffectsApplied;
+        return Total > Task.Limits.MaxEffects;
+    };
+
+    while (PC >= 0 && PC < NumInstructions)
+    {
+        const FGWTSpellInstruction& Op = Instructions[PC++];
+
+        // Every instruction counts against the cast's lifetime budget, siblings report to the shared meter in batches
+        if (++Task.OpsExecuted > Task.Limits.MaxOps || (Task.SharedMeter.IsValid() && Task.OpsExecuted % SharedMeterBatch == 0 &&
+            Task.SharedMeter->OpsExecuted.fetch_add(SharedMeterBatch) + SharedMeterBatch > Task.Limits.MaxOps))
+        {
+            return Abort(Task, EGWTSpellAbortReason::OpBudget, Op.NodeIndex);
+        }
+
+        // Loop heads count against the per-slice budget, re-running the head on resume
+        if (bAllowSuspend && (Op.OpCode == EGWTSpellOpCode::RepeatNext || Op.OpCode == EGWTSpellOpCode::ForEachNext ||
+            Op.OpCode == EGWTSpellOpCode::WhileNext) && ++LoopIterations > LoopIterationsPerSlice)
+        {
+            return Suspend(PC - 1, CurrentTime);
+        }
+
+        switch (Op.OpCode)
+        {
+        case EGWTSpellOpCode::Magic:
+            if (ExceedsEffectLimit())
+            {
+                return Abort(Task, EGWTSpellAbortReason::EffectLimit, Op.NodeIndex);
+            }
+            if (Task.bDeferPayloads)
+            {
+                // Same outcome as applying it, without touching the world
+                if (!UGWTMagicNode::CanApplyMagic(Context, Op.ValueB))
+                {
+                    PC = Op.Jump;
+                    break;
+                }
+                Task.DeferredPayloads.Add(PC - 1);
+                break;
+            }
+            check(!Task.bDeferPayloads);
+            if (!UGWTMagicNode::ApplyMagic(Context, (EGWTElementType)Op.SubType, Op.ValueA, Op.ValueB))
+            {
+                PC = Op.Jump;
+                break;
+            }
+            Task.MemoEpoch++;
+            break;
+
+        case EGWTSpellOpCode::Effect:
+            if (ExceedsEffectLimit())
+            {
+                return Abort(Task, EGWTSpellAbortReason::EffectLimit, Op.NodeIndex);
+            }
+            if (Task.bDeferPayloads)
+            {
+                if (!UGWTEffectNode::CanApplyEffectPayload(Context))
+                {
+                    PC = Op.Jump;
+                    break;
+                }
+                Task.DeferredPayloads.Add(PC - 1);
+                break;
+            }
+            check(!Task.bDeferPayloads);
+            if (!UGWTEffectNode::ApplyEffectPayload(Context, (EGWTEffectType)Op.SubType,
+                (EGWTElementType)Op.Aux, Op.ValueA, Op.ValueB))
+            {
+                PC = Op.Jump;
+                break;
+            }
+            Task.MemoEpoch++;
+            break;
+
+        case EGWTSpellOpCode::Trigger:
+            if (!UGWTTriggerNode::EvaluateTrigger(Context, (EGWTTriggerType)Op.SubType, Op.ValueA))
+            {
+                PC = Op.Jump;
+            }
+            break;
+
+        case EGWTSpellOpCode::Branch:
+        {
+            // Pure checks reuse their last result until a payload lands or the cast yields
+            bool bResult;
+            if (Op.Arg != INDEX_NONE && Task.MemoEntries[Op.Arg].Epoch == Task.MemoEpoch)
+            {
+                bResult = Task.MemoEntries[Op.Arg].bResult;
+            }
+            else
+            {
+                // Random rolls are keyed by node and loop position, so they never depend on evaluation order
+                if ((EGWTConditionType)Op.SubType == EGWTConditionType::RandomChance)
+                {
+                    uint32 RandomNode = Op.NodeIndex;
+                    for (const FGWTSpellLoopFrame& Frame : Task.LoopStack)
+                    {
+                        RandomNode = HashCombineFast(RandomNode, (uint32)Frame.Index);
+                    }
+                    Context->RandomNode = RandomNode;
+                }
+
+                bResult = UGWTConditionNode::EvaluateConditionType(Context, (EGWTConditionType)Op.SubType, Op.ValueA);
+                if (Op.Arg != INDEX_NONE)
+                {
+                    Task.MemoEntries[Op.Arg].Epoch = Task.MemoEpoch;
+                    Task.MemoEntries[Op.Arg].bResult = bResult;
+                }
+            }
+
+            if (!bResult)
+            {
+                PC = Op.Jump;
+            }
+            break;
+        }
+
+        case EGWTSpellOpCode::Variable:
+            UGWTVariableNode::ApplyVariableOperationToSlot(Context, Op.Arg, Program.SlotNames[Op.Arg],
+                (UGWTVariableNode::EVariableOperation)Op.SubType, Program.Constants[Op.Aux]);
+            break;
+
+        case EGWTSpellOpCode::Wait:
+            // Delays and cast times hand control back to the scheduler
+            if (bAllowSuspend && Op.ValueA > 0.0f)
+            {
+                UE_LOG(LogTemp, Verbose, TEXT("Spell VM: Waiting %.2f seconds"), Op.ValueA);
+                return Suspend(PC, CurrentTime + Op.ValueA);
+            }
+            break;
+
+        case EGWTSpellOpCode::LoopBegin:
+        {
+            FGWTSpellLoopFrame Loop;
+            Loop.Count = Op.Arg;
+            Task.LoopStack.Add(Loop);
+            break;
+        }
+
+        case EGWTSpellOpCode::RepeatNext:
+        {
+            FGWTSpellLoopFrame& Loop = Task.LoopStack.Last();
+            if (Loop.Index >= Loop.Count)
+            {
+                Task.LoopStack.Pop(false);
+                PC = Op.Jump;
+                break;
+            }
+
+            UE_LOG(LogTemp, Verbose, TEXT("Repeat iteration %d/%d"), Loop.Index + 1, Loop.Count);
+            Loop.Index++;
+            break;
+        }
+
+        case EGWTSpellOpCode::ForEachNext:
+        {
+            FGWTSpellLoopFrame& Loop = Task.LoopStack.Last();
+            if (Loop.Index >= Loop.Count)
+            {
+                Task.LoopStack.Pop(false);
+                PC = Op.Jump;
+                break;
+            }
+
+            // Publish the iteration index to the body
+            Context->SetSlot(Op.Arg, FGWTRuntimeValue::MakeInt(Loop.Index));
+
+            Loop.Index++;
+            break;
+        }
+
+        case EGWTSpellOpCode::WhileNext:
+        {
+            FGWTSpellLoopFrame& Loop = Task.LoopStack.Last();
+            if (!UGWTFlowNode::EvaluateWhileValue(Context->FindSlot(Op.Arg), Program.SlotNames[Op.Arg]))
+            {
+                Task.LoopStack.Pop(false);
+                PC = Op.Jump;
+                break;
+            }
+
+            // Same safety limit as the node-based while loop
+            if (Loop.Index >= Loop.Count)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("While loop reached iteration limit"));
+                Task.LoopStack.Pop(false);
+                PC = Op.Jump;
+                break;
+            }
+
+            Loop.Index++;
+            break;
+        }
+
+        case EGWTSpellOpCode::Jump:
+            PC = Op.Jump;
+            break;
+
+        case EGWTSpellOpCode::Call:
+            if (Task.CallStack.Num() >= Task.Limits.MaxCallDepth)
+            {
+                return Abort(Task, EGWTSpellAbortReason::CallDepth, Op.NodeIndex);
+            }
+            Task.CallStack.Push(PC);
+            PC = Op.Jump;
+            break;
+
+        case EGWTSpellOpCode::Return:
+            // Returning from the entry region ends the program
+            if (Task.CallStack.Num() == 0)
+            {
+                Task.PC = PC;
+                return EGWTSpellRunResult::Finished;
+            }
+            PC = Task.CallStack.Pop(false);
+            break;
+
+        case EGWTSpellOpCode::RegionBegin:
+            // Each entry into a region (every loop iteration) starts with no pending activations
+            FMemory::Memzero(Task.JoinCounters.GetData() + Op.Arg, Op.Aux * sizeof(int32));
+            break;
+
+        case EGWTSpellOpCode::Activate:
+        {
+            int32& Pending = Task.JoinCounters[Op.Arg];
+            Pending = FMath::Min(Pending + 1, MAX_int32 - 1);
+            break;
+        }
+
+        case EGWTSpellOpCode::TakeActivation:
+        {
+            int32& Pending = Task.JoinCounters[Op.Arg];
+            if (Pending <= 0)
+            {
+                PC = Op.Jump;
+                break;
+            }
+
+            // Once fires a single time however many inputs reached it, PerActivation fires once per input
+            Pending = (EGWTJoinMode)Op.SubType == EGWTJoinMode::Once ? 0 : Pending - 1;
+            break;
+        }
+
+        default:
+            UE_LOG(LogTemp, Warning, TEXT("Spell VM: Unknown opcode %d at %d"), (int32)Op.OpCode, PC - 1);
+            return EGWTSpellRunResult::Failed;
+        }
+    }
+
+    // Only a malformed program can run off the end of the instruction stream
+    UE_LOG(LogTemp, Warning, TEXT("Spell VM: Program counter out of range (%d)"), PC);
+    return EGWTSpellRunResult::Failed;
+}
+
+void FGWTSpellVM::RunSiblings(TArrayView<FGWTSpellTask*> Tasks, double CurrentTime, bool bAllowSuspend, TArray<EGWTSpellRunResult, TInlineAllocator<8>>& OutResults)
+{
+    OutResults.SetNum(Tasks.Num());
+
+    // Small programs finish faster on this thread, siblings never touch each other's state so order does not matter
+    const bool bParallel = Tasks.Num() > 1 && Tasks[0]->Program.IsValid() &&
+        Tasks[0]->Program->Instructions.Num() >= MinParallelInstructions;
+    if (!bParallel)
+    {
+        for (int32 i = 0; i < Tasks.Num(); i++)
+        {
+            OutResults[i] = Run(*Tasks[i], CurrentTime, bAllowSuspend);
+        }
+        return;
+    }
+
+    // Workers read a copy of the world taken here and never write it, every write waits for the commit below
+    for (FGWTSpellTask* Task : Tasks)
+    {
+        Task->bDeferPayloads = true;
+        Task->Context->CaptureWorld(Task->WorldSnapshot);
+        Task->Context->WorldSnapshot = &Task->WorldSnapshot;
+    }
+
+    ParallelFor(Tasks.Num(), [&](int32 Index)
+    {
+        OutResults[Index] = Run(*Tasks[Index], CurrentTime, bAllowSuspend);
+    });
+
+    // Commit in task order so the outcome never depends on which worker finished first
+    for (FGWTSpellTask* Task : Tasks)
+    {
+        Task->bDeferPayloads = false;
+        Task->Context->WorldSnapshot = nullptr;
+        CommitDeferredPayloads(*Task);
+    }
+}
+
+void FGWTSpellVM::CommitDeferredPayloads(FGWTSpellTask& Task)
+{
+    check(IsInGameThread() && !Task.bDeferPayloads);
+
+    if (Task.DeferredPayloads.Num() == 0)
+    {
+        return;
+    }
+
+    const FGWTSpellProgram& Program = *Task.Program;
+    for (int32 OpIndex : Task.DeferredPayloads)
+    {
+        const FGWTSpellInstruction& Op = Program.Instructions[OpIndex];
+        if (Op.OpCode == EGWTSpellOpCode::Magic)
+        {
+            UGWTMagicNode::ApplyMagic(Task.Context, (EGWTElementType)Op.SubType, Op.ValueA, Op.ValueB);
+        }
+        else
+        {
+            UGWTEffectNode::ApplyEffectPayload(Task.Context, (EGWTEffectType)Op.SubType,
+                (EGWTElementType)Op.Aux, Op.ValueA, Op.ValueB);
+        }
+    }
+
+    Task.DeferredPayloads.Reset();
+    Task.Context->EffectCommands.Flush();
+
+    // The world changed under the task's cached checks
+    Task.MemoEpoch++;
+}
+
+const TCHAR* FGWTSpellVM::GetAbortReasonString(EGWTSpellAbortReason Reason)
+{
+    switch (Reason)
+    {
+    case EGWTSpellAbortReason::OpBudget: return TEXT("instruction budget exceeded");
+    case EGWTSpellAbortReason::EffectLimit: return TEXT("too many effects");
+    case EGWTSpellAbortReason::CallDepth: return TEXT("nesting too deep");
+    default: return TEXT("none");
+    }
+}
+
+EGWTSpellRunResult FGWTSpellVM::Abort(FGWTSpellTask& Task, EGWTSpellAbortReason Reason, int32 NodeIndex)
+{
+    Task.AbortReason = Reason;
+    Task.AbortNodeIndex = NodeIndex;
+
+    // Name the node so players can find it in the editor, using the casting spell's own nodes
+    const FGWTSpellDiagnostics* Diagnostics = Task.Diagnostics.Get();
+    const bool bKnownNode = Diagnostics && Diagnostics->NodeIDs.IsValidIndex(NodeIndex);
+    UE_LOG(LogTemp, Warning, TEXT("Spell aborted (%s) at node '%s' [%s] after %d instructions, %d effects"),
+        GetAbortReasonString(Reason),
+        bKnownNode ? *Diagnostics->NodeTitles[NodeIndex] : TEXT("entry"),
+        bKnownNode ? *Diagnostics->NodeIDs[NodeIndex].ToString() : TEXT("-"),
+        Task.OpsExecuted, Task.EffectsApplied);
+
+    return EGWTSpellRunResult::Aborted;
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+// UGWTActorPool.cpp
+// Implementation of the actor pool
+
+#include "UGWTActorPool.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+void UGWTActorPool::Deinitialize()
+{
+    for (const TPair<UClass*, FClassPool>& Pair : Pools)
+    {
+        const FGWTActorPoolStats& Stats = Pair.Value.Stats;
+        UE_LOG(LogTemp, Display, TEXT("Actor pool %s: %d acquires, %.0f%% hits, high-water mark %d"),
+            *GetNameSafe(Pair.Key), Stats.NumAcquires, Stats.GetHitRate() * 100.0f, Stats.HighWaterMark);
+    }
+
+    Pools.Empty();
+    InUseActors.Empty();
+    AllActors.Empty();
+
+    Super::Deinitialize();
+}
+
+int32 UGWTActorPool::Prewarm(UClass* Class, int32 Count, int32 MaxSpawns)
+{
+    if (!Class)
+    {
+        return 0;
+    }
+
+    FClassPool& Pool = Pools.FindOrAdd(Class);
+    PruneFreeActors(Pool);
+
+    const int32 NumToSpawn = FMath::Min(Count - Pool.Stats.NumInUse - Pool.FreeActors.Num(), MaxSpawns);
+    const FTransform Parking(FVector(0.0f, 0.0f, ParkingHeight));
+
+    int32 NumSpawned = 0;
+    for (; NumSpawned < NumToSpawn; NumSpawned++)
+    {
+        AActor* Actor = SpawnInstance(Class, Parking);
+        if (!Actor)
+        {
+            break;
+        }
+
+        // Spawned live so BeginPlay does its setup now, then straight onto the shelf
+        if (IGWTPooledActor* Pooled = Cast<IGWTPooledActor>(Actor))
+        {
+            Pooled->OnReleasedToPool();
+        }
+
+        Park(Actor);
+        Pool.FreeActors.Add(Actor);
+    }
+
+    Pool.Stats.NumFree = Pool.FreeActors.Num();
+
+    if (NumSpawned > 0)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Actor pool pre-warmed %d %s, %d free"),
+            NumSpawned, *Class->GetName(), Pool.Stats.NumFree);
+    }
+
+    return NumSpawned;
+}
+
+AActor* UGWTActorPool::Acquire(UClass* Class, const FTransform& Transform)
+{
+    if (!Class)
+    {
+        return nullptr;
+    }
+
+    FClassPool& Pool = Pools.FindOrAdd(Class);
+    PruneFreeActors(Pool);
+    Pool.Stats.NumAcquires++;
+
+    AActor* Actor = Pool.FreeActors.Num() > 0 ? Pool.FreeActors.Pop(false).Get() : nullptr;
+    if (Actor)
+    {
+        Pool.Stats.NumHits++;
+
+        // Back into the world where it was asked for
+        Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+        Actor->SetActorHiddenInGame(false);
+        Actor->SetActorEnableCollision(true);
+        Actor->SetActorTickEnabled(true);
+
+        if (IGWTPooledActor* Pooled = Cast<IGWTPooledActor>(Actor))
+        {
+            Pooled->OnAcquiredFromPool();
+        }
+    }
+    else
+    {
+        // A miss, a fresh instance needs nothing undone
+        Actor = SpawnInstance(Class, Transform);
+        if (!Actor)
+        {
+            return nullptr;
+        }
+
+        UE_LOG(LogTemp, Verbose, TEXT("Actor pool miss for %s"), *Class->GetName());
+    }
+
+    InUseActors.Add(FObjectKey(Actor));
+    Pool.Stats.NumInUse++;
+    Pool.Stats.HighWaterMark = FMath::Max(Pool.Stats.HighWaterMark, Pool.Stats.NumInUse);
+    Pool.Stats.NumFree = Pool.FreeActors.Num();
+
+    return Actor;
+}
+
+bool UGWTActorPool::Release(AActor* Actor)
+{
+    if (!Actor || InUseActors.Remove(FObjectKey(Actor)) == 0)
+    {
+        return false;
+    }
+
+    FClassPool& Pool = Pools.FindOrAdd(Actor->GetClass());
+    Pool.Stats.NumInUse--;
+
+    if (IGWTPooledActor* Pooled = Cast<IGWTPooledActor>(Actor))
+    {
+        Pooled->OnReleasedToPool();
+    }
+
+    Park(Actor);
+    Pool.FreeActors.Add(Actor);
+    Pool.Stats.NumFree = Pool.FreeActors.Num();
+
+    return true;
+}
+
+UGWTActorPool* UGWTActorPool::Get(const AActor* WorldContext)
+{
+    UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UGWTActorPool>() : nullptr;
+}
+
+FGWTActorPoolStats UGWTActorPool::GetStats(UClass* Class) const
+{
+    const FClassPool* Pool = Pools.Find(Class);
+    return Pool ? Pool->Stats : FGWTActorPoolStats();
+}
+
+FGWTActorPoolStats UGWTActorPool::GetTotalStats() const
+{
+    FGWTActorPoolStats Total;
+    for (const TPair<UClass*, FClassPool>& Pair : Pools)
+    {
+        const FGWTActorPoolStats& Stats = Pair.Value.Stats;
+        Total.NumAcquires += Stats.NumAcquires;
+        Total.NumHits += Stats.NumHits;
+        Total.NumInUse += Stats.NumInUse;
+        Total.HighWaterMark += Stats.HighWaterMark;
+        Total.NumFree += Stats.NumFree;
+    }
+
+    return Total;
+}
+
+AActor* UGWTActorPool::SpawnInstance(UClass* Class, const FTransform& Transform)
+{
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+    AActor* Actor = GetWorld()->SpawnActor<AActor>(Class, Transform, SpawnParams);
+    if (Actor)
+    {
+        AllActors.Add(Actor);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Actor pool failed to spawn %s"), *Class->GetName());
+    }
+
+    return Actor;
+}
+
+void UGWTActorPool::Park(AActor* Actor)
+{
+    Actor->SetActorHiddenInGame(true);
+    Actor->SetActorEnableCollision(false);
+    Actor->SetActorTickEnabled(false);
+    Actor->SetActorLocation(FVector(0.0f, 0.0f, ParkingHeight), false, nullptr, ETeleportType::ResetPhysics);
+}
+
+void UGWTActorPool::PruneFreeActors(FClassPool& Pool)
+{
+    Pool.FreeActors.RemoveAllSwap([](const TWeakObjectPtr<AActor>& Actor) { return !Actor.IsValid(); }, false);
+}
\ No newline at end of file
@@ -0,0 +1,267 @@
+// UGWTCharacterSpatialHash.cpp
+// Implementation of the character spatial hash
+
+#include "UGWTCharacterSpatialHash.h"
+#include "AGWTCharacter.h"
+#include "Engine/World.h"
+
+void UGWTCharacterSpatialHash::Deinitialize()
+{
+    UE_LOG(LogTemp, Verbose, TEXT("Character spatial hash shutting down: %d characters in %d cells"),
+        CharacterCells.Num(), Cells.Num());
+
+    Cells.Empty();
+    CharacterCells.Empty();
+
+    Super::Deinitialize();
+}
+
+void UGWTCharacterSpatialHash::AddCharacter(AGWTCharacter* Character)
+{
+    if (!Character || CharacterCells.Contains(Character))
+    {
+        return;
+    }
+
+    const FIntVector Cell = GetCell(Character->GetActorLocation());
+    Cells.FindOrAdd(Cell).Add(Character);
+    CharacterCells.Add(Character, Cell);
+}
+
+void UGWTCharacterSpatialHash::RemoveCharacter(AGWTCharacter* Character)
+{
+    FIntVector Cell;
+    if (CharacterCells.RemoveAndCopyValue(Character, Cell))
+    {
+        RemoveFromCell(Cell, Character);
+    }
+}
+
+void UGWTCharacterSpatialHash::UpdateCharacter(AGWTCharacter* Character)
+{
+    // Unregistered characters, such as the dead, stay out
+    FIntVector* CurrentCell = CharacterCells.Find(Character);
+    if (!CurrentCell)
+    {
+        return;
+    }
+
+    const FIntVector NewCell = GetCell(Character->GetActorLocation());
+    if (NewCell == *CurrentCell)
+    {
+        return;
+    }
+
+    RemoveFromCell(*CurrentCell, Character);
+    Cells.FindOrAdd(NewCell).Add(Character);
+    *CurrentCell = NewCell;
+}
+
+void UGWTCharacterSpatialHash::QueryRadius(const FVector& Location, float Radius, TArray<AGWTCharacter*>& OutCharacters,
+    const FGWTSpatialQueryFilter& Filter) const
+{
+    OutCharacters.Reset();
+    if (Radius < 0.0f || Cells.Num() == 0)
+    {
+        return;
+    }
+
+    const float RadiusSquared = FMath::Square(Radius);
+    const FIntVector MinCell = GetCell(Location - FVector(Radius));
+    const FIntVector MaxCell = GetCell(Location + FVector(Radius));
+
+    FCandidateArray Candidates;
+
+    // Large radii touch more cells than are occupied, then walking the occupied ones is cheaper
+    const int64 NumBoxCells = (int64)(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) * (MaxCell.Z - MinCell.Z + 1);
+    if (NumBoxCells > Cells.Num())
+    {
+        for (const TPair<FIntVector, TArray<AGWTCharacter*>>& Pair : Cells)
+        {
+            const FIntVector& Cell = Pair.Key;
+            if (Cell.X >= MinCell.X && Cell.X <= MaxCell.X && Cell.Y >= MinCell.Y && Cell.Y <= MaxCell.Y &&
+                Cell.Z >= MinCell.Z && Cell.Z <= MaxCell.Z)
+            {
+                GatherCell(Pair.Value, Location, RadiusSquared, Filter, Candidates);
+            }
+        }
+    }
+    else
+    {
+        for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+        {
+            for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+            {
+                for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+                {
+                    if (const TArray<AGWTCharacter*>* CellCharacters = Cells.Find(FIntVector(X, Y, Z)))
+                    {
+                        GatherCell(*CellCharacters, Location, RadiusSquared, Filter, Candidates);
+                    }
+                }
+            }
+        }
+    }
+
+    OutCharacters.Reserve(Candidates.Num());
+    for (const TPair<float, AGWTCharacter*>& Candidate : Candidates)
+    {
+        OutCharacters.Add(Candidate.Value);
+    }
+}
+
+void UGWTCharacterSpatialHash::QueryNearest(const FVector& Location, int32 Count, float MaxRadius, TArray<AGWTCharacter*>& OutCharacters,
+    const FGWTSpatialQueryFilter& Filter) const
+{
+    OutCharacters.Reset();
+
+    FCandidateArray Candidates;
+    GatherNearest(Location, Count, MaxRadius, Filter, Candidates);
+
+    OutCharacters.Reserve(Candidates.Num());
+    for (const TPair<float, AGWTCharacter*>& Candidate : Candidates)
+    {
+        OutCharacters.Add(Candidate.Value);
+    }
+}
+
+AGWTCharacter* UGWTCharacterSpatialHash::FindNearest(const FVector& Location, float MaxRadius, const FGWTSpatialQueryFilter& Filter) const
+{
+    FCandidateArray Candidates;
+    GatherNearest(Location, 1, MaxRadius, Filter, Candidates);
+
+    return Candidates.Num() > 0 ? Candidates[0].Value : nullptr;
+}
+
+UGWTCharacterSpatialHash* UGWTCharacterSpatialHash::Get(const AActor* WorldContext)
+{
+    UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UGWTCharacterSpatialHash>() : nullptr;
+}
+
+FIntVector UGWTCharacterSpatialHash::GetCell(const FVector& Location)
+{
+    return FIntVector(
+        FMath::FloorToInt(Location.X / CellSize),
+        FMath::FloorToInt(Location.Y / CellSize),
+        FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void UGWTCharacterSpatialHash::RemoveFromCell(const FIntVector& Cell, AGWTCharacter* Character)
+{
+    TArray<AGWTCharacter*>* CellCharacters = Cells.Find(Cell);
+    if (!CellCharacters)
+    {
+        return;
+    }
+
+    CellCharacters->RemoveSingleSwap(Character, false);
+    if (CellCharacters->Num() == 0)
+    {
+        Cells.Remove(Cell);
+    }
+}
+
+bool UGWTCharacterSpatialHash::PassesFilter(const AGWTCharacter* Character, const FGWTSpatialQueryFilter& Filter)
+{
+    if (Filter.Class && !Character->IsA(Filter.Class))
+    {
+        return false;
+    }
+
+    if (Filter.Ignored.Contains(Character))
+    {
+        return false;
+    }
+
+    return !Filter.Room || Character->CurrentRoom == Filter.Room;
+}
+
+void UGWTCharacterSpatialHash::GatherCell(const TArray<AGWTCharacter*>& CellCharacters, const FVector& Location, float RadiusSquared,
+    const FGWTSpatialQueryFilter& Filter, FCandidateArray& OutCandidates)
+{
+    for (AGWTCharacter* Character : CellCharacters)
+    {
+        const float DistanceSquared = FVector::DistSquared(Location, Character->GetActorLocation());
+        if (DistanceSquared <= RadiusSquared && PassesFilter(Character, Filter))
+        {
+            OutCandidates.Emplace(DistanceSquared, Character);
+        }
+    }
+}
+
+void UGWTCharacterSpatialHash::GatherNearest(const FVector& Location, int32 Count, float MaxRadius, const FGWTSpatialQueryFilter& Filter,
+    FCandidateArray& OutCandidates) const
+{
+    OutCandidates.Reset();
+    if (Count <= 0 || MaxRadius < 0.0f || Cells.Num() == 0)
+    {
+        return;
+    }
+
+    const float MaxRadiusSquared = FMath::Square(MaxRadius);
+    const FIntVector Center = GetCell(Location);
+
+    auto ByDistance = [](const TPair<float, AGWTCharacter*>& A, const TPair<float, AGWTCharacter*>& B)
+    {
+        return A.Key < B.Key;
+    };
+
+    // Search outward one shell of cells at a time, everything in shell N+1 is at least N cells away
+    for (int32 Ring = 0; ; Ring++)
+    {
+        // Once a shell holds more cells than are occupied, finish with one pass over the occupied ones
+        const int64 Side = 2 * Ring + 1;
+        const int64 NumShellCells = Ring == 0 ? 1 : Side * Side * Side - (Side - 2) * (Side - 2) * (Side - 2);
+        if (NumShellCells > Cells.Num())
+        {
+            for (const TPair<FIntVector, TArray<AGWTCharacter*>>& Pair : Cells)
+            {
+                const FIntVector Offset = Pair.Key - Center;
+                if (FMath::Max3(FMath::Abs(Offset.X), FMath::Abs(Offset.Y), FMath::Abs(Offset.Z)) >= Ring)
+                {
+                    GatherCell(Pair.Value, Location, MaxRadiusSquared, Filter, OutCandidates);
+                }
+            }
+            break;
+        }
+
+        for (int32 X = -Ring; X <= Ring; X++)
+        {
+            for (int32 Y = -Ring; Y <= Ring; Y++)
+            {
+                // Inside the shell's X and Y faces only the top and bottom cells belong to it
+                const bool bOnSide = FMath::Abs(X) == Ring || FMath::Abs(Y) == Ring;
+                const int32 StepZ = bOnSide ? 1 : 2 * Ring;
+                for (int32 Z = -Ring; Z <= Ring; Z += StepZ)
+                {
+                    if (const TArray<AGWTCharacter*>* CellCharacters = Cells.Find(Center + FIntVector(X, Y, Z)))
+                    {
+                        GatherCell(*CellCharacters, Location, MaxRadiusSquared, Filter, OutCandidates);
+                    }
+                }
+            }
+        }
+
+        // The next shell is out of range, or cannot beat what has been found
+        const float ReachedDistance = Ring * CellSize;
+        if (ReachedDistance >= MaxRadius)
+        {
+            break;
+        }
+        if (OutCandidates.Num() >= Count)
+        {
+            OutCandidates.Sort(ByDistance);
+            if (OutCandidates[Count - 1].Key <= FMath::Square(ReachedDistance))
+            {
+                break;
+            }
+        }
+    }
+
+    OutCandidates.Sort(ByDistance);
+    if (OutCandidates.Num() > Count)
+    {
+        OutCandidates.SetNum(Count, false);
+    }
+}
\ No newline at end of file
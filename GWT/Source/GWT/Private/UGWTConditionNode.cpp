@@ -4,9 +4,16 @@
 #include "UGWTConditionNode.h"
 #include "UGWTSpellExecutionContext.h"
 #include "AGWTCharacter.h"
+#include "UGWTRandomService.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 
+// Checks look at the target, or the caster when there is none
+static FGWTSpellActorState ReadCheckedActor(const UGWTSpellExecutionContext* Context)
+{
+    return Context->ReadActor(Context->Target ? EGWTSpellActor::Target : EGWTSpellActor::Caster);
+}
+
 UGWTConditionNode::UGWTConditionNode()
 {
     // Set node identity
@@ -36,6 +43,9 @@ void UGWTConditionNode::Execute(UGWTSpellExecutionContext* Context)
         return;
     }
 
+    // Random rolls are keyed by node, the node graph has no loop indices to add
+    Context->RandomNode = GetTypeHash(NodeID);
+
     // Evaluate the condition and follow appropriate path
     bool bConditionResult = EvaluateCondition(Context);
 
@@ -125,6 +135,7 @@ void UGWTConditionNode::SetTruePath(UGWTSpellNode* Node)
 
     // Set as true path
     TruePathNode = Node;
+    MarkModified();
 
     UE_LOG(LogTemp, Verbose, TEXT("Set true path to node: %s"),
         Node ? *Node->NodeTitle.ToString() : TEXT("None"));
@@ -140,6 +151,7 @@ void UGWTConditionNode::SetFalsePath(UGWTSpellNode* Node)
 
     // Set as false path
     FalsePathNode = Node;
+    MarkModified();
 
     UE_LOG(LogTemp, Verbose, TEXT("Set false path to node: %s"),
         Node ? *Node->NodeTitle.ToString() : TEXT("None"));
@@ -147,26 +159,37 @@ void UGWTConditionNode::SetFalsePath(UGWTSpellNode* Node)
 
 bool UGWTConditionNode::EvaluateCondition(UGWTSpellExecutionContext* Context)
 {
+    return EvaluateConditionType(Context, ConditionType, ComparisonValue);
+}
+
+bool UGWTConditionNode::EvaluateConditionType(UGWTSpellExecutionContext* Context, EGWTConditionType InConditionType, float InComparisonValue)
+{
+    // Checks read the world, so effects queued earlier in the cast land first
+    if (InConditionType != EGWTConditionType::RandomChance)
+    {
+        Context->FlushBeforeRead();
+    }
+
     // Evaluate based on condition type
-    switch (ConditionType)
+    switch (InConditionType)
     {
     case EGWTConditionType::HealthCheck:
-        return EvaluateHealthCheck(Context);
+        return EvaluateHealthCheck(Context, InComparisonValue);
 
     case EGWTConditionType::ManaCheck:
-        return EvaluateManaCheck(Context);
+        return EvaluateManaCheck(Context, InComparisonValue);
 
     case EGWTConditionType::DistanceCheck:
-        return EvaluateDistanceCheck(Context);
+        return EvaluateDistanceCheck(Context, InComparisonValue);
 
     case EGWTConditionType::ElementalCheck:
-        return EvaluateElementalCheck(Context);
+        return EvaluateElementalCheck(Context, InComparisonValue);
 
     case EGWTConditionType::StatusEffectCheck:
-        return EvaluateStatusEffectCheck(Context);
+        return EvaluateStatusEffectCheck(Context, InComparisonValue);
 
     case EGWTConditionType::RandomChance:
-        return EvaluateRandomChance(Context);
+        return EvaluateRandomChance(Context, InComparisonValue);
 
     default:
         UE_LOG(LogTemp, Warning, TEXT("Unknown condition type in Condition node"));
@@ -174,22 +197,21 @@ bool UGWTConditionNode::EvaluateCondition(UGWTSpellExecutionContext* Context)
     }
 }
 
-bool UGWTConditionNode::EvaluateHealthCheck(UGWTSpellExecutionContext* Context)
+bool UGWTConditionNode::EvaluateHealthCheck(UGWTSpellExecutionContext* Context, float InComparisonValue)
 {
     // Check health percentage of target or caster
-    AActor* TargetActor = Context->Target ? Context->Target : Context->Caster;
-    AGWTCharacter* TargetCharacter = Cast<AGWTCharacter>(TargetActor);
+    const FGWTSpellActorState TargetState = ReadCheckedActor(Context);
 
-    if (TargetCharacter)
+    if (TargetState.bIsCharacter)
     {
         // Calculate health percentage
-        float HealthPercentage = (TargetCharacter->CurrentHealth / TargetCharacter->MaxHealth) * 100.0f;
+        float HealthPercentage = (TargetState.CurrentHealth / TargetState.MaxHealth) * 100.0f;
 
         // Compare to condition value
-        bool bResult = HealthPercentage <= ComparisonValue;
+        bool bResult = HealthPercentage <= InComparisonValue;
 
         UE_LOG(LogTemp, Verbose, TEXT("Health check: %.1f%% <= %.1f%% = %s"),
-            HealthPercentage, ComparisonValue, bResult ? TEXT("True") : TEXT("False"));
+            HealthPercentage, InComparisonValue, bResult ? TEXT("True") : TEXT("False"));
 
         return bResult;
     }
@@ -197,22 +219,21 @@ bool UGWTConditionNode::EvaluateHealthCheck(UGWTSpellExecutionContext* Context)
     return false;
 }
 
-bool UGWTConditionNode::EvaluateManaCheck(UGWTSpellExecutionContext* Context)
+bool UGWTConditionNode::EvaluateManaCheck(UGWTSpellExecutionContext* Context, float InComparisonValue)
 {
     // Check mana percentage of target or caster
-    AActor* TargetActor = Context->Target ? Context->Target : Context->Caster;
-    AGWTCharacter* TargetCharacter = Cast<AGWTCharacter>(TargetActor);
+    const FGWTSpellActorState TargetState = ReadCheckedActor(Context);
 
-    if (TargetCharacter)
+    if (TargetState.bIsCharacter)
     {
         // Calculate mana percentage
-        float ManaPercentage = (TargetCharacter->CurrentMana / TargetCharacter->MaxMana) * 100.0f;
+        float ManaPercentage = (TargetState.CurrentMana / TargetState.MaxMana) * 100.0f;
 
         // Compare to condition value
-        bool bResult = ManaPercentage >= ComparisonValue;
+        bool bResult = ManaPercentage >= InComparisonValue;
 
         UE_LOG(LogTemp, Verbose, TEXT("Mana check: %.1f%% >= %.1f%% = %s"),
-            ManaPercentage, ComparisonValue, bResult ? TEXT("True") : TEXT("False"));
+            ManaPercentage, InComparisonValue, bResult ? TEXT("True") : TEXT("False"));
 
         return bResult;
     }
@@ -220,19 +241,21 @@ bool UGWTConditionNode::EvaluateManaCheck(UGWTSpellExecutionContext* Context)
     return false;
 }
 
-bool UGWTConditionNode::EvaluateDistanceCheck(UGWTSpellExecutionContext* Context)
+bool UGWTConditionNode::EvaluateDistanceCheck(UGWTSpellExecutionContext* Context, float InComparisonValue)
 {
     // Check distance between caster and target
-    if (Context->Caster && Context->Target)
+    const FGWTSpellActorState CasterState = Context->ReadActor(EGWTSpellActor::Caster);
+    const FGWTSpellActorState TargetState = Context->ReadActor(EGWTSpellActor::Target);
+    if (CasterState.IsValid() && TargetState.IsValid())
     {
         // Calculate distance
-        float Distance = FVector::Dist(Context->Caster->GetActorLocation(), Context->Target->GetActorLocation());
+        float Distance = FVector::Dist(CasterState.Location, TargetState.Location);
 
         // Compare to condition value (in units/cm)
-        bool bResult = Distance <= ComparisonValue;
+        bool bResult = Distance <= InComparisonValue;
 
         UE_LOG(LogTemp, Verbose, TEXT("Distance check: %.1f units <= %.1f units = %s"),
-            Distance, ComparisonValue, bResult ? TEXT("True") : TEXT("False"));
+            Distance, InComparisonValue, bResult ? TEXT("True") : TEXT("False"));
 
         return bResult;
     }
@@ -240,26 +263,25 @@ bool UGWTConditionNode::EvaluateDistanceCheck(UGWTSpellExecutionContext* Context
     return false;
 }
 
-bool UGWTConditionNode::EvaluateElementalCheck(UGWTSpellExecutionContext* Context)
+bool UGWTConditionNode::EvaluateElementalCheck(UGWTSpellExecutionContext* Context, float InComparisonValue)
 {
     // Check if target is vulnerable to specific element
     // This would typically be implemented with a more complex system
     // For this example, we'll just check if they have a related status effect
 
-    AActor* TargetActor = Context->Target ? Context->Target : Context->Caster;
-    AGWTCharacter* TargetCharacter = Cast<AGWTCharacter>(TargetActor);
+    const FGWTSpellActorState TargetState = ReadCheckedActor(Context);
 
-    if (TargetCharacter)
+    if (TargetState.bIsCharacter)
     {
         // Check for elemental status effects
         bool bHasEffect = false;
 
-        for (const FGWTStatusEffect& Effect : TargetCharacter->ActiveEffects)
+        for (EGWTStatusEffectType EffectType : TargetState.StatusEffects)
         {
             // Check for relevant status effects based on element
-            if ((Effect.EffectType == EGWTStatusEffectType::Burning && ComparisonValue == (int)EGWTElementType::Fire) ||
-                (Effect.EffectType == EGWTStatusEffectType::Frozen && ComparisonValue == (int)EGWTElementType::Ice) ||
-                (Effect.EffectType == EGWTStatusEffectType::Electrified && ComparisonValue == (int)EGWTElementType::Lightning))
+            if ((EffectType == EGWTStatusEffectType::Burning && InComparisonValue == (int)EGWTElementType::Fire) ||
+                (EffectType == EGWTStatusEffectType::Frozen && InComparisonValue == (int)EGWTElementType::Ice) ||
+                (EffectType == EGWTStatusEffectType::Electrified && InComparisonValue == (int)EGWTElementType::Lightning))
             {
                 bHasEffect = true;
                 break;
@@ -267,7 +289,7 @@ bool UGWTConditionNode::EvaluateElementalCheck(UGWTSpellExecutionContext* Contex
         }
 
         UE_LOG(LogTemp, Verbose, TEXT("Elemental check for element %d: %s"),
-            (int)ComparisonValue, bHasEffect ? TEXT("True") : TEXT("False"));
+            (int)InComparisonValue, bHasEffect ? TEXT("True") : TEXT("False"));
 
         return bHasEffect;
     }
@@ -275,20 +297,19 @@ bool UGWTConditionNode::EvaluateElementalCheck(UGWTSpellExecutionContext* Contex
     return false;
 }
 
-bool UGWTConditionNode::EvaluateStatusEffectCheck(UGWTSpellExecutionContext* Context)
+bool UGWTConditionNode::EvaluateStatusEffectCheck(UGWTSpellExecutionContext* Context, float InComparisonValue)
 {
     // Check if target has a specific status effect
-    AActor* TargetActor = Context->Target ? Context->Target : Context->Caster;
-    AGWTCharacter* TargetCharacter = Cast<AGWTCharacter>(TargetActor);
+    const FGWTSpellActorState TargetState = ReadCheckedActor(Context);
 
-    if (TargetCharacter)
+    if (TargetState.bIsCharacter)
     {
         // Check for specified status effect
         bool bHasEffect = false;
 
-        for (const FGWTStatusEffect& Effect : TargetCharacter->ActiveEffects)
+        for (EGWTStatusEffectType EffectType : TargetState.StatusEffects)
         {
-            if ((int)Effect.EffectType == (int)ComparisonValue)
+            if ((int)EffectType == (int)InComparisonValue)
             {
                 bHasEffect = true;
                 break;
@@ -296,7 +317,7 @@ bool UGWTConditionNode::EvaluateStatusEffectCheck(UGWTSpellExecutionContext* Con
         }
 
         UE_LOG(LogTemp, Verbose, TEXT("Status effect check for effect %d: %s"),
-            (int)ComparisonValue, bHasEffect ? TEXT("True") : TEXT("False"));
+            (int)InComparisonValue, bHasEffect ? TEXT("True") : TEXT("False"));
 
         return bHasEffect;
     }
@@ -304,14 +325,15 @@ bool UGWTConditionNode::EvaluateStatusEffectCheck(UGWTSpellExecutionContext* Con
     return false;
 }
 
-bool UGWTConditionNode::EvaluateRandomChance(UGWTSpellExecutionContext* Context)
+bool UGWTConditionNode::EvaluateRandomChance(UGWTSpellExecutionContext* Context, float InComparisonValue)
 {
-    // Random chance based on comparison value (0-100%)
-    float RandomValue = FMath::RandRange(0.0f, 100.0f);
-    bool bResult = RandomValue <= ComparisonValue;
+    // Random chance based on comparison value (0-100%), reproducible from the match seed, cast and node
+    const FGWTRandomKey Key(EGWTRandomDomain::SpellCondition, Context->RandomStream, Context->CastID, Context->RandomNode);
+    float RandomValue = Context->RandomFRand(Key) * 100.0f;
+    bool bResult = RandomValue <= InComparisonValue;
 
     UE_LOG(LogTemp, Verbose, TEXT("Random chance: %.1f%% <= %.1f%% = %s"),
-        RandomValue, ComparisonValue, bResult ? TEXT("True") : TEXT("False"));
+        RandomValue, InComparisonValue, bResult ? TEXT("True") : TEXT("False"));
 
     return bResult;
 }
\ No newline at end of file
@@ -4,7 +4,6 @@
 #include "UGWTEffectNode.h"
 #include "UGWTSpellExecutionContext.h"
 #include "AGWTCharacter.h"
-#include "Kismet/GameplayStatics.h"
 
 UGWTEffectNode::UGWTEffectNode()
 {
@@ -26,11 +25,32 @@ UGWTEffectNode::UGWTEffectNode()
 
 void UGWTEffectNode::Execute(UGWTSpellExecutionContext* Context)
 {
+    // Apply the effect payload, stop here if there was no caster
+    if (!ApplyEffectPayload(Context, EffectType, ElementType, EffectValue, EffectDuration))
+    {
+        return;
+    }
+
+    // Execute connected nodes
+    Super::Execute(Context);
+}
+
+bool UGWTEffectNode::CanApplyEffectPayload(const UGWTSpellExecutionContext* Context)
+{
+    return Context && Context->Caster;
+}
+
+bool UGWTEffectNode::ApplyEffectPayload(UGWTSpellExecutionContext* Context, EGWTEffectType InEffectType,
+    EGWTElementType InElementType, float Value, float Duration)
+{
+    // Writes the world, never from a sibling task on a worker thread
+    check(!Context || !Context->WorldSnapshot);
+
     // Check if context is valid
-    if (!Context || !Context->Caster)
+    if (!CanApplyEffectPayload(Context))
     {
         UE_LOG(LogTemp, Warning, TEXT("Cannot execute Effect node: Invalid context or caster"));
-        return;
+        return false;
     }
 
     // Get the target from the context or use the caster's current target
@@ -45,26 +65,26 @@ void UGWTEffectNode::Execute(UGWTSpellExecutionContext* Context)
     }
 
     // Apply effect based on type
-    switch (EffectType)
+    switch (InEffectType)
     {
     case EGWTEffectType::Damage:
         if (Target)
         {
-            ApplyDamageEffect(Target, Context);
+            ApplyDamageEffect(Target, Context, InElementType, Value);
         }
         break;
 
     case EGWTEffectType::Heal:
         if (Target)
         {
-            ApplyHealEffect(Target, Context);
+            ApplyHealEffect(Target, Context, Value);
         }
         break;
 
     case EGWTEffectType::ApplyStatus:
         if (Target)
         {
-            ApplyStatusEffect(Target, Context);
+            ApplyStatusEffect(Target, Context, InElementType, Value, Duration);
         }
         break;
 
@@ -78,14 +98,14 @@ void UGWTEffectNode::Execute(UGWTSpellExecutionContext* Context)
     case EGWTEffectType::Knockback:
         if (Target)
         {
-            ApplyKnockbackEffect(Target, Context);
+            ApplyKnockbackEffect(Target, Context, Value);
         }
         break;
 
     case EGWTEffectType::Shield:
         if (Target)
         {
-            ApplyShieldEffect(Target, Context);
+            ApplyShieldEffect(Target, Context, Value, Duration);
         }
         break;
 
@@ -98,8 +118,7 @@ void UGWTEffectNode::Execute(UGWTSpellExecutionContext* Context)
         break;
     }
 
-    // Execute connected nodes
-    Super::Execute(Context);
+    return true;
 }
 
 EGWTSpellComponentType UGWTEffectNode::GetNodeType() const
@@ -112,70 +131,61 @@ FString UGWTEffectNode::GetNodeTypeAsString() const
     return TEXT("Effect");
 }
 
-void UGWTEffectNode::ApplyDamageEffect(AActor* Target, UGWTSpellExecutionContext* Context)
+void UGWTEffectNode::ApplyDamageEffect(AActor* Target, UGWTSpellExecutionContext* Context, EGWTElementType InElementType, float Value)
 {
-    // Apply damage to target
-    AGWTCharacter* TargetCharacter = Cast<AGWTCharacter>(Target);
-    if (TargetCharacter)
+    // Record damage against the target, applied when the cast flushes its effects
+    if (Cast<AGWTCharacter>(Target))
     {
-        TargetCharacter->TakeDamage(EffectValue, ElementType, Context->Caster);
+        Context->EffectCommands.AddDamage(Target, Value, InElementType, Context->Caster);
 
-        UE_LOG(LogTemp, Verbose, TEXT("Applied damage effect to %s: %.1f damage"),
-            *Target->GetName(), EffectValue);
+        UE_LOG(LogTemp, Verbose, TEXT("Queued damage effect on %s: %.1f damage"),
+            *Target->GetName(), Value);
     }
 }
 
-void UGWTEffectNode::ApplyHealEffect(AActor* Target, UGWTSpellExecutionContext* Context)
+void UGWTEffectNode::ApplyHealEffect(AActor* Target, UGWTSpellExecutionContext* Context, float Value)
 {
-    // Apply healing to target
-    AGWTCharacter* TargetCharacter = Cast<AGWTCharacter>(Target);
-    if (TargetCharacter)
+    // Record healing for the target
+    if (Cast<AGWTCharacter>(Target))
     {
-        TargetCharacter->Heal(EffectValue);
+        Context->EffectCommands.AddHeal(Target, Value);
 
-        UE_LOG(LogTemp, Verbose, TEXT("Applied heal effect to %s: %.1f healing"),
-            *Target->GetName(), EffectValue);
+        UE_LOG(LogTemp, Verbose, TEXT("Queued heal effect on %s: %.1f healing"),
+            *Target->GetName(), Value);
     }
 }
 
-void UGWTEffectNode::ApplyStatusEffect(AActor* Target, UGWTSpellExecutionContext* Context)
+void UGWTEffectNode::ApplyStatusEffect(AActor* Target, UGWTSpellExecutionContext* Context, EGWTElementType InElementType, float Value, float Duration)
 {
-    // Apply status effect to target
-    AGWTCharacter* TargetCharacter = Cast<AGWTCharacter>(Target);
-    if (TargetCharacter)
+    // Record a status effect for the target
+    if (Cast<AGWTCharacter>(Target))
     {
-        // Create a status effect based on element type
-        FGWTStatusEffect StatusEffect;
-        StatusEffect.Duration = EffectDuration;
-        StatusEffect.Strength = EffectValue;
-        StatusEffect.Causer = Context->Caster;
-        StatusEffect.TimeRemaining = EffectDuration;
-
         // Select status effect type based on element
-        switch (ElementType)
+        EGWTStatusEffectType StatusType;
+        switch (InElementType)
         {
         case EGWTElementType::Fire:
-            StatusEffect.EffectType = EGWTStatusEffectType::Burning;
+            StatusType = EGWTStatusEffectType::Burning;
             break;
 
         case EGWTElementType::Ice:
-            StatusEffect.EffectType = EGWTStatusEffectType::Frozen;
+            StatusType = EGWTStatusEffectType::Frozen;
             break;
 
         case EGWTElementType::Lightning:
-            StatusEffect.EffectType = EGWTStatusEffectType::Electrified;
+            StatusType = EGWTStatusEffectType::Electrified;
             break;
 
         default:
             // Default to burning for other elements
-            StatusEffect.EffectType = EGWTStatusEffectType::Burning;
+            StatusType = EGWTStatusEffectType::Burning;
             break;
         }
 
-        TargetCharacter->ApplyStatusEffect(StatusEffect);
+        Context->EffectCommands.AddStatus(Target, StatusType, Value, Duration, Context->Caster);
 
-        UE_LOG(LogTemp, Verbose, TEXT("Applied status effect to %s: Type %d, Duration %.1f, Strength %.1f"),
-            *Target->GetName(), (int32)StatusEffect.EffectType, EffectDuration, EffectValue);
+        UE_LOG(LogTemp, Verbose, TEXT("Queued status effect on %s: Type %d, Duration %.1f, Strength %.1f"),
+            *Target->GetName(), (int32)StatusType, Duration, Value);
     }
 }
 
@@ -189,74 +199,35 @@ void UGWTEffectNode::ApplyTeleportEffect(AActor* Target, UGWTSpellExecutionConte
         // Adjust location to be above the surface
         TeleportLocation.Z += 100.0f; // Raise by 100 units to prevent embedding in ground
 
-        // Teleport the actor
-        Target->SetActorLocation(TeleportLocation, false, nullptr, ETeleportType::TeleportPhysics);
-
-        UE_LOG(LogTemp, Verbose, TEXT("Applied teleport effect to %s: New location (%f, %f, %f)"),
-            *Target->GetName(), TeleportLocation.X, TeleportLocation.Y, TeleportLocation.Z);
+        Context->EffectCommands.AddTeleport(Target, TeleportLocation);
     }
 }
 
-void UGWTEffectNode::ApplyKnockbackEffect(AActor* Target, UGWTSpellExecutionContext* Context)
+void UGWTEffectNode::ApplyKnockbackEffect(AActor* Target, UGWTSpellExecutionContext* Context, float Value)
 {
-    // Apply knockback to target
+    // Direction is taken from the caster when the command lands
     if (Target && Context->Caster)
     {
-        // Calculate direction from caster to target
-        FVector Direction = Target->GetActorLocation() - Context->Caster->GetActorLocation();
-        Direction.Normalize();
-
-        // Apply force based on effect value
-        FVector KnockbackForce = Direction * EffectValue * 1000.0f; // Scale up for appropriate force
-
-        // Apply force to character
-        UPrimitiveComponent* TargetPrimitive = Cast<UPrimitiveComponent>(Target->GetRootComponent());
-        if (TargetPrimitive && TargetPrimitive->IsSimulatingPhysics())
-        {
-            TargetPrimitive->AddImpulse(KnockbackForce, NAME_None, true);
-
-            UE_LOG(LogTemp, Verbose, TEXT("Applied physics knockback to %s with force (%f, %f, %f)"),
-                *Target->GetName(), KnockbackForce.X, KnockbackForce.Y, KnockbackForce.Z);
-        }
-        else
-        {
-            // For non-physics actors, we can manually move them
-            // This would typically be implemented with character movement component
-            UE_LOG(LogTemp, Verbose, TEXT("Applied movement knockback to %s with force (%f, %f, %f)"),
-                *Target->GetName(), KnockbackForce.X, KnockbackForce.Y, KnockbackForce.Z);
-        }
+        Context->EffectCommands.AddKnockback(Target, Value, Context->Caster);
     }
 }
 
-void UGWTEffectNode::ApplyShieldEffect(AActor* Target, UGWTSpellExecutionContext* Context)
+void UGWTEffectNode::ApplyShieldEffect(AActor* Target, UGWTSpellExecutionContext* Context, float Value, float Duration)
 {
-    // Apply shield effect to target
-    AGWTCharacter* TargetCharacter = Cast<AGWTCharacter>(Target);
-    if (TargetCharacter)
+    // Shields are a status effect that absorbs this amount of damage
+    if (Cast<AGWTCharacter>(Target))
     {
-        // Create shield status effect
-        FGWTStatusEffect ShieldEffect;
-        ShieldEffect.EffectType = EGWTStatusEffectType::Shielded;
-        ShieldEffect.Duration = EffectDuration;
-        ShieldEffect.Strength = EffectValue; // Shield absorbs this amount of damage
-        ShieldEffect.Causer = Context->Caster;
-        ShieldEffect.TimeRemaining = EffectDuration;
-
-        TargetCharacter->ApplyStatusEffect(ShieldEffect);
-
-        UE_LOG(LogTemp, Verbose, TEXT("Applied shield effect to %s: Absorbs %.1f damage for %.1f seconds"),
-            *Target->GetName(), EffectValue, EffectDuration);
+        Context->EffectCommands.AddStatus(Target, EGWTStatusEffectType::Shielded, Value, Duration, Context->Caster);
+
+        UE_LOG(LogTemp, Verbose, TEXT("Queued shield effect on %s: Absorbs %.1f damage for %.1f seconds"),
+            *Target->GetName(), Value, Duration);
     }
 }
 
 void UGWTEffectNode::ApplySummonEffect(UGWTSpellExecutionContext* Context)
 {
-    // Summon effect would spawn a companion/minion
-    // This is a placeholder implementation
-
     // Get spawn location from hit result or in front of caster
     FVector SpawnLocation;
-    FRotator SpawnRotation = FRotator::ZeroRotator;
 
     if (Context->HitResult.IsValidBlockingHit())
     {
@@ -275,7 +246,5 @@ void UGWTEffectNode::ApplySummonEffect(UGWTSpellExecutionContext* Context)
         return;
     }
 
-    // In a full implementation, we would spawn an actual minion actor here
-    UE_LOG(LogTemp, Verbose, TEXT("Applied summon effect at location (%f, %f, %f)"),
-        SpawnLocation.X, SpawnLocation.Y, SpawnLocation.Z);
+    Context->EffectCommands.AddSummon(SpawnLocation, Context->Caster);
 }
\ No newline at end of file
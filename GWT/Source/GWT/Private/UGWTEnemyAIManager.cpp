@@ -0,0 +1,353 @@
+// UGWTEnemyAIManager.cpp
+// Implementation of the enemy AI manager
+
+#include "UGWTEnemyAIManager.h"
+#include "AGWTEnemyCharacter.h"
+#include "AGWTPlayerCharacter.h"
+#include "AGWTGameState.h"
+#include "AGWTLevelGenerator.h"
+#include "AGWTRoom.h"
+#include "UGWTFlowFieldService.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Async/ParallelFor.h"
+
+void UGWTEnemyAIManager::Deinitialize()
+{
+    UE_LOG(LogTemp, Verbose, TEXT("Enemy AI manager shutting down with %d enemies"), Enemies.Num());
+
+    Enemies.Empty();
+    EnemyIndices.Empty();
+    RoomDistances.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UGWTEnemyAIManager::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UGWTEnemyAIManager, STATGROUP_Tickables);
+}
+
+void UGWTEnemyAIManager::RegisterEnemy(AGWTEnemyCharacter* Enemy)
+{
+    if (!Enemy || EnemyIndices.Contains(Enemy))
+    {
+        return;
+    }
+
+    // Every array grows together, Tick fills the slots
+    EnemyIndices.Add(Enemy, Enemies.Add(Enemy));
+    Positions.AddZeroed();
+    TargetPositions.AddZeroed();
+    AttackRanges.AddZeroed();
+    AggroRanges.AddZeroed();
+    TargetFields.AddZeroed();
+    StateFlags.AddZeroed();
+    Actions.Add(EGWTEnemyAIAction::None);
+    MoveDirections.AddZeroed();
+    Facings.AddZeroed();
+    PendingDeltaTimes.AddZeroed();
+    DueThisTick.Add(false);
+
+    Enemy->SetActorTickEnabled(false);
+}
+
+void UGWTEnemyAIManager::UnregisterEnemy(AGWTEnemyCharacter* Enemy)
+{
+    int32 Index;
+    if (!EnemyIndices.RemoveAndCopyValue(Enemy, Index))
+    {
+        return;
+    }
+
+    // A spell or status effect can kill an enemy while Tick is walking the arrays
+    if (bTicking)
+    {
+        Enemies[Index] = nullptr;
+        return;
+    }
+
+    RemoveAtSwap(Index);
+}
+
+UGWTEnemyAIManager* UGWTEnemyAIManager::Get(const AActor* WorldContext)
+{
+    UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UGWTEnemyAIManager>() : nullptr;
+}
+
+const FGWTAILODSettings& UGWTEnemyAIManager::GetLODSettings(EGWTAILOD LOD)
+{
+    // Update, sensing and animation intervals, indexed by EGWTAILOD
+    static const FGWTAILODSettings Settings[] =
+    {
+        { 0.0f, 0.5f, 0.0f },   // Full
+        { 0.2f, 1.0f, 0.1f },   // Reduced
+        { 0.5f, 2.0f, 0.25f },  // Minimal
+        { 0.5f, 2.0f, 0.25f }   // Dormant, used when woken
+    };
+
+    return Settings[FMath::Clamp((int32)LOD, 0, (int32)UE_ARRAY_COUNT(Settings) - 1)];
+}
+
+void UGWTEnemyAIManager::Tick(float DeltaTime)
+{
+    if (Enemies.Num() == 0)
+    {
+        return;
+    }
+
+    UpdateRoomDistances(DeltaTime);
+
+    bTicking = true;
+
+    UpdateLODs(DeltaTime);
+
+    // Character upkeep the actor tick would have done, with the time since the enemy last ran
+    const int32 NumEnemies = Enemies.Num();
+    for (int32 i = 0; i < NumEnemies; i++)
+    {
+        AGWTEnemyCharacter* Enemy = Enemies[i];
+        if (Enemy && DueThisTick[i])
+        {
+            Enemy->TickCharacterState(PendingDeltaTimes[i]);
+            PendingDeltaTimes[i] = 0.0f;
+        }
+    }
+
+    GatherSnapshot();
+
+    // Decisions only read the snapshot and write their own slot, so they can run side by side
+    ParallelFor(NumEnemies, [this](int32 Index)
+    {
+        Decide(Index);
+    }, NumEnemies < MinParallelEnemies ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+    ApplyDecisions();
+
+    bTicking = false;
+
+    // Compact the slots of enemies that left during the tick, back to front so indices stay valid
+    for (int32 i = Enemies.Num() - 1; i >= 0; i--)
+    {
+        if (!Enemies[i])
+        {
+            RemoveAtSwap(i);
+        }
+    }
+}
+
+void UGWTEnemyAIManager::UpdateRoomDistances(float DeltaTime)
+{
+    if (!LevelGenerator.IsValid())
+    {
+        TActorIterator<AGWTLevelGenerator> It(GetWorld());
+        LevelGenerator = It ? *It : nullptr;
+    }
+
+    AGWTGameState* GWTGameState = GetWorld()->GetGameState<AGWTGameState>();
+    if (!LevelGenerator.IsValid() || !GWTGameState)
+    {
+        RoomDistances.Reset();
+        return;
+    }
+
+    // A player crossing a doorway counts as being in the room its position falls in
+    TArray<const AGWTRoom*, TInlineAllocator<4>> CurrentPlayerRooms;
+    for (const AGWTPlayerCharacter* Player : GWTGameState->GetLivePlayers())
+    {
+        const AGWTRoom* Room = Player->CurrentRoom ? Player->CurrentRoom : LevelGenerator->GetRoomAtLocation(Player->GetActorLocation());
+        if (Room)
+        {
+            CurrentPlayerRooms.AddUnique(Room);
+        }
+    }
+
+    TimeSinceRoomDistances += DeltaTime;
+    const bool bPlayersMoved = CurrentPlayerRooms.Num() != PlayerRooms.Num() ||
+        CurrentPlayerRooms.ContainsByPredicate([this](const AGWTRoom* Room) { return !PlayerRooms.Contains(Room); });
+    if (!bPlayersMoved && TimeSinceRoomDistances < RoomDistanceRefreshInterval)
+    {
+        return;
+    }
+
+    PlayerRooms.Reset();
+    PlayerRooms.Append(CurrentPlayerRooms);
+    TimeSinceRoomDistances = 0.0f;
+
+    // Rooms past the reduced range are all alike, the walk stops there
+    LevelGenerator->GetRoomDistances(PlayerRooms, ReducedDetailRooms, RoomDistances);
+}
+
+void UGWTEnemyAIManager::UpdateLODs(float DeltaTime)
+{
+    FMemory::Memzero(LODCounts);
+
+    for (int32 i = 0; i < Enemies.Num(); i++)
+    {
+        AGWTEnemyCharacter* Enemy = Enemies[i];
+        DueThisTick[i] = false;
+        if (!Enemy)
+        {
+            continue;
+        }
+
+        const EGWTAILOD LOD = ComputeLOD(Enemy);
+        Enemy->SetAILOD(LOD);
+        LODCounts[(int32)LOD]++;
+
+        // Dormant enemies bank their time until they are woken
+        PendingDeltaTimes[i] += DeltaTime;
+        DueThisTick[i] = LOD != EGWTAILOD::Dormant && PendingDeltaTimes[i] >= GetLODSettings(LOD).UpdateInterval;
+    }
+}
+
+EGWTAILOD UGWTEnemyAIManager::ComputeLOD(const AGWTEnemyCharacter* Enemy) const
+{
+    // Without a room graph, in a doorway or in a fight, nothing is throttled
+    const AGWTRoom* Room = Enemy->CurrentRoom;
+    if (!Room || RoomDistances.Num() == 0 || Enemy->CurrentTarget)
+    {
+        return EGWTAILOD::Full;
+    }
+
+    const int32* Distance = RoomDistances.Find(Room);
+    if (Distance && *Distance <= FullDetailRooms)
+    {
+        return EGWTAILOD::Full;
+    }
+
+    // Unvisited rooms sleep until a player is next door
+    if (!Room->bHasBeenVisited)
+    {
+        return EGWTAILOD::Dormant;
+    }
+
+    return Distance ? EGWTAILOD::Reduced : EGWTAILOD::Minimal;
+}
+
+void UGWTEnemyAIManager::GatherSnapshot()
+{
+    const UGWTFlowFieldService* FlowFields = GetWorld()->GetSubsystem<UGWTFlowFieldService>();
+
+    for (int32 i = 0; i < Enemies.Num(); i++)
+    {
+        // Enemies not due this tick decide nothing
+        const AGWTEnemyCharacter* Enemy = Enemies[i];
+        if (!Enemy || !DueThisTick[i])
+        {
+            StateFlags[i] = 0;
+            continue;
+        }
+
+        const AActor* Target = Enemy->CurrentTarget;
+
+        Positions[i] = Enemy->GetActorLocation();
+        TargetPositions[i] = Target ? Target->GetActorLocation() : FVector::ZeroVector;
+        AttackRanges[i] = Enemy->AttackRange;
+        AggroRanges[i] = Enemy->MaxAggroRange;
+        TargetFields[i] = FlowFields ? FlowFields->FindField(Target) : nullptr;
+
+        StateFlags[i] = (Target ? FlagHasTarget : 0) |
+            (Enemy->bIsAttacking ? FlagAttacking : 0);
+    }
+}
+
+void UGWTEnemyAIManager::Decide(int32 Index)
+{
+    Actions[Index] = EGWTEnemyAIAction::None;
+
+    const uint8 Flags = StateFlags[Index];
+    const FVector& Position = Positions[Index];
+
+    if (Flags & FlagHasTarget)
+    {
+        // Same order as AGWTEnemyCharacter::Tick, lose interest, then attack, then chase
+        const FVector ToTarget = TargetPositions[Index] - Position;
+        const float DistanceSquared = ToTarget.SizeSquared();
+
+        if (DistanceSquared > FMath::Square(AggroRanges[Index]))
+        {
+            Actions[Index] = EGWTEnemyAIAction::LoseTarget;
+        }
+        else if (DistanceSquared <= FMath::Square(AttackRanges[Index]))
+        {
+            if (!(Flags & FlagAttacking))
+            {
+                Actions[Index] = EGWTEnemyAIAction::Attack;
+            }
+        }
+        else
+        {
+            // Follow the target's flow field around obstacles and through doors,
+            // straight at the target in its own cell or off the field
+            FVector Direction;
+            const FGWTFlowField* Field = TargetFields[Index];
+            if (!Field || !Field->GetDirection(Position, Direction))
+            {
+                Direction = ToTarget.GetSafeNormal();
+            }
+
+            // Face the way it is going, level
+            Actions[Index] = EGWTEnemyAIAction::Chase;
+            MoveDirections[Index] = Direction;
+            Facings[Index] = FRotator(0.0f, Direction.Rotation().Yaw, 0.0f);
+        }
+    }
+}
+
+void UGWTEnemyAIManager::ApplyDecisions()
+{
+    for (int32 i = 0; i < Actions.Num(); i++)
+    {
+        AGWTEnemyCharacter* Enemy = Enemies[i];
+        if (!Enemy || Enemy->CurrentHealth <= 0.0f)
+        {
+            continue;
+        }
+
+        switch (Actions[i])
+        {
+        case EGWTEnemyAIAction::LoseTarget:
+            Enemy->LoseTarget();
+            break;
+
+        case EGWTEnemyAIAction::Attack:
+            Enemy->BeginAttack();
+            break;
+
+        case EGWTEnemyAIAction::Chase:
+            // Target is in sight but not in attack range, chase it
+            Enemy->bIsAttacking = false;
+            Enemy->MoveAndFace(MoveDirections[i], Facings[i]);
+            break;
+
+        default:
+            break;
+        }
+
+        Actions[i] = EGWTEnemyAIAction::None;
+    }
+}
+
+void UGWTEnemyAIManager::RemoveAtSwap(int32 Index)
+{
+    Enemies.RemoveAtSwap(Index, 1, false);
+    Positions.RemoveAtSwap(Index, 1, false);
+    TargetPositions.RemoveAtSwap(Index, 1, false);
+    AttackRanges.RemoveAtSwap(Index, 1, false);
+    AggroRanges.RemoveAtSwap(Index, 1, false);
+    TargetFields.RemoveAtSwap(Index, 1, false);
+    StateFlags.RemoveAtSwap(Index, 1, false);
+    Actions.RemoveAtSwap(Index, 1, false);
+    MoveDirections.RemoveAtSwap(Index, 1, false);
+    Facings.RemoveAtSwap(Index, 1, false);
+    PendingDeltaTimes.RemoveAtSwap(Index, 1, false);
+    DueThisTick.RemoveAtSwap(Index, 1, false);
+
+    // The enemy swapped into the slot has moved
+    if (Enemies.IsValidIndex(Index) && Enemies[Index])
+    {
+        EnemyIndices.Add(Enemies[Index], Index);
+    }
+}
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include "UGWTEnemyCharacter.h"
 #include "AGWTGameMode.h"
 #include "AGWTGameState.h"
+#include "UGWTRandomService.h"
+#include "UGWTActorPool.h"
+#include "UGWTSpawnQueue.h"
 #include "Kismet/GameplayStatics.h"
 #include "NavigationSystem.h"
 #include "AI/Navigation/NavigationTypes.h"
@@ -19,7 +22,7 @@ UGWTEnemySpawner::UGWTEnemySpawner()
     // Set default spawning properties
     MinSpawnDistance = 500.0f;
     MaxEnemiesPerRoom = 5;
-    MaxConcurrentEnemies = 20;
+    MaxConcurrentEnemies = 50;
 
     UE_LOG(LogTemp, Display, TEXT("Enemy Spawner created"));
 }
@@ -31,6 +34,15 @@ void UGWTEnemySpawner::BeginPlay()
     // Initialize enemy classes if needed
     InitializeEnemyClasses();
 
+    // Queued spawns are carried out by this spawner
+    if (UGWTSpawnQueue* SpawnQueue = UGWTSpawnQueue::Get(GetOwner()))
+    {
+        SpawnQueue->SetSpawner(this);
+    }
+
+    // The first wave's enemies are spawned while the level loads
+    PrewarmForWave(GetCurrentWave(), MAX_int32);
+
     UE_LOG(LogTemp, Display, TEXT("Enemy Spawner initialized with %d enemy types"),
         EnemyClasses.Num());
 }
@@ -43,6 +55,9 @@ void UGWTEnemySpawner::TickComponent(float DeltaTime, ELevelTick TickType,
     // Clean up any dead enemies
     CleanupDeadEnemies();
 
+    // Get the next wave's enemies ready a few at a time
+    PrewarmForWave(GetCurrentWave() + 1, MaxPrewarmSpawnsPerTick);
+
     // Log active enemy count
     UE_LOG(LogTemp, Verbose, TEXT("Active enemies: %d/%d"),
         ActiveEnemies.Num(), MaxConcurrentEnemies);
@@ -64,58 +79,68 @@ void UGWTEnemySpawner::SpawnEnemiesForWave(int32 WaveNumber, AGWTRoom* Room)
         return;
     }
 
-    // Check if we're at the enemy cap
-    if (GetActiveEnemyCount() >= MaxConcurrentEnemies)
+    // Check if we're at the enemy cap, enemies still waiting in the queue count as spawned
+    UGWTSpawnQueue* SpawnQueue = UGWTSpawnQueue::Get(GetOwner());
+    const int32 NumCommitted = GetActiveEnemyCount() + (SpawnQueue ? SpawnQueue->GetQueueDepth() : 0);
+    if (NumCommitted >= MaxConcurrentEnemies)
     {
         UE_LOG(LogTemp, Warning, TEXT("Cannot spawn more enemies: At max capacity (%d)"),
             MaxConcurrentEnemies);
         return;
     }
 
-    // Calculate how many enemies to spawn
-    int32 EnemyCount = CalculateEnemyCountForRoom(Room, WaveNumber);
-
-    // Get the wave configuration
-    FGWTEnemyWaveInfo WaveConfig = GetWaveConfiguration(WaveNumber);
+    // Calculate how many enemies to spawn, only as many as the cap leaves room for
+    int32 EnemyCount = FMath::Min(CalculateEnemyCountForRoom(Room, WaveNumber), MaxConcurrentEnemies - NumCommitted);
 
-    UE_LOG(LogTemp, Display, TEXT("Spawning %d enemies in room for wave %d"),
+    UE_LOG(LogTemp, Display, TEXT("Queueing %d enemies in room for wave %d"),
         EnemyCount, WaveNumber);
 
-    // Spawn the enemies
+    // Spawned a few per frame, nearest rooms first
+    if (SpawnQueue)
+    {
+        SpawnQueue->EnqueueRoom(Room, WaveNumber, EnemyCount);
+        return;
+    }
+
+    // No queue outside gameplay worlds, spawn on the spot
     for (int32 i = 0; i < EnemyCount; i++)
     {
-        // Check if we're at the enemy cap
-        if (GetActiveEnemyCount() >= MaxConcurrentEnemies)
+        if (!SpawnEnemyInRoom(Room, WaveNumber))
         {
-            UE_LOG(LogTemp, Warning, TEXT("Hit max enemy cap during spawn, stopping"));
             break;
         }
+    }
+}
 
-        // Select an enemy type for this wave
-        TSubclassOf<AGWTEnemyCharacter> EnemyClass = SelectEnemyTypeForWave(WaveNumber);
+AGWTEnemyCharacter* UGWTEnemySpawner::SpawnEnemyInRoom(AGWTRoom* Room, int32 WaveNumber)
+{
+    // Check if we're at the enemy cap, the queue may have waited a while
+    if (GetActiveEnemyCount() >= MaxConcurrentEnemies)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Hit max enemy cap during spawn, skipping"));
+        return nullptr;
+    }
 
-        if (EnemyClass)
-        {
-            // Get a spawn point
-            FVector SpawnLocation = GetRandomSpawnPointInRoom(Room);
+    // Select an enemy type for this wave
+    TSubclassOf<AGWTEnemyCharacter> EnemyClass = SelectEnemyTypeForWave(WaveNumber);
+    if (!EnemyClass)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("No valid enemy class for wave %d"), WaveNumber);
+        return nullptr;
+    }
 
-            // Spawn the enemy
-            AGWTEnemyCharacter* Enemy = SpawnEnemy(EnemyClass, SpawnLocation, WaveNumber);
+    // Get a spawn point
+    FVector SpawnLocation = GetRandomSpawnPointInRoom(Room);
 
-            if (Enemy)
-            {
-                UE_LOG(LogTemp, Verbose, TEXT("Spawned enemy %d/%d in room"), i + 1, EnemyCount);
-            }
-            else
-            {
-                UE_LOG(LogTemp, Warning, TEXT("Failed to spawn enemy %d/%d"), i + 1, EnemyCount);
-            }
-        }
-        else
-        {
-            UE_LOG(LogTemp, Warning, TEXT("No valid enemy class for wave %d"), WaveNumber);
-        }
+    // Spawn the enemy
+    AGWTEnemyCharacter* Enemy = SpawnEnemy(EnemyClass, SpawnLocation, WaveNumber);
+    if (!Enemy)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to spawn enemy in room (%d, %d, %d)"),
+            Room->GridPosition.X, Room->GridPosition.Y, Room->GridPosition.Z);
     }
+
+    return Enemy;
 }
 
 AGWTEnemyCharacter* UGWTEnemySpawner::SpawnEnemy(TSubclassOf<AGWTEnemyCharacter> EnemyClass,
@@ -128,16 +153,25 @@ AGWTEnemyCharacter* UGWTEnemySpawner::SpawnEnemy(TSubclassOf<AGWTEnemyCharacter>
         return nullptr;
     }
 
-    // Spawn the enemy
-    FActorSpawnParameters SpawnParams;
-    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-    AGWTEnemyCharacter* Enemy = GetWorld()->SpawnActor<AGWTEnemyCharacter>(
-        EnemyClass,
-        Location,
-        FRotator(0.0f, FMath::FRand() * 360.0f, 0.0f),
-        SpawnParams
-    );
+    // Facing comes from the match seed so a replayed wave spawns identically
+    const FGWTRandomKey FacingKey(EGWTRandomDomain::Spawner, UGWTRandomService::GetStreamID(this), SpawnRollCount++);
+    const float Yaw = UGWTRandomService::FRand(this, FacingKey) * 360.0f;
+
+    // Take the enemy from the pool, only a pool miss spawns
+    const FTransform SpawnTransform(FRotator(0.0f, Yaw, 0.0f), Location);
+    UGWTActorPool* Pool = UGWTActorPool::Get(GetOwner());
+
+    AGWTEnemyCharacter* Enemy = nullptr;
+    if (Pool)
+    {
+        Enemy = Pool->Acquire<AGWTEnemyCharacter>(EnemyClass, SpawnTransform);
+    }
+    else
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+        Enemy = GetWorld()->SpawnActor<AGWTEnemyCharacter>(EnemyClass, SpawnTransform, SpawnParams);
+    }
 
     if (Enemy)
     {
@@ -194,6 +228,40 @@ TSubclassOf<AGWTEnemyCharacter> UGWTEnemySpawner::SelectEnemyTypeForWave(int32 W
     return nullptr;
 }
 
+int32 UGWTEnemySpawner::PrewarmForWave(int32 WaveNumber, int32 MaxSpawns)
+{
+    UGWTActorPool* Pool = UGWTActorPool::Get(GetOwner());
+    if (!Pool || MaxSpawns <= 0)
+    {
+        return 0;
+    }
+
+    // Every type the wave can roll gets an even share
+    const TArray<EGWTEnemyType> WaveTypes = GetEnemyTypesForWave(WaveNumber);
+    if (WaveTypes.Num() == 0)
+    {
+        return 0;
+    }
+
+    const int32 CountPerType = FMath::DivideAndRoundUp(PrewarmEnemyCount, WaveTypes.Num());
+
+    int32 NumSpawned = 0;
+    for (EGWTEnemyType Type : WaveTypes)
+    {
+        if (NumSpawned >= MaxSpawns)
+        {
+            break;
+        }
+
+        if (const TSubclassOf<AGWTEnemyCharacter>* EnemyClass = EnemyClasses.Find(Type))
+        {
+            NumSpawned += Pool->Prewarm(*EnemyClass, CountPerType, MaxSpawns - NumSpawned);
+        }
+    }
+
+    return NumSpawned;
+}
+
 int32 UGWTEnemySpawner::CalculateEnemyCountForRoom(AGWTRoom* Room, int32 WaveNumber)
 {
     // Base count depends on room type
@@ -303,7 +371,8 @@ EGWTEnemyType UGWTEnemySpawner::GetRandomEnemyType(const TArray<EGWTEnemyType>&
     // Return a random enemy type from the array
     if (EnemyTypes.Num() > 0)
     {
-        int32 RandomIndex = FMath::RandRange(0, EnemyTypes.Num() - 1);
+        const FGWTRandomKey Key(EGWTRandomDomain::Spawner, UGWTRandomService::GetStreamID(this), SpawnRollCount++);
+        int32 RandomIndex = FMath::Min(FMath::FloorToInt(UGWTRandomService::FRand(this, Key) * EnemyTypes.Num()), EnemyTypes.Num() - 1);
         return EnemyTypes[RandomIndex];
     }
 
@@ -323,10 +392,15 @@ FVector UGWTEnemySpawner::GetRandomSpawnPointInRoom(AGWTRoom* Room) const
     // Get room center
     FVector RoomCenter = RoomBounds.GetCenter();
 
-    // Generate random point within bounds
+    // Generate random point within bounds, one draw per axis
+    const uint32 Stream = UGWTRandomService::GetStreamID(this);
+    const uint32 Roll = SpawnRollCount++;
+    const float AlphaX = UGWTRandomService::FRand(this, FGWTRandomKey(EGWTRandomDomain::Spawner, Stream, Roll, 0));
+    const float AlphaY = UGWTRandomService::FRand(this, FGWTRandomKey(EGWTRandomDomain::Spawner, Stream, Roll, 1));
+
     FVector RandomPoint = RoomCenter + FVector(
-        FMath::FRandRange(-BoundsExtent.X, BoundsExtent.X),
-        FMath::FRandRange(-BoundsExtent.Y, BoundsExtent.Y),
+        FMath::Lerp(-BoundsExtent.X, BoundsExtent.X, AlphaX),
+        FMath::Lerp(-BoundsExtent.Y, BoundsExtent.Y, AlphaY),
         0.0f // Keep z at center height
     );
 
@@ -350,8 +424,8 @@ void UGWTEnemySpawner::RegisterEnemy(AGWTEnemyCharacter* Enemy)
     {
         ActiveEnemies.Add(Enemy);
 
-        // Subscribe to enemy's death event
-        Enemy->OnDestroyed.AddDynamic(this, &UGWTEnemySpawner::OnEnemyDestroyed);
+        // Subscribe to enemy's death event, pooled enemies come back more than once
+        Enemy->OnDestroyed.AddUniqueDynamic(this, &UGWTEnemySpawner::OnEnemyDestroyed);
 
         UE_LOG(LogTemp, Verbose, TEXT("Registered enemy %s, total active: %d"),
             *Enemy->GetName(), ActiveEnemies.Num());
@@ -377,10 +451,10 @@ int32 UGWTEnemySpawner::GetActiveEnemyCount() const
 
 void UGWTEnemySpawner::CleanupDeadEnemies()
 {
-    // Remove any null or invalid enemies from the active list
+    // Remove any null, invalid or dead enemies from the active list, the dead are on their way back to the pool
     for (int32 i = ActiveEnemies.Num() - 1; i >= 0; i--)
     {
-        if (!ActiveEnemies[i] || ActiveEnemies[i]->IsPendingKill())
+        if (!ActiveEnemies[i] || ActiveEnemies[i]->IsPendingKill() || ActiveEnemies[i]->CurrentHealth <= 0.0f)
         {
             ActiveEnemies.RemoveAt(i);
         }
@@ -426,6 +500,12 @@ void UGWTEnemySpawner::InitializeEnemyClasses()
     }
 }
 
+int32 UGWTEnemySpawner::GetCurrentWave() const
+{
+    const AGWTGameMode* GWTGameMode = Cast<AGWTGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
+    return GWTGameMode ? GWTGameMode->CurrentWave : 1;
+}
+
 void UGWTEnemySpawner::SetupDefaultEnemyClasses()
 {
     // Clear any existing classes
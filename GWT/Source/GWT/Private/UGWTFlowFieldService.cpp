@@ -0,0 +1,362 @@
+// UGWTFlowFieldService.cpp
+// Implementation of the flow field service
+
+#include "UGWTFlowFieldService.h"
+#include "AGWTLevelGenerator.h"
+#include "AGWTRoom.h"
+#include "AGWTGameState.h"
+#include "AGWTPlayerCharacter.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+bool FGWTFlowField::GetDirection(const FVector& Location, FVector& OutDirection) const
+{
+    const FIntVector Cell = WorldToCell(Location);
+    const FGWTFlowCell* FlowCell = Cells.Find(Cell);
+    if (!FlowCell || FlowCell->Cost == 0 || FlowCell->StepZ != 0)
+    {
+        return false;
+    }
+
+    // Aim for the middle of the next cell so enemies line up with doorways
+    const FVector NextCell = CellToWorld(Cell + FIntVector(FlowCell->StepX, FlowCell->StepY, 0));
+    OutDirection = (NextCell - Location).GetSafeNormal2D();
+    return !OutDirection.IsNearlyZero();
+}
+
+FIntVector FGWTFlowField::WorldToCell(const FVector& Location) const
+{
+    // Rooms are centred on multiples of RoomSize, so cell 0 starts half a room before the origin
+    const float HalfRoom = RoomSize * 0.5f;
+    return FIntVector(
+        FMath::FloorToInt((Location.X + HalfRoom) / CellSize),
+        FMath::FloorToInt((Location.Y + HalfRoom) / CellSize),
+        FMath::RoundToInt(Location.Z / RoomSize));
+}
+
+FVector FGWTFlowField::CellToWorld(const FIntVector& Cell) const
+{
+    const float HalfRoom = RoomSize * 0.5f;
+    return FVector(
+        (Cell.X + 0.5f) * CellSize - HalfRoom,
+        (Cell.Y + 0.5f) * CellSize - HalfRoom,
+        Cell.Z * RoomSize);
+}
+
+void UGWTFlowFieldService::Deinitialize()
+{
+    UE_LOG(LogTemp, Verbose, TEXT("Flow field service shutting down with %d fields"), Fields.Num());
+
+    Fields.Empty();
+    RoomCells.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UGWTFlowFieldService::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UGWTFlowFieldService, STATGROUP_Tickables);
+}
+
+const FGWTFlowField* UGWTFlowFieldService::FindField(const AActor* Target) const
+{
+    const FPlayerField* Field = Target ? Fields.Find(FObjectKey(Target)) : nullptr;
+    return Field && Field->bHasCurrent ? &Field->Current : nullptr;
+}
+
+UGWTFlowFieldService* UGWTFlowFieldService::Get(const AActor* WorldContext)
+{
+    UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UGWTFlowFieldService>() : nullptr;
+}
+
+void UGWTFlowFieldService::Tick(float DeltaTime)
+{
+    NumCellsSettledLastTick = 0;
+
+    if (!LevelGenerator.IsValid())
+    {
+        TActorIterator<AGWTLevelGenerator> It(GetWorld());
+        LevelGenerator = It ? *It : nullptr;
+    }
+
+    if (!LevelGenerator.IsValid())
+    {
+        Fields.Reset();
+        return;
+    }
+
+    SyncPlayers();
+
+    const float RoomSize = LevelGenerator->RoomSize;
+    const float CellSize = RoomSize / CellsPerRoom;
+
+    // Start a build for every player who changed cell, or whose field is getting old
+    for (TPair<FObjectKey, FPlayerField>& Pair : Fields)
+    {
+        FPlayerField& Field = Pair.Value;
+        const AActor* Player = Field.Player.Get();
+        Field.TimeSinceBuild += DeltaTime;
+
+        Field.Building.RoomSize = RoomSize;
+        Field.Building.CellSize = CellSize;
+        const FIntVector GoalCell = Field.Building.WorldToCell(Player->GetActorLocation());
+
+        const FIntVector& BuiltFor = Field.bBuilding ? Field.Building.GoalCell : Field.Current.GoalCell;
+        const bool bNeedsBuild = (!Field.bHasCurrent && !Field.bBuilding) || GoalCell != BuiltFor ||
+            Field.TimeSinceBuild >= FieldRefreshInterval;
+        if (!bNeedsBuild)
+        {
+            continue;
+        }
+
+        const FIntVector RoomPosition = CellToRoomPosition(GoalCell);
+        if (const AGWTRoom* GoalRoom = LevelGenerator->GetRoom(RoomPosition.X, RoomPosition.Y, RoomPosition.Z))
+        {
+            BeginBuild(Field, GoalCell, GoalRoom);
+        }
+    }
+
+    // Share the budget between the builds in progress
+    for (TPair<FObjectKey, FPlayerField>& Pair : Fields)
+    {
+        if (NumCellsSettledLastTick >= MaxCellsPerTick)
+        {
+            break;
+        }
+
+        if (Pair.Value.bBuilding)
+        {
+            NumCellsSettledLastTick += ContinueBuild(Pair.Value, MaxCellsPerTick - NumCellsSettledLastTick);
+        }
+    }
+}
+
+void UGWTFlowFieldService::SyncPlayers()
+{
+    AGWTGameState* GWTGameState = GetWorld()->GetGameState<AGWTGameState>();
+    if (!GWTGameState)
+    {
+        Fields.Reset();
+        return;
+    }
+
+    const TArray<AGWTPlayerCharacter*>& LivePlayers = GWTGameState->GetLivePlayers();
+
+    for (auto It = Fields.CreateIterator(); It; ++It)
+    {
+        AActor* Player = It.Value().Player.Get();
+        if (!Player || !LivePlayers.Contains(Player))
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    for (AGWTPlayerCharacter* Player : LivePlayers)
+    {
+        FPlayerField& Field = Fields.FindOrAdd(FObjectKey(Player));
+        Field.Player = Player;
+    }
+}
+
+void UGWTFlowFieldService::BeginBuild(FPlayerField& Field, const FIntVector& GoalCell, const AGWTRoom* GoalRoom)
+{
+    // Only rooms a few doors away are worth covering, enemies further out are not chasing
+    TArray<const AGWTRoom*> GoalRooms;
+    GoalRooms.Add(GoalRoom);
+    LevelGenerator->GetRoomDistances(GoalRooms, MaxFieldRooms, Field.ReachableRooms);
+
+    Field.Building.GoalCell = GoalCell;
+    Field.Building.Cells.Reset();
+    Field.Building.Cells.Add(GoalCell, FGWTFlowCell());
+
+    Field.OpenCells.Reset();
+    Field.OpenCells.HeapPush(FOpenCell{ 0, GoalCell });
+
+    Field.bBuilding = true;
+    Field.TimeSinceBuild = 0.0f;
+}
+
+int32 UGWTFlowFieldService::ContinueBuild(FPlayerField& Field, int32 Budget)
+{
+    static constexpr int32 StraightCost = 10;
+    static constexpr int32 DiagonalCost = 14;
+    static constexpr int32 StairCost = StraightCost * CellsPerRoom / 2;
+
+    int32 NumSettled = 0;
+    while (NumSettled < Budget && Field.OpenCells.Num() > 0)
+    {
+        FOpenCell Open;
+        Field.OpenCells.HeapPop(Open, false);
+
+        // A cell can be queued again with a lower cost, skip the stale entries
+        const FGWTFlowCell* Known = Field.Building.Cells.Find(Open.Cell);
+        if (!Known || Known->Cost < Open.Cost)
+        {
+            continue;
+        }
+
+        NumSettled++;
+        const FIntVector& Cell = Open.Cell;
+
+        TryStep(Field, Cell, Open.Cost, FIntVector(1, 0, 0), StraightCost);
+        TryStep(Field, Cell, Open.Cost, FIntVector(-1, 0, 0), StraightCost);
+        TryStep(Field, Cell, Open.Cost, FIntVector(0, 1, 0), StraightCost);
+        TryStep(Field, Cell, Open.Cost, FIntVector(0, -1, 0), StraightCost);
+
+        // Diagonals stay inside the room and never cut the corner of an obstacle
+        const AGWTRoom* Room = GetCellRoom(Field, Cell);
+        for (int32 StepX = -1; StepX <= 1; StepX += 2)
+        {
+            for (int32 StepY = -1; StepY <= 1; StepY += 2)
+            {
+                const FIntVector SideX = Cell + FIntVector(StepX, 0, 0);
+                const FIntVector SideY = Cell + FIntVector(0, StepY, 0);
+                if (GetCellRoom(Field, Cell + FIntVector(StepX, StepY, 0)) != Room ||
+                    GetCellRoom(Field, SideX) != Room || GetCellRoom(Field, SideY) != Room ||
+                    IsCellBlocked(Room, SideX) || IsCellBlocked(Room, SideY))
+                {
+                    continue;
+                }
+
+                TryStep(Field, Cell, Open.Cost, FIntVector(StepX, StepY, 0), DiagonalCost);
+            }
+        }
+
+        // Floor and ceiling doors are taken from the middle of the room
+        const FIntVector RoomPosition = CellToRoomPosition(Cell);
+        if (Cell.X - RoomPosition.X * CellsPerRoom == CellsPerRoom / 2 &&
+            Cell.Y - RoomPosition.Y * CellsPerRoom == CellsPerRoom / 2)
+        {
+            TryStep(Field, Cell, Open.Cost, FIntVector(0, 0, 1), StairCost);
+            TryStep(Field, Cell, Open.Cost, FIntVector(0, 0, -1), StairCost);
+        }
+    }
+
+    // Finished, the new field replaces the old one
+    if (Field.OpenCells.Num() == 0)
+    {
+        Swap(Field.Current, Field.Building);
+        Field.Building.Cells.Reset();
+        Field.bHasCurrent = true;
+        Field.bBuilding = false;
+
+        UE_LOG(LogTemp, VeryVerbose, TEXT("Flow field for %s built over %d cells"),
+            *GetNameSafe(Field.Player.Get()), Field.Current.Cells.Num());
+    }
+
+    return NumSettled;
+}
+
+void UGWTFlowFieldService::TryStep(FPlayerField& Field, const FIntVector& From, int32 FromCost, const FIntVector& Step, int32 StepCost)
+{
+    const FIntVector To = From + Step;
+    const AGWTRoom* ToRoom = GetCellRoom(Field, To);
+    if (!ToRoom || !CanCross(From, GetCellRoom(Field, From), To, ToRoom) || IsCellBlocked(ToRoom, To))
+    {
+        return;
+    }
+
+    const int32 Cost = FromCost + StepCost;
+    const FGWTFlowCell* Known = Field.Building.Cells.Find(To);
+    if (Known && Known->Cost <= Cost)
+    {
+        return;
+    }
+
+    // The field is walked from the goal outwards, so the next step points back along this one
+    FGWTFlowCell& FlowCell = Field.Building.Cells.FindOrAdd(To);
+    FlowCell.Cost = Cost;
+    FlowCell.StepX = -Step.X;
+    FlowCell.StepY = -Step.Y;
+    FlowCell.StepZ = -Step.Z;
+
+    Field.OpenCells.HeapPush(FOpenCell{ Cost, To });
+}
+
+FIntVector UGWTFlowFieldService::CellToRoomPosition(const FIntVector& Cell)
+{
+    return FIntVector(
+        FMath::FloorToInt((float)Cell.X / CellsPerRoom),
+        FMath::FloorToInt((float)Cell.Y / CellsPerRoom),
+        Cell.Z);
+}
+
+const AGWTRoom* UGWTFlowFieldService::GetCellRoom(const FPlayerField& Field, const FIntVector& Cell) const
+{
+    const FIntVector RoomPosition = CellToRoomPosition(Cell);
+    const AGWTRoom* Room = LevelGenerator->GetRoom(RoomPosition.X, RoomPosition.Y, RoomPosition.Z);
+    return Room && Field.ReachableRooms.Contains(Room) ? Room : nullptr;
+}
+
+bool UGWTFlowFieldService::CanCross(const FIntVector& From, const AGWTRoom* FromRoom, const FIntVector& To, const AGWTRoom* ToRoom) const
+{
+    if (FromRoom == ToRoom)
+    {
+        return true;
+    }
+
+    // Through a wall only at the doorway cells in the middle of it
+    if (From.Z == To.Z)
+    {
+        const int32 AlongWall = From.X != To.X ? From.Y - CellToRoomPosition(From).Y * CellsPerRoom
+                                               : From.X - CellToRoomPosition(From).X * CellsPerRoom;
+        if (FMath::Abs(AlongWall - CellsPerRoom / 2 + 0.5f) > DoorHalfWidthCells)
+        {
+            return false;
+        }
+    }
+
+    for (const TPair<EGWTDirection, bool>& Door : FromRoom->DoorStates)
+    {
+        if (Door.Value && LevelGenerator->GetRoomThroughDoor(FromRoom, Door.Key) == ToRoom)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool UGWTFlowFieldService::IsCellBlocked(const AGWTRoom* Room, const FIntVector& Cell)
+{
+    // Probe height above the room origin and half height of the probe box
+    static constexpr float ProbeHeight = 100.0f;
+    static constexpr float ProbeHalfHeight = 40.0f;
+
+    const FIntVector RoomPosition = CellToRoomPosition(Cell);
+    const int32 LocalX = Cell.X - RoomPosition.X * CellsPerRoom;
+    const int32 LocalY = Cell.Y - RoomPosition.Y * CellsPerRoom;
+
+    // Probe the whole room the first time, and again after a cube rotation moved it
+    FRoomCells& Cells = RoomCells.FindOrAdd(Room);
+    if (Cells.Blocked.Num() == 0 || !Cells.ProbedLocation.Equals(Room->GetActorLocation()))
+    {
+        const float RoomSize = LevelGenerator->RoomSize;
+        const float CellSize = RoomSize / CellsPerRoom;
+
+        // The room's own walls, floor and doors are not obstacles, door cells are handled by CanCross
+        TArray<AActor*> AttachedActors;
+        Room->GetAttachedActors(AttachedActors);
+
+        FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(GWTFlowFieldProbe), false, Room);
+        QueryParams.AddIgnoredActors(AttachedActors);
+
+        const FCollisionShape Probe = FCollisionShape::MakeBox(FVector(CellSize * 0.4f, CellSize * 0.4f, ProbeHalfHeight));
+        const FVector Corner = FVector(RoomPosition) * RoomSize - FVector(RoomSize * 0.5f, RoomSize * 0.5f, -ProbeHeight);
+
+        Cells.ProbedLocation = Room->GetActorLocation();
+        Cells.Blocked.Init(false, CellsPerRoom * CellsPerRoom);
+        for (int32 Y = 0; Y < CellsPerRoom; Y++)
+        {
+            for (int32 X = 0; X < CellsPerRoom; X++)
+            {
+                const FVector Center = Corner + FVector((X + 0.5f) * CellSize, (Y + 0.5f) * CellSize, 0.0f);
+                Cells.Blocked[Y * CellsPerRoom + X] = GetWorld()->OverlapAnyTestByObjectType(
+                    Center, FQuat::Identity, FCollisionObjectQueryParams(ECC_WorldStatic), Probe, QueryParams);
+            }
+        }
+    }
+
+    return Cells.Blocked[LocalY * CellsPerRoom + LocalX];
+}
\ No newline at end of file
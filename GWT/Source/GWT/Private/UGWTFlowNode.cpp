@@ -3,6 +3,9 @@
 
 #include "UGWTFlowNode.h"
 #include "UGWTSpellExecutionContext.h"
+#include "FGWTRuntimeValue.h"
+
+const FName UGWTFlowNode::IndexVariableName(TEXT("Index"));
 
 UGWTFlowNode::UGWTFlowNode()
 {
@@ -113,6 +116,7 @@ void UGWTFlowNode::SetBodyNode(UGWTSpellNode* Node)
 
     // Set as body node
     BodyNode = Node;
+    MarkModified();
 
     UE_LOG(LogTemp, Verbose, TEXT("Set body node to: %s"),
         Node ? *Node->NodeTitle.ToString() : TEXT("None"));
@@ -152,10 +156,10 @@ void UGWTFlowNode::ExecuteWhile(UGWTSpellExecutionContext* Context)
 
         // In a real game, we would spread these over time and have a max iteration count
         // For this example, we'll use a simple counter to prevent infinite loops
-        int32 MaxIterations = 100; // Safety limit
+        int32 MaxIterations = MaxWhileIterations; // Safety limit
         int32 Iterations = 0;
 
-        while (EvaluateWhileCondition(Context) && Iterations < MaxIterations)
+        while (EvaluateWhileCondition(Context, ConditionVariableName) && Iterations < MaxIterations)
         {
             UE_LOG(LogTemp, Verbose, TEXT("While loop iteration %d"), Iterations + 1);
 
@@ -190,6 +194,10 @@ void UGWTFlowNode::ExecuteForEach(UGWTSpellExecutionContext* Context)
     {
         UE_LOG(LogTemp, Verbose, TEXT("Starting forEach loop (simulated)"));
 
+        // Index variable to simulate iteration, only the value changes per iteration
+        FGWTVariableValue IndexValue;
+        IndexValue.Type = EGWTVariableType::Int;
+
         // Simulate forEach with a simple loop
         for (int32 i = 0; i < IterationCount; i++)
         {
@@ -198,11 +206,9 @@ void UGWTFlowNode::ExecuteForEach(UGWTSpellExecutionContext* Context)
             // In a real implementation, we would extract items from a collection
             // and add them to the context
 
-            // Create an index variable to simulate iteration
-            FGWTVariableValue IndexValue;
-            IndexValue.Type = EGWTVariableType::Int;
+            // Publish the index
             IndexValue.IntValue = i;
-            Context->SetVariable(FName("Index"), IndexValue);
+            Context->SetVariable(IndexVariableName, IndexValue);
 
             // Execute the body node
             BodyNode->Execute(Context);
@@ -237,24 +243,30 @@ void UGWTFlowNode::ExecuteDelay(UGWTSpellExecutionContext* Context)
     }
 }
 
-bool UGWTFlowNode::EvaluateWhileCondition(UGWTSpellExecutionContext* Context)
+bool UGWTFlowNode::EvaluateWhileCondition(UGWTSpellExecutionContext* Context, FName InConditionVariableName)
+{
+    FGWTRuntimeValue ConditionValue;
+    const bool bHasValue = Context->TryGetVariable(InConditionVariableName, ConditionValue);
+
+    return EvaluateWhileValue(bHasValue ? &ConditionValue : nullptr, InConditionVariableName);
+}
+
+bool UGWTFlowNode::EvaluateWhileValue(const FGWTRuntimeValue* ConditionValue, FName InConditionVariableName)
 {
     // Check if the named condition variable is true
-    if (Context->HasVariable(ConditionVariableName))
+    if (ConditionValue)
     {
-        FGWTVariableValue ConditionValue = Context->GetVariable(ConditionVariableName);
-
         // Check based on variable type
-        switch (ConditionValue.Type)
+        switch (ConditionValue->GetType())
         {
         case EGWTVariableType::Bool:
-            return ConditionValue.BoolValue;
+            return ConditionValue->GetBool();
 
         case EGWTVariableType::Int:
-            return ConditionValue.IntValue != 0;
+            return ConditionValue->GetInt() != 0;
 
         case EGWTVariableType::Float:
-            return ConditionValue.FloatValue != 0.0f;
+            return ConditionValue->GetFloat() != 0.0f;
 
         default:
             UE_LOG(LogTemp, Warning, TEXT("Unsupported variable type for while condition"));
@@ -263,7 +275,7 @@ bool UGWTFlowNode::EvaluateWhileCondition(UGWTSpellExecutionContext* Context)
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("Condition variable %s not found"), *ConditionVariableName.ToString());
+        UE_LOG(LogTemp, Warning, TEXT("Condition variable %s not found"), *InConditionVariableName.ToString());
         return false;
     }
 }
\ No newline at end of file
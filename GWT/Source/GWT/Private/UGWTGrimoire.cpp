@@ -10,6 +10,9 @@
 #include "UGWTConditionNode.h"
 #include "UGWTVariableNode.h"
 #include "UGWTFlowNode.h"
+#include "FGWTSpellSerializer.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
 
 UGWTGrimoire::UGWTGrimoire()
 {
@@ -147,6 +150,132 @@ UGWTGrimoire* UGWTGrimoire::LoadFromString(const FString& GrimoireData)
     return NewGrimoire;
 }
 
+void UGWTGrimoire::SaveToBinary(TArray<uint8>& OutData) const
+{
+    OutData.Reset();
+    FMemoryWriter Writer(OutData);
+
+    // Header
+    uint32 Magic = FGWTSpellSerializer::GrimoireMagic;
+    uint16 Version = FGWTSpellSerializer::CurrentVersion;
+    Writer << Magic << Version;
+
+    // Unlocked node types by class path
+    TArray<FString> NodeTypePaths;
+    for (TSubclassOf<UGWTSpellNode> NodeType : UnlockedNodeTypes)
+    {
+        if (NodeType)
+        {
+            NodeTypePaths.Add(NodeType->GetPathName());
+        }
+    }
+    Writer << NodeTypePaths;
+
+    // Spells are written inline, each with its own header
+    int32 NumSpells = 0;
+    for (UGWTSpell* Spell : Spells)
+    {
+        NumSpells += Spell ? 1 : 0;
+    }
+    Writer << NumSpells;
+
+    for (UGWTSpell* Spell : Spells)
+    {
+        if (Spell)
+        {
+            FGWTSpellSerializer::WriteSpell(Writer, Spell);
+        }
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("Saved grimoire to %d bytes, %d spells, %d node types"),
+        OutData.Num(), NumSpells, NodeTypePaths.Num());
+}
+
+UGWTGrimoire* UGWTGrimoire::LoadFromBinary(const TArray<uint8>& GrimoireData)
+{
+    // No string or array in the blob can be longer than the blob itself
+    FMemoryReader Reader(GrimoireData);
+    Reader.ArMaxSerializeSize = GrimoireData.Num();
+
+    uint32 Magic = 0;
+    uint16 Version = 0;
+    if (GrimoireData.Num() >= (int32)(sizeof(Magic) + sizeof(Version)))
+    {
+        Reader << Magic << Version;
+    }
+
+    // Older saves are the text from SaveToString
+    if (Magic != FGWTSpellSerializer::GrimoireMagic)
+    {
+        FUTF8ToTCHAR Converter((const ANSICHAR*)GrimoireData.GetData(), GrimoireData.Num());
+        return LoadFromString(FString(Converter.Length(), Converter.Get()));
+    }
+
+    if (Version == 0 || Version > FGWTSpellSerializer::CurrentVersion)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Unsupported grimoire version: %d"), Version);
+        return nullptr;
+    }
+
+    UGWTGrimoire* NewGrimoire = NewObject<UGWTGrimoire>();
+
+    // Node types, read one by one so the count is checked against the bytes left, every path takes at least its length
+    int32 NumNodeTypes = 0;
+    Reader << NumNodeTypes;
+    if (Reader.IsError() || NumNodeTypes < 0 || NumNodeTypes > (Reader.TotalSize() - Reader.Tell()) / (int64)sizeof(int32))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Invalid grimoire node type count: %d"), NumNodeTypes);
+        return nullptr;
+    }
+
+    for (int32 i = 0; i < NumNodeTypes; i++)
+    {
+        FString NodeTypePath;
+        Reader << NodeTypePath;
+        if (Reader.IsError())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Invalid grimoire data"));
+            return nullptr;
+        }
+
+        // Only node classes this build already has loaded, the blob never decides what gets loaded
+        UClass* NodeType = FGWTSpellSerializer::FindNodeClass(NodeTypePath);
+        if (!NodeType)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Grimoire unlocks an unknown node type, skipped: %s"), *NodeTypePath);
+            continue;
+        }
+
+        NewGrimoire->UnlockNodeType(NodeType);
+    }
+
+    // Spells
+    int32 NumSpells = 0;
+    Reader << NumSpells;
+    if (Reader.IsError() || NumSpells < 0 || NumSpells > (Reader.TotalSize() - Reader.Tell()) / FGWTSpellSerializer::MinSpellSize)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Invalid grimoire spell count: %d"), NumSpells);
+        return nullptr;
+    }
+
+    NewGrimoire->Spells.Reserve(NumSpells);
+    for (int32 i = 0; i < NumSpells; i++)
+    {
+        UGWTSpell* Spell = FGWTSpellSerializer::ReadSpell(Reader, NewGrimoire);
+        if (!Spell)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Grimoire spell %d could not be loaded"), i);
+            return nullptr;
+        }
+
+        NewGrimoire->Spells.Add(Spell);
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Loaded grimoire from %d bytes, %d spells"), GrimoireData.Num(), NumSpells);
+
+    return NewGrimoire;
+}
+
 int32 UGWTGrimoire::GetSpellCount() const
 {
     return Spells.Num();
@@ -3,6 +3,7 @@
 
 #include "UGWTHat.h"
 #include "AGWTCharacter.h"
+#include "UGWTRandomService.h"
 
 UGWTHat::UGWTHat()
 {
@@ -175,6 +176,7 @@ bool UGWTHat::ShouldDiscountMana() const
         return false;
     }
 
-    float Random = FMath::FRand() * 100.0f;
+    const FGWTRandomKey Key(EGWTRandomDomain::ManaDiscount, UGWTRandomService::GetStreamID(this), DiscountRollCount++);
+    float Random = UGWTRandomService::FRand(this, Key) * 100.0f;
     return Random <= ManaDiscountChance;
 }
\ No newline at end of file
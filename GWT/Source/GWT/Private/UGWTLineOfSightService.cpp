@@ -0,0 +1,132 @@
+// UGWTLineOfSightService.cpp
+// Implementation of the line-of-sight service
+
+#include "UGWTLineOfSightService.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+void UGWTLineOfSightService::Deinitialize()
+{
+    UE_LOG(LogTemp, Verbose, TEXT("Line of sight service shutting down with %d cached pairs"), Entries.Num());
+
+    Entries.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UGWTLineOfSightService::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UGWTLineOfSightService, STATGROUP_Tickables);
+}
+
+bool UGWTLineOfSightService::GetLineOfSight(AActor* Viewer, AActor* Target, bool& bOutVisible)
+{
+    bOutVisible = false;
+    if (!Viewer || !Target)
+    {
+        return false;
+    }
+
+    // Every enemy asking about the same player this frame shares one entry
+    FGWTSightEntry& Entry = Entries.FindOrAdd(FSightKey(FObjectKey(Viewer), FObjectKey(Target)));
+    if (!Entry.Viewer.IsValid())
+    {
+        Entry.Viewer = Viewer;
+        Entry.Target = Target;
+    }
+
+    // Tick refreshes anything asked about that has gone stale
+    Entry.RequestFrame = GFrameCounter;
+
+    // An answer kept from a request long ago is no answer, the refresh lands within a frame or two
+    bOutVisible = Entry.bVisible;
+    return Entry.bHasResult && GFrameCounter - Entry.ResultFrame <= (uint64)CacheFrames * 2;
+}
+
+void UGWTLineOfSightService::Tick(float DeltaTime)
+{
+    NumTracesLastTick = 0;
+    if (Entries.Num() == 0)
+    {
+        return;
+    }
+
+    const uint64 Frame = GFrameCounter;
+
+    // Collect last frame's traces, drop idle or dead pairs and issue the refreshes as one batch
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        FGWTSightEntry& Entry = It.Value();
+
+        if (!Entry.Viewer.IsValid() || !Entry.Target.IsValid() || Frame - Entry.RequestFrame > EvictFrames)
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+
+        if (!CollectResult(Entry, Frame))
+        {
+            continue;
+        }
+
+        const bool bStale = !Entry.bHasResult || Frame - Entry.ResultFrame >= (uint64)CacheFrames;
+        if (bStale && Entry.RequestFrame + 1 >= Frame)
+        {
+            IssueTrace(Entry);
+            NumTracesLastTick++;
+        }
+    }
+
+    if (NumTracesLastTick > 0)
+    {
+        UE_LOG(LogTemp, VeryVerbose, TEXT("Line of sight: issued %d traces for %d pairs"), NumTracesLastTick, Entries.Num());
+    }
+}
+
+bool UGWTLineOfSightService::CollectResult(FGWTSightEntry& Entry, uint64 Frame) const
+{
+    if (!Entry.PendingTrace.IsValid())
+    {
+        return true;
+    }
+
+    // Not done yet, a trace issued last frame normally is
+    FTraceDatum TraceDatum;
+    if (!GetWorld()->QueryTraceData(Entry.PendingTrace, TraceDatum))
+    {
+        if (!GetWorld()->IsTraceHandleValid(Entry.PendingTrace, false))
+        {
+            // The result was lost, trace again
+            Entry.PendingTrace = FTraceHandle();
+            return true;
+        }
+        return false;
+    }
+
+    // Visible when nothing blocks the way, or the first thing hit is the target itself
+    const AActor* Target = Entry.Target.Get();
+    const FHitResult* BlockingHit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+
+    Entry.bVisible = !BlockingHit || BlockingHit->GetActor() == Target;
+    Entry.bHasResult = true;
+    Entry.ResultFrame = Frame;
+    Entry.PendingTrace = FTraceHandle();
+    return true;
+}
+
+void UGWTLineOfSightService::IssueTrace(FGWTSightEntry& Entry) const
+{
+    const AActor* Viewer = Entry.Viewer.Get();
+    const AActor* Target = Entry.Target.Get();
+
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(GWTLineOfSight), false, Viewer);
+
+    Entry.PendingTrace = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single,
+        Viewer->GetActorLocation(), Target->GetActorLocation(), ECC_Visibility, QueryParams);
+}
+
+UGWTLineOfSightService* UGWTLineOfSightService::Get(const AActor* WorldContext)
+{
+    UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UGWTLineOfSightService>() : nullptr;
+}
\ No newline at end of file
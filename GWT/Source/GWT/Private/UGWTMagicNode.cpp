@@ -4,7 +4,7 @@
 #include "UGWTMagicNode.h"
 #include "UGWTSpellExecutionContext.h"
 #include "AGWTCharacter.h"
-#include "Kismet/GameplayStatics.h"
+#include "UGWTCharacterSpatialHash.h"
 
 UGWTMagicNode::UGWTMagicNode()
 {
@@ -26,67 +26,99 @@ UGWTMagicNode::UGWTMagicNode()
 }
 
 void UGWTMagicNode::Execute(UGWTSpellExecutionContext* Context)
+{
+    // Apply the magic payload, stop here if it had nothing to hit
+    if (!ApplyMagic(Context, ElementType, BaseDamage, Range))
+    {
+        return;
+    }
+
+    // Execute connected nodes
+    Super::Execute(Context);
+}
+
+bool UGWTMagicNode::CanApplyMagic(UGWTSpellExecutionContext* Context, float InRange)
+{
+    AActor* Target = nullptr;
+    return FindMagicTarget(Context, InRange, Target);
+}
+
+bool UGWTMagicNode::FindMagicTarget(UGWTSpellExecutionContext* Context, float InRange, AActor*& OutTarget)
 {
     // Check if context is valid
     if (!Context || !Context->Caster)
     {
         UE_LOG(LogTemp, Warning, TEXT("Cannot execute Magic node: Invalid context or caster"));
-        return;
+        return false;
     }
 
     // Get the target from the context or use the caster's current target
-    AActor* Target = Context->Target;
-    if (!Target)
+    EGWTSpellActor Which = EGWTSpellActor::Target;
+    FGWTSpellActorState TargetState = Context->ReadActor(Which);
+    if (!TargetState.IsValid())
     {
         // If no target in context, try to use hit result
-        if (Context->HitResult.GetActor())
-        {
-            Target = Context->HitResult.GetActor();
-        }
+        Which = EGWTSpellActor::HitActor;
+        TargetState = Context->ReadActor(Which);
     }
 
-    if (!Target)
+    if (!TargetState.IsValid())
     {
         UE_LOG(LogTemp, Warning, TEXT("Magic node execution failed: No target"));
-        return;
+        return false;
     }
 
     // Check if target is in range
-    float DistanceSquared = FVector::DistSquared(Context->Caster->GetActorLocation(), Target->GetActorLocation());
-    float RangeSquared = Range * Range;
+    float DistanceSquared = FVector::DistSquared(Context->ReadActor(EGWTSpellActor::Caster).Location, TargetState.Location);
+    float RangeSquared = InRange * InRange;
 
     if (DistanceSquared > RangeSquared)
     {
         UE_LOG(LogTemp, Warning, TEXT("Target is out of range for magic effect"));
-        return;
+        return false;
+    }
+
+    // Worker threads only learn that there is a target, the actor is fetched when the payload is applied
+    OutTarget = Context->WorldSnapshot ? nullptr : Context->GetActor(Which);
+    return true;
+}
+
+bool UGWTMagicNode::ApplyMagic(UGWTSpellExecutionContext* Context, EGWTElementType InElementType, float Damage, float InRange)
+{
+    // Writes the world, never from a sibling task on a worker thread
+    check(!Context || !Context->WorldSnapshot);
+
+    AActor* Target = nullptr;
+    if (!FindMagicTarget(Context, InRange, Target))
+    {
+        return false;
     }
 
     // Apply different effects based on element type
-    switch (ElementType)
+    switch (InElementType)
     {
     case EGWTElementType::Fire:
-        ApplyFireEffect(Target, BaseDamage, Context);
+        ApplyFireEffect(Target, Damage, Context);
         break;
 
     case EGWTElementType::Ice:
-        ApplyIceEffect(Target, BaseDamage, Context);
+        ApplyIceEffect(Target, Damage, Context);
         break;
 
     case EGWTElementType::Lightning:
-        ApplyLightningEffect(Target, BaseDamage, Context);
+        ApplyLightningEffect(Target, Damage, Context);
         break;
 
     default:
         // Generic damage for other element types
-        ApplyElementalEffect(Target, BaseDamage, Context);
+        ApplyElementalEffect(Target, InElementType, Damage, Context);
         break;
     }
 
     UE_LOG(LogTemp, Verbose, TEXT("Magic node executed with %s element, %f damage"),
-        *UEnum::GetValueAsString(ElementType), BaseDamage);
+        *UEnum::GetValueAsString(InElementType), Damage);
 
-    // Execute connected nodes
-    Super::Execute(Context);
+    return true;
 }
 
 EGWTSpellComponentType UGWTMagicNode::GetNodeType() const
@@ -106,20 +138,15 @@ void UGWTMagicNode::ApplyFireEffect(AActor* Target, float Damage, UGWTSpellExecu
     if (TargetCharacter)
     {
         // Apply direct damage
-        TargetCharacter->TakeDamage(Damage, EGWTElementType::Fire, Context->Caster);
+        Context->EffectCommands.AddDamage(TargetCharacter, Damage, EGWTElementType::Fire, Context->Caster);
 
         // Apply burning status effect
-        FGWTStatusEffect BurningEffect;
-        BurningEffect.EffectType = EGWTStatusEffectType::Burning;
-        BurningEffect.Duration = 5.0f;
-        BurningEffect.Strength = Damage * 0.2f; // DoT is 20% of initial damage per second
-        BurningEffect.Causer = Context->Caster;
-        BurningEffect.TimeRemaining = BurningEffect.Duration;
+        const float BurningStrength = Damage * 0.2f; // DoT is 20% of initial damage per second
+        const float BurningDuration = 5.0f;
+        Context->EffectCommands.AddStatus(TargetCharacter, EGWTStatusEffectType::Burning, BurningStrength, BurningDuration, Context->Caster);
 
-        TargetCharacter->ApplyStatusEffect(BurningEffect);
-
-        UE_LOG(LogTemp, Verbose, TEXT("Applied fire effect to %s, Damage: %f, Burning: %f damage for %f seconds"),
-            *Target->GetName(), Damage, BurningEffect.Strength, BurningEffect.Duration);
+        UE_LOG(LogTemp, Verbose, TEXT("Queued fire effect on %s, Damage: %f, Burning: %f damage for %f seconds"),
+            *Target->GetName(), Damage, BurningStrength, BurningDuration);
     }
 }
 
@@ -130,20 +157,15 @@ void UGWTMagicNode::ApplyIceEffect(AActor* Target, float Damage, UGWTSpellExecut
     if (TargetCharacter)
     {
         // Apply direct damage
-        TargetCharacter->TakeDamage(Damage, EGWTElementType::Ice, Context->Caster);
+        Context->EffectCommands.AddDamage(TargetCharacter, Damage, EGWTElementType::Ice, Context->Caster);
 
         // Apply frozen status effect
-        FGWTStatusEffect FrozenEffect;
-        FrozenEffect.EffectType = EGWTStatusEffectType::Frozen;
-        FrozenEffect.Duration = 3.0f;
-        FrozenEffect.Strength = 1.0f; // Slow effect (would be applied in character movement)
-        FrozenEffect.Causer = Context->Caster;
-        FrozenEffect.TimeRemaining = FrozenEffect.Duration;
-
-        TargetCharacter->ApplyStatusEffect(FrozenEffect);
+        const float FrozenStrength = 1.0f; // Slow effect (would be applied in character movement)
+        const float FrozenDuration = 3.0f;
+        Context->EffectCommands.AddStatus(TargetCharacter, EGWTStatusEffectType::Frozen, FrozenStrength, FrozenDuration, Context->Caster);
 
-        UE_LOG(LogTemp, Verbose, TEXT("Applied ice effect to %s, Damage: %f, Frozen for %f seconds"),
-            *Target->GetName(), Damage, FrozenEffect.Duration);
+        UE_LOG(LogTemp, Verbose, TEXT("Queued ice effect on %s, Damage: %f, Frozen for %f seconds"),
+            *Target->GetName(), Damage, FrozenDuration);
     }
 }
 
@@ -154,55 +176,46 @@ void UGWTMagicNode::ApplyLightningEffect(AActor* Target, float Damage, UGWTSpell
     if (TargetCharacter)
     {
         // Apply direct damage
-        TargetCharacter->TakeDamage(Damage, EGWTElementType::Lightning, Context->Caster);
+        Context->EffectCommands.AddDamage(TargetCharacter, Damage, EGWTElementType::Lightning, Context->Caster);
 
         // Apply electrified status effect
-        FGWTStatusEffect ElectrifiedEffect;
-        ElectrifiedEffect.EffectType = EGWTStatusEffectType::Electrified;
-        ElectrifiedEffect.Duration = 2.0f;
-        ElectrifiedEffect.Strength = Damage * 0.1f; // DoT is 10% of initial damage per second
-        ElectrifiedEffect.Causer = Context->Caster;
-        ElectrifiedEffect.TimeRemaining = ElectrifiedEffect.Duration;
-
-        TargetCharacter->ApplyStatusEffect(ElectrifiedEffect);
+        const float ElectrifiedStrength = Damage * 0.1f; // DoT is 10% of initial damage per second
+        const float ElectrifiedDuration = 2.0f;
+        Context->EffectCommands.AddStatus(TargetCharacter, EGWTStatusEffectType::Electrified, ElectrifiedStrength, ElectrifiedDuration, Context->Caster);
 
         // Chain lightning to nearby enemies
-        TArray<AActor*> NearbyActors;
-        UGameplayStatics::GetAllActorsOfClass(Target->GetWorld(), AGWTCharacter::StaticClass(), NearbyActors);
-
         int32 ChainCount = 0;
-        for (AActor* NearbyActor : NearbyActors)
+        if (UGWTCharacterSpatialHash* SpatialHash = UGWTCharacterSpatialHash::Get(Target))
         {
-            if (NearbyActor != Target && NearbyActor != Context->Caster)
+            FGWTSpatialQueryFilter Filter;
+            Filter.Ignored.Add(Target);
+            Filter.Ignored.Add(Context->Caster);
+
+            TArray<AGWTCharacter*> ChainTargets;
+            SpatialHash->QueryRadius(Target->GetActorLocation(), 300.0f, ChainTargets, Filter); // Chain effect range
+
+            for (AGWTCharacter* ChainTarget : ChainTargets)
             {
-                float ChainDistance = FVector::Dist(Target->GetActorLocation(), NearbyActor->GetActorLocation());
-                if (ChainDistance < 300.0f) // Chain effect range
-                {
-                    AGWTCharacter* ChainTarget = Cast<AGWTCharacter>(NearbyActor);
-                    if (ChainTarget)
-                    {
-                        // Apply reduced damage to chain targets
-                        ChainTarget->TakeDamage(Damage * 0.5f, EGWTElementType::Lightning, Context->Caster);
-                        ChainCount++;
-                    }
-                }
+                // Apply reduced damage to chain targets
+                Context->EffectCommands.AddDamage(ChainTarget, Damage * 0.5f, EGWTElementType::Lightning, Context->Caster);
+                ChainCount++;
             }
         }
 
-        UE_LOG(LogTemp, Verbose, TEXT("Applied lightning effect to %s, Damage: %f, Electrified: %f damage for %f seconds, Chained to %d enemies"),
-            *Target->GetName(), Damage, ElectrifiedEffect.Strength, ElectrifiedEffect.Duration, ChainCount);
+        UE_LOG(LogTemp, Verbose, TEXT("Queued lightning effect on %s, Damage: %f, Electrified: %f damage for %f seconds, Chained to %d enemies"),
+            *Target->GetName(), Damage, ElectrifiedStrength, ElectrifiedDuration, ChainCount);
     }
 }
 
-void UGWTMagicNode::ApplyElementalEffect(AActor* Target, float Damage, UGWTSpellExecutionContext* Context)
+void UGWTMagicNode::ApplyElementalEffect(AActor* Target, EGWTElementType InElementType, float Damage, UGWTSpellExecutionContext* Context)
 {
     // Apply generic elemental damage
     AGWTCharacter* TargetCharacter = Cast<AGWTCharacter>(Target);
     if (TargetCharacter)
     {
-        TargetCharacter->TakeDamage(Damage, ElementType, Context->Caster);
+        Context->EffectCommands.AddDamage(TargetCharacter, Damage, InElementType, Context->Caster);
 
-        UE_LOG(LogTemp, Verbose, TEXT("Applied %s damage to %s: %f damage"),
-            *UEnum::GetValueAsString(ElementType), *Target->GetName(), Damage);
+        UE_LOG(LogTemp, Verbose, TEXT("Queued %s damage on %s: %f damage"),
+            *UEnum::GetValueAsString(InElementType), *Target->GetName(), Damage);
     }
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "GWTLevelGenerator.h"
 #include "GWTRoom.h"
 #include "GWTPlayerCharacter.h"
+#include "AGWTCharacter.h"
 #include "Components/CanvasPanel.h"
 #include "Components/CanvasPanelSlot.h"
 #include "Components/Border.h"
@@ -83,11 +84,11 @@ void UGWTMiniMapWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTim
 {
     Super::NativeTick(MyGeometry, InDeltaTime);
 
-    // Update player position on the map
-    APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
-    if (PlayerPawn)
+    // Rooms track their occupants, so the marker only moves when the player's room changes
+    const AGWTCharacter* PlayerCharacter = Cast<AGWTCharacter>(UGameplayStatics::GetPlayerPawn(GetWorld(), 0));
+    if (PlayerCharacter && PlayerCharacter->CurrentRoom && PlayerCharacter->CurrentRoom != CurrentRoom)
     {
-        UpdatePlayerPosition(PlayerPawn->GetActorLocation());
+        UpdatePlayerPosition(PlayerCharacter->CurrentRoom->GetActorLocation());
     }
 }
 
@@ -112,6 +113,9 @@ void UGWTMiniMapWidget::UpdateMap()
     // Create room widgets
     CreateRoomWidgets();
 
+    // Let the next tick place the player marker on the rebuilt map
+    CurrentRoom = nullptr;
+
     UE_LOG(LogTemp, Verbose, TEXT("Mini-map updated"));
 }
 
@@ -418,12 +422,12 @@ FIntVector UGWTMiniMapWidget::WorldToGridPosition(const FVector& WorldPosition)
         return FIntVector(0, 0, 0);
     }
 
-    // Use room size to calculate grid position
-    float WorldRoomSize = LevelGenerator->RoomSize;
+    // Same mapping the rooms were spawned with
+    const FIntVector GridPos = LevelGenerator->WorldToGridPosition(WorldPosition);
 
-    int32 X = FMath::Floor(WorldPosition.X / WorldRoomSize);
-    int32 Y = FMath::Floor(WorldPosition.Y / WorldRoomSize);
-    int32 Z = FMath::Floor(WorldPosition.Z / WorldRoomSize);
+    int32 X = GridPos.X;
+    int32 Y = GridPos.Y;
+    int32 Z = GridPos.Z;
 
     // Clamp to grid bounds
     X = FMath::Clamp(X, 0, LevelGenerator->GridSizeX - 1);
@@ -3,6 +3,7 @@
 
 #include "UGWTPlayerProgression.h"
 #include "UGWTGrimoire.h"
+#include "AGWTCharacter.h"
 #include "UGWTSpellNode.h"
 #include "UGWTMagicNode.h"
 #include "UGWTTriggerNode.h"
@@ -204,6 +205,12 @@ bool UGWTPlayerProgression::SpendSkillPoint(EGWTSkillTreeCategory Category)
     SkillLevels[Category] = CurrentLevel + 1;
     SkillPoints--;
 
+    // Skills can change spell costs, let the owning character's cached costs refresh
+    if (AGWTCharacter* OwnerCharacter = GetTypedOuter<AGWTCharacter>())
+    {
+        OwnerCharacter->MarkManaCostChanged();
+    }
+
     UE_LOG(LogTemp, Display, TEXT("Spent skill point on %d. New level: %d, Remaining points: %d"),
         (int32)Category, SkillLevels[Category], SkillPoints);
 
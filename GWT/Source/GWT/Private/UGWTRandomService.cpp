@@ -0,0 +1,119 @@
+// UGWTRandomService.cpp
+// Implementation of the deterministic random service
+
+#include "UGWTRandomService.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Crc.h"
+
+void UGWTRandomService::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // A fixed seed replays a match exactly, otherwise pick one and log it so a session can be reproduced
+    uint64 Seed = 0;
+    if (!FParse::Value(FCommandLine::Get(), TEXT("GWTSeed="), Seed))
+    {
+        Seed = FPlatformTime::Cycles64() ^ ((uint64)FPlatformProcess::GetCurrentProcessId() << 32);
+    }
+
+    SetMatchSeed(Seed);
+}
+
+void UGWTRandomService::SetMatchSeed(uint64 InSeed)
+{
+    MatchSeed = InSeed;
+    CastCounters.Empty();
+
+    UE_LOG(LogTemp, Display, TEXT("Match seed: %llu"), MatchSeed);
+}
+
+uint32 UGWTRandomService::NextCastID(const AActor* Caster)
+{
+    return CastCounters.FindOrAdd(Caster)++;
+}
+
+float UGWTRandomService::FRand(const FGWTRandomKey& Key) const
+{
+    return ToUnitFloat(MatchSeed, Key);
+}
+
+float UGWTRandomService::FRandRange(const FGWTRandomKey& Key, float Min, float Max) const
+{
+    return Min + (Max - Min) * FRand(Key);
+}
+
+int32 UGWTRandomService::RandRange(const FGWTRandomKey& Key, int32 Min, int32 Max) const
+{
+    // Inclusive range like FMath::RandRange
+    const int32 Range = Max - Min + 1;
+    return Range > 0 ? Min + FMath::Min(FMath::FloorToInt(FRand(Key) * Range), Range - 1) : Min;
+}
+
+UGWTRandomService* UGWTRandomService::Get(const UObject* WorldContext)
+{
+    UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UGWTRandomService>() : nullptr;
+}
+
+float UGWTRandomService::FRand(const UObject* WorldContext, const FGWTRandomKey& Key)
+{
+    const UGWTRandomService* Service = Get(WorldContext);
+    return ToUnitFloat(Service ? Service->MatchSeed : 0, Key);
+}
+
+uint32 UGWTRandomService::GetStreamID(const UObject* Object)
+{
+    // Full path, so two components with the same name on different actors still get their own streams
+    return Object ? FCrc::StrCrc32(*Object->GetPathName()) : 0;
+}
+
+void UGWTRandomService::Philox4x32(const uint32 Counter[4], uint64 Key, uint32 OutWords[4])
+{
+    // Constants from Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3"
+    const uint32 Multiplier0 = 0xD2511F53;
+    const uint32 Multiplier1 = 0xCD9E8D57;
+    const uint32 Weyl0 = 0x9E3779B9;
+    const uint32 Weyl1 = 0xBB67AE85;
+
+    uint32 C0 = Counter[0];
+    uint32 C1 = Counter[1];
+    uint32 C2 = Counter[2];
+    uint32 C3 = Counter[3];
+    uint32 K0 = (uint32)Key;
+    uint32 K1 = (uint32)(Key >> 32);
+
+    for (int32 Round = 0; Round < 10; Round++)
+    {
+        const uint64 Product0 = (uint64)Multiplier0 * C0;
+        const uint64 Product1 = (uint64)Multiplier1 * C2;
+
+        const uint32 NewC0 = (uint32)(Product1 >> 32) ^ C1 ^ K0;
+        const uint32 NewC1 = (uint32)Product1;
+        const uint32 NewC2 = (uint32)(Product0 >> 32) ^ C3 ^ K1;
+        const uint32 NewC3 = (uint32)Product0;
+
+        C0 = NewC0;
+        C1 = NewC1;
+        C2 = NewC2;
+        C3 = NewC3;
+
+        K0 += Weyl0;
+        K1 += Weyl1;
+    }
+
+    OutWords[0] = C0;
+    OutWords[1] = C1;
+    OutWords[2] = C2;
+    OutWords[3] = C3;
+}
+
+float UGWTRandomService::ToUnitFloat(uint64 Seed, const FGWTRandomKey& Key)
+{
+    const uint32 Counter[4] = { (uint32)Key.Domain, Key.Stream, Key.Index, Key.SubIndex };
+    uint32 Words[4];
+    Philox4x32(Counter, Seed, Words);
+
+    // Top 24 bits, exactly representable as a float below 1
+    return (Words[0] >> 8) * (1.0f / 16777216.0f);
+}
\ No newline at end of file
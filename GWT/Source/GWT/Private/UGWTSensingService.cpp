@@ -0,0 +1,296 @@
+// UGWTSensingService.cpp
+// Implementation of the sensing service
+
+#include "UGWTSensingService.h"
+#include "AGWTEnemyCharacter.h"
+#include "AGWTPlayerCharacter.h"
+#include "UGWTCharacterSpatialHash.h"
+#include "UGWTLineOfSightService.h"
+#include "UGWTEnemyAIManager.h"
+#include "Engine/World.h"
+
+void UGWTSensingService::Deinitialize()
+{
+    UE_LOG(LogTemp, Verbose, TEXT("Sensing service shutting down with %d enemies"), SenseStates.Num());
+
+    SenseStates.Empty();
+    StateIndices.Empty();
+    PendingNoises.Empty();
+    PendingHearings.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UGWTSensingService::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UGWTSensingService, STATGROUP_Tickables);
+}
+
+void UGWTSensingService::RegisterEnemy(AGWTEnemyCharacter* Enemy)
+{
+    if (!Enemy || StateIndices.Contains(Enemy))
+    {
+        return;
+    }
+
+    // Spread first looks over a second so a wave does not sense all at once
+    FGWTSenseState& State = SenseStates.AddDefaulted_GetRef();
+    State.Enemy = Enemy;
+    State.TimeUntilSense = (SenseStates.Num() % 60) / 60.0f;
+
+    StateIndices.Add(Enemy, SenseStates.Num() - 1);
+    MaxHearingRange = FMath::Max(MaxHearingRange, Enemy->LOSHearingThreshold);
+}
+
+void UGWTSensingService::UnregisterEnemy(AGWTEnemyCharacter* Enemy)
+{
+    int32 Index;
+    if (!StateIndices.RemoveAndCopyValue(Enemy, Index))
+    {
+        return;
+    }
+
+    SenseStates.RemoveAtSwap(Index, 1, false);
+    if (SenseStates.IsValidIndex(Index))
+    {
+        StateIndices.Add(SenseStates[Index].Enemy, Index);
+    }
+}
+
+void UGWTSensingService::ReportNoise(APawn* Instigator, const FVector& Location, float Loudness)
+{
+    if (!Instigator || Loudness <= 0.0f)
+    {
+        return;
+    }
+
+    FGWTNoiseEvent& Noise = PendingNoises.AddDefaulted_GetRef();
+    Noise.Instigator = Instigator;
+    Noise.Location = Location;
+    Noise.Loudness = Loudness;
+}
+
+UGWTSensingService* UGWTSensingService::Get(const AActor* WorldContext)
+{
+    UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UGWTSensingService>() : nullptr;
+}
+
+void UGWTSensingService::Tick(float DeltaTime)
+{
+    ResolvePendingHearings(DeltaTime);
+    DeliverNoises();
+
+    NumSightChecksLastTick = 0;
+    const int32 NumStates = SenseStates.Num();
+    if (NumStates == 0)
+    {
+        return;
+    }
+
+    for (FGWTSenseState& State : SenseStates)
+    {
+        State.TimeUntilSense -= DeltaTime;
+    }
+
+    // Spend the budget on due enemies, starting where the last tick stopped
+    int32 Step = 0;
+    for (; Step < NumStates && NumSightChecksLastTick < MaxSightChecksPerTick; Step++)
+    {
+        FGWTSenseState& State = SenseStates[(NextSightIndex + Step) % NumStates];
+        if (State.TimeUntilSense > 0.0f || !State.Enemy)
+        {
+            continue;
+        }
+
+        // Dormant enemies look again once woken
+        const EGWTAILOD LOD = State.Enemy->AILOD;
+        State.TimeUntilSense = UGWTEnemyAIManager::GetLODSettings(LOD).SensingInterval;
+        if (LOD == EGWTAILOD::Dormant)
+        {
+            continue;
+        }
+
+        UpdateSight(State);
+        NumSightChecksLastTick++;
+    }
+
+    NextSightIndex = (NextSightIndex + Step) % NumStates;
+}
+
+void UGWTSensingService::UpdateSight(FGWTSenseState& State)
+{
+    AGWTEnemyCharacter* Enemy = State.Enemy;
+
+    UGWTCharacterSpatialHash* SpatialHash = GetWorld()->GetSubsystem<UGWTCharacterSpatialHash>();
+    UGWTLineOfSightService* LineOfSight = GetWorld()->GetSubsystem<UGWTLineOfSightService>();
+    if (!SpatialHash || !LineOfSight)
+    {
+        return;
+    }
+
+    // Only the few players within sight range are candidates
+    FGWTSpatialQueryFilter Filter;
+    Filter.Class = AGWTPlayerCharacter::StaticClass();
+
+    TArray<AGWTCharacter*> Candidates;
+    SpatialHash->QueryRadius(Enemy->GetActorLocation(), Enemy->DetectionRadius, Candidates, Filter);
+
+    TArray<TWeakObjectPtr<APawn>, TInlineAllocator<2>> NowVisible;
+    bool bAwaitingTrace = false;
+
+    for (AGWTCharacter* Candidate : Candidates)
+    {
+        if (!IsInSightCone(Enemy, Candidate->GetActorLocation()))
+        {
+            continue;
+        }
+
+        bool bVisible = false;
+        if (!LineOfSight->GetLineOfSight(Enemy, Candidate, bVisible))
+        {
+            // The cached result is older than the sensing interval, a player already in view stays seen until the new trace lands
+            if (State.VisiblePlayers.Contains(Candidate))
+            {
+                NowVisible.Add(Candidate);
+            }
+            bAwaitingTrace = true;
+            continue;
+        }
+
+        if (bVisible)
+        {
+            NowVisible.Add(Candidate);
+        }
+    }
+
+    // Players that drop out of sight are forgotten, so seeing them again is news
+    Swap(State.VisiblePlayers, NowVisible);
+    for (const TWeakObjectPtr<APawn>& Player : State.VisiblePlayers)
+    {
+        if (!NowVisible.Contains(Player))
+        {
+            Enemy->OnSeePlayer(Player.Get());
+        }
+    }
+
+    // A first trace lands next tick, look again then rather than a whole interval later
+    if (bAwaitingTrace)
+    {
+        State.TimeUntilSense = 0.0f;
+    }
+}
+
+void UGWTSensingService::DeliverNoises()
+{
+    if (PendingNoises.Num() == 0)
+    {
+        return;
+    }
+
+    UGWTCharacterSpatialHash* SpatialHash = GetWorld()->GetSubsystem<UGWTCharacterSpatialHash>();
+    UGWTLineOfSightService* LineOfSight = GetWorld()->GetSubsystem<UGWTLineOfSightService>();
+
+    FGWTSpatialQueryFilter Filter;
+    Filter.Class = AGWTEnemyCharacter::StaticClass();
+
+    TArray<AGWTCharacter*> Listeners;
+    for (const FGWTNoiseEvent& Noise : PendingNoises)
+    {
+        APawn* Instigator = Noise.Instigator.Get();
+        if (!Instigator || !SpatialHash)
+        {
+            continue;
+        }
+
+        Filter.Ignored.Reset();
+        Filter.Ignored.Add(Instigator);
+        SpatialHash->QueryRadius(Noise.Location, MaxHearingRange * Noise.Loudness, Listeners, Filter);
+
+        for (AGWTCharacter* Listener : Listeners)
+        {
+            AGWTEnemyCharacter* Enemy = static_cast<AGWTEnemyCharacter*>(Listener);
+            if (Enemy->AILOD == EGWTAILOD::Dormant || !StateIndices.Contains(Enemy))
+            {
+                continue;
+            }
+
+            // Heard through walls up to the hearing threshold
+            const float Distance = FVector::Dist(Enemy->GetActorLocation(), Noise.Location);
+            if (Distance <= Enemy->HearingThreshold * Noise.Loudness)
+            {
+                Enemy->OnHearNoise(Instigator, Noise.Location, Noise.Loudness);
+                continue;
+            }
+
+            // Further only with a clear line, the pair is rarely traced already so the noise waits for its trace
+            if (Distance <= Enemy->LOSHearingThreshold * Noise.Loudness && LineOfSight &&
+                !TryHearWithLineOfSight(LineOfSight, Enemy, Noise))
+            {
+                FGWTPendingHearing& Hearing = PendingHearings.AddDefaulted_GetRef();
+                Hearing.Enemy = Enemy;
+                Hearing.Noise = Noise;
+                Hearing.TimeRemaining = HearingTraceTimeout;
+            }
+        }
+    }
+
+    PendingNoises.Reset();
+}
+
+void UGWTSensingService::ResolvePendingHearings(float DeltaTime)
+{
+    if (PendingHearings.Num() == 0)
+    {
+        return;
+    }
+
+    UGWTLineOfSightService* LineOfSight = GetWorld()->GetSubsystem<UGWTLineOfSightService>();
+    for (int32 i = PendingHearings.Num() - 1; i >= 0; i--)
+    {
+        FGWTPendingHearing& Hearing = PendingHearings[i];
+        Hearing.TimeRemaining -= DeltaTime;
+
+        AGWTEnemyCharacter* Enemy = Hearing.Enemy.Get();
+        const bool bListening = Enemy && Enemy->AILOD != EGWTAILOD::Dormant && StateIndices.Contains(Enemy);
+        if (!bListening || !LineOfSight || TryHearWithLineOfSight(LineOfSight, Enemy, Hearing.Noise) || Hearing.TimeRemaining <= 0.0f)
+        {
+            PendingHearings.RemoveAtSwap(i, 1, false);
+        }
+    }
+}
+
+bool UGWTSensingService::TryHearWithLineOfSight(UGWTLineOfSightService* LineOfSight, AGWTEnemyCharacter* Enemy, const FGWTNoiseEvent& Noise)
+{
+    // A gone instigator leaves nothing to trace to, the noise is settled unheard
+    APawn* Instigator = Noise.Instigator.Get();
+    if (!Instigator)
+    {
+        return true;
+    }
+
+    bool bVisible = false;
+    if (!LineOfSight->GetLineOfSight(Enemy, Instigator, bVisible))
+    {
+        return false;
+    }
+
+    if (bVisible)
+    {
+        Enemy->OnHearNoise(Instigator, Noise.Location, Noise.Loudness);
+    }
+    return true;
+}
+
+bool UGWTSensingService::IsInSightCone(const AGWTEnemyCharacter* Enemy, const FVector& PlayerLocation)
+{
+    const FVector ToPlayer = PlayerLocation - Enemy->GetActorLocation();
+    if (ToPlayer.SizeSquared() > FMath::Square(Enemy->DetectionRadius))
+    {
+        return false;
+    }
+
+    // The vision angle is measured either side of the facing direction
+    const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(Enemy->PeripheralVisionAngle));
+    return FVector::DotProduct(ToPlayer.GetSafeNormal(), Enemy->GetActorForwardVector()) >= CosHalfAngle;
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+// UGWTSpawnQueue.cpp
+// Implementation of the spawn queue
+
+#include "UGWTSpawnQueue.h"
+#include "UGWTEnemySpawner.h"
+#include "AGWTRoom.h"
+#include "AGWTLevelGenerator.h"
+#include "AGWTGameState.h"
+#include "AGWTPlayerCharacter.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformTime.h"
+
+void UGWTSpawnQueue::Deinitialize()
+{
+    UE_LOG(LogTemp, Display, TEXT("Spawn queue: %d spawned, peak depth %d, latency %.2fs average %.2fs max"),
+        NumSpawned, PeakQueueDepth, GetAverageLatency(), MaxLatency);
+
+    Requests.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UGWTSpawnQueue::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UGWTSpawnQueue, STATGROUP_Tickables);
+}
+
+void UGWTSpawnQueue::EnqueueRoom(AGWTRoom* Room, int32 WaveNumber, int32 Count)
+{
+    if (!Room || Count <= 0)
+    {
+        return;
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    for (int32 i = 0; i < Count; i++)
+    {
+        FGWTSpawnRequest& Request = Requests.AddDefaulted_GetRef();
+        Request.Room = Room;
+        Request.WaveNumber = WaveNumber;
+        Request.EnqueueTime = Now;
+        Request.Sequence = NextSequence++;
+    }
+
+    PeakQueueDepth = FMath::Max(PeakQueueDepth, Requests.Num());
+
+    UE_LOG(LogTemp, Verbose, TEXT("Queued %d enemies for room (%d, %d, %d), queue depth %d"),
+        Count, Room->GridPosition.X, Room->GridPosition.Y, Room->GridPosition.Z, Requests.Num());
+}
+
+UGWTSpawnQueue* UGWTSpawnQueue::Get(const AActor* WorldContext)
+{
+    UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UGWTSpawnQueue>() : nullptr;
+}
+
+void UGWTSpawnQueue::Tick(float DeltaTime)
+{
+    NumSpawnedLastTick = 0;
+    MillisecondsLastTick = 0.0f;
+    if (Requests.Num() == 0)
+    {
+        return;
+    }
+
+    UGWTEnemySpawner* EnemySpawner = Spawner.Get();
+    if (!EnemySpawner)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Spawn queue has no spawner, dropping %d requests"), Requests.Num());
+        Requests.Reset();
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    PrioritizeRequests();
+
+    // Nearest first until the budget is spent, always at least one
+    int32 NumTaken = 0;
+    while (NumTaken < Requests.Num())
+    {
+        if (NumTaken > 0 && (FPlatformTime::Seconds() - StartTime) * 1000.0 >= FrameBudgetMs)
+        {
+            break;
+        }
+
+        const FGWTSpawnRequest& Request = Requests[NumTaken++];
+
+        // Rooms are torn down when a new level is generated, their requests go with them
+        AGWTRoom* Room = Request.Room.Get();
+        if (!Room)
+        {
+            continue;
+        }
+
+        if (EnemySpawner->SpawnEnemyInRoom(Room, Request.WaveNumber))
+        {
+            const float Latency = (float)(Now - Request.EnqueueTime);
+            TotalLatency += Latency;
+            MaxLatency = FMath::Max(MaxLatency, Latency);
+            NumSpawned++;
+            NumSpawnedLastTick++;
+        }
+    }
+
+    Requests.RemoveAt(0, NumTaken, false);
+    MillisecondsLastTick = (float)((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+    UE_LOG(LogTemp, VeryVerbose, TEXT("Spawn queue: %d spawned in %.2fms, %d waiting"),
+        NumSpawnedLastTick, MillisecondsLastTick, Requests.Num());
+}
+
+void UGWTSpawnQueue::PrioritizeRequests()
+{
+    if (!LevelGenerator.IsValid())
+    {
+        TActorIterator<AGWTLevelGenerator> It(GetWorld());
+        LevelGenerator = It ? *It : nullptr;
+    }
+
+    // Door steps from every player's room, without players or a room graph the queue stays in order
+    TMap<const AGWTRoom*, int32> RoomDistances;
+    AGWTGameState* GWTGameState = GetWorld()->GetGameState<AGWTGameState>();
+    if (LevelGenerator.IsValid() && GWTGameState)
+    {
+        TArray<const AGWTRoom*> PlayerRooms;
+        for (const AGWTPlayerCharacter* Player : GWTGameState->GetLivePlayers())
+        {
+            const AGWTRoom* Room = Player->CurrentRoom ? Player->CurrentRoom : LevelGenerator->GetRoomAtLocation(Player->GetActorLocation());
+            if (Room)
+            {
+                PlayerRooms.AddUnique(Room);
+            }
+        }
+
+        const int32 MaxDistance = LevelGenerator->GridSizeX * LevelGenerator->GridSizeY * LevelGenerator->GridSizeZ;
+        LevelGenerator->GetRoomDistances(PlayerRooms, MaxDistance, RoomDistances);
+    }
+
+    for (FGWTSpawnRequest& Request : Requests)
+    {
+        const int32* Distance = RoomDistances.Find(Request.Room.Get());
+        Request.RoomDistance = Distance ? *Distance : MAX_int32;
+    }
+
+    Requests.Sort([](const FGWTSpawnRequest& A, const FGWTSpawnRequest& B)
+    {
+        return A.RoomDistance != B.RoomDistance ? A.RoomDistance < B.RoomDistance : A.Sequence < B.Sequence;
+    });
+}
\ No newline at end of file
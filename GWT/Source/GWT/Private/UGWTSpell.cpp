@@ -5,6 +5,13 @@
 #include "UGWTSpellNode.h"
 #include "UGWTMagicNode.h"
 #include "UGWTSpellExecutionContext.h"
+#include "UGWTSpellContextPool.h"
+#include "FGWTSpellCompiler.h"
+#include "FGWTSpellProgramCache.h"
+#include "FGWTSpellOptimizer.h"
+#include "FGWTSpellSerializer.h"
+#include "FGWTSpellVM.h"
+#include "UGWTSpellScheduler.h"
 #include "AGWTCharacter.h"
 #include "Serialization/MemoryWriter.h"
 #include "Serialization/MemoryReader.h"
@@ -32,16 +39,23 @@ void UGWTSpell::Cast(AActor* Caster, AActor* Target)
         return;
     }
 
-    // Create execution context
-    UGWTSpellExecutionContext* Context = NewObject<UGWTSpellExecutionContext>(this);
-    Context->Caster = Caster;
-    Context->Target = Target;
+    // Make sure the graph is compiled before any mana is spent
+    if (bProgramDirty)
+    {
+        CompileSpell();
+    }
+
+    if (!CompiledProgram.IsValid() && !bUseNodeExecution)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot cast spell: Compilation failed"));
+        return;
+    }
 
     // Check mana cost
     AGWTCharacter* CasterCharacter = Cast<AGWTCharacter>(Caster);
     if (CasterCharacter)
     {
-        float ManaCost = CalculateManaCost();
+        float ManaCost = GetFinalManaCost(Caster);
         if (CasterCharacter->CurrentMana < ManaCost)
         {
             UE_LOG(LogTemp, Warning, TEXT("Cannot cast spell: Not enough mana (%.1f/%.1f)"),
@@ -55,27 +69,74 @@ void UGWTSpell::Cast(AActor* Caster, AActor* Target)
         UE_LOG(LogTemp, Verbose, TEXT("Consumed %.1f mana to cast spell"), ManaCost);
     }
 
+    // Take a context from the world's pool, spells cast outside a game world get a one-off
+    UGWTSpellContextPool* ContextPool = UGWTSpellContextPool::Get(Caster);
+    UGWTSpellExecutionContext* Context = nullptr;
+    if (ContextPool)
+    {
+        Context = ContextPool->Acquire(Caster, Target);
+    }
+    else
+    {
+        Context = NewObject<UGWTSpellExecutionContext>(this);
+        Context->Caster = Caster;
+        Context->Target = Target;
+    }
+
     UE_LOG(LogTemp, Display, TEXT("Casting spell: %s"), *SpellName.ToString());
 
-    // Execute all root nodes
-    for (UGWTSpellNode* RootNode : RootNodes)
+    UGWTSpellScheduler* Scheduler = ContextPool ? UGWTSpellScheduler::Get(Caster) : nullptr;
+    if (CompiledProgram.IsValid() && Scheduler)
+    {
+        // The scheduler owns the cast from here, including returning the context
+        Scheduler->StartCast(CompiledProgram, Context, Diagnostics);
+
+        UE_LOG(LogTemp, Display, TEXT("Spell cast started: %s"), *SpellName.ToString());
+        return;
+    }
+
+    if (CompiledProgram.IsValid())
+    {
+        // No world to wait in, run the whole program now
+        FGWTSpellTask Task(CompiledProgram, Context);
+        Task.Diagnostics = Diagnostics;
+        FGWTSpellVM::Run(Task, 0.0, false);
+    }
+    else
     {
-        if (RootNode)
+        // Execute all root nodes
+        for (UGWTSpellNode* RootNode : RootNodes)
         {
-            UE_LOG(LogTemp, Verbose, TEXT("Executing root node: %s"), *RootNode->NodeTitle.ToString());
-            RootNode->Execute(Context);
+            if (RootNode)
+            {
+                UE_LOG(LogTemp, Verbose, TEXT("Executing root node: %s"), *RootNode->NodeTitle.ToString());
+                RootNode->Execute(Context);
+            }
         }
     }
 
+    // Hand the context back for the next cast, the pool applies its pending effects
+    if (ContextPool)
+    {
+        ContextPool->Release(Context);
+    }
+    else
+    {
+        Context->EffectCommands.Flush();
+    }
+
     UE_LOG(LogTemp, Display, TEXT("Spell cast complete: %s"), *SpellName.ToString());
 }
 
 void UGWTSpell::AddNode(UGWTSpellNode* Node)
 {
     // Add a node to the spell
-    if (Node && !AllNodes.Contains(Node))
+    SyncNodeLookup();
+    if (Node && !NodeLookup.Contains(Node))
     {
         AllNodes.Add(Node);
+        NodeLookup.Add(Node);
+        Node->OwningSpell = this;
 
         // Check if this is a root node (no inputs)
         if (Node->InputNodes.Num() == 0)
@@ -84,9 +145,8 @@ void UGWTSpell::AddNode(UGWTSpellNode* Node)
             UE_LOG(LogTemp, Verbose, TEXT("Added root node: %s"), *Node->NodeTitle.ToString());
         }
 
-        // Update spell stats
-        CalculateManaCost();
-        CalculateBaseDamage();
+        // Stats and program are rebuilt lazily for the new version
+        MarkGraphChanged();
 
         UE_LOG(LogTemp, Verbose, TEXT("Added node to spell: %s"), *Node->NodeTitle.ToString());
     }
@@ -95,7 +155,8 @@ void UGWTSpell::AddNode(UGWTSpellNode* Node)
 void UGWTSpell::RemoveNode(UGWTSpellNode* Node)
 {
     // Remove a node from the spell
-    if (Node && AllNodes.Contains(Node))
+    SyncNodeLookup();
+    if (Node && NodeLookup.Contains(Node))
     {
         // Disconnect all connections
         TArray<UGWTSpellNode*> InputNodesCopy = Node->InputNodes;
@@ -122,10 +183,11 @@ void UGWTSpell::RemoveNode(UGWTSpellNode* Node)
         // Remove from collections
         AllNodes.Remove(Node);
         RootNodes.Remove(Node);
+        NodeLookup.Remove(Node);
+        Node->OwningSpell = nullptr;
 
-        // Update spell stats
-        CalculateManaCost();
-        CalculateBaseDamage();
+        // Stats and program are rebuilt lazily for the new version
+        MarkGraphChanged();
 
         UE_LOG(LogTemp, Verbose, TEXT("Removed node from spell: %s"), *Node->NodeTitle.ToString());
     }
@@ -133,85 +195,152 @@ void UGWTSpell::RemoveNode(UGWTSpellNode* Node)
 
 bool UGWTSpell::ValidateSpell()
 {
-    // Check if the spell has any nodes
-    if (AllNodes.Num() == 0)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("Spell validation failed: No nodes"));
-        return false;
-    }
+    // Validation only changes when the graph does
+    return GetCachedStats().bValid;
+}
 
-    // Check if it has any root nodes
-    if (RootNodes.Num() == 0)
+float UGWTSpell::CalculateManaCost()
+{
+    // Cached per graph version
+    TotalManaCost = GetCachedStats().ManaCost;
+    return TotalManaCost;
+}
+
+float UGWTSpell::CalculateBaseDamage()
+{
+    // Cached per graph version
+    BaseDamage = GetCachedStats().BaseDamage;
+    return BaseDamage;
+}
+
+float UGWTSpell::GetFinalManaCost(AActor* Caster)
+{
+    const float ManaCost = CalculateManaCost();
+
+    // Only characters carry equipment and skills
+    AGWTCharacter* CasterCharacter = Cast<AGWTCharacter>(Caster);
+    if (!CasterCharacter)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Spell validation failed: No root nodes"));
-        return false;
+        return ManaCost;
     }
 
-    // Validate each node's connections
-    bool bAllNodesValid = true;
-    for (UGWTSpellNode* Node : AllNodes)
+    // Drop entries for casters that are gone before the map grows
+    if (CasterManaCosts.Num() >= 16 && !CasterManaCosts.Contains(Caster))
     {
-        if (Node && !Node->ValidateConnections())
+        for (auto It = CasterManaCosts.CreateIterator(); It; ++It)
         {
-            UE_LOG(LogTemp, Warning, TEXT("Node validation failed: %s"), *Node->NodeTitle.ToString());
-            bAllNodesValid = false;
+            if (!It.Key().IsValid())
+            {
+                It.RemoveCurrent();
+            }
         }
     }
 
-    UE_LOG(LogTemp, Verbose, TEXT("Spell validation result: %s"), bAllNodesValid ? TEXT("Valid") : TEXT("Invalid"));
+    // Reuse the last cost while neither the spell nor the caster's multipliers changed
+    FGWTCasterManaCost& CasterCost = CasterManaCosts.FindOrAdd(Caster);
+    if (CasterCost.GraphVersion != GraphVersion || CasterCost.CasterVersion != CasterCharacter->GetManaCostVersion())
+    {
+        CasterCost.GraphVersion = GraphVersion;
+        CasterCost.CasterVersion = CasterCharacter->GetManaCostVersion();
+        CasterCost.ManaCost = ManaCost * CasterCharacter->GetManaCostMultiplier();
 
-    return bAllNodesValid;
+        UE_LOG(LogTemp, Verbose, TEXT("Final mana cost of %s for %s: %.1f"),
+            *SpellName.ToString(), *CasterCharacter->GetName(), CasterCost.ManaCost);
+    }
+
+    return CasterCost.ManaCost;
 }
 
-float UGWTSpell::CalculateManaCost()
+void UGWTSpell::MarkGraphChanged()
 {
-    // Calculate total mana cost of the spell
-    float ManaCost = 0.0f;
+    // Everything derived from the graph is keyed on this
+    GraphVersion++;
+    InvalidateCompiledProgram();
+}
+
+const FGWTSpellStatsCache& UGWTSpell::GetCachedStats() const
+{
+    if (StatsCache.Version == GraphVersion)
+    {
+        return StatsCache;
+    }
+
+    FGWTSpellStatsCache& Stats = StatsCache;
+    Stats = FGWTSpellStatsCache();
+    Stats.Version = GraphVersion;
+    Stats.bValid = ValidateGraph();
 
-    // Sum up costs from all magic nodes
+    // Counts, per-type lists and damage from every node in the spell
     for (UGWTSpellNode* Node : AllNodes)
     {
-        UGWTMagicNode* MagicNode = Cast<UGWTMagicNode>(Node);
-        if (MagicNode)
+        if (!Node)
+        {
+            continue;
+        }
+
+        Stats.NodeCount++;
+        Stats.ConnectionCount += Node->OutputNodes.Num();
+        Stats.NodesByType.FindOrAdd(Node->GetNodeType()).Add(Node);
+
+        if (UGWTMagicNode* MagicNode = Cast<UGWTMagicNode>(Node))
+        {
+            Stats.BaseDamage += MagicNode->BaseDamage;
+        }
+    }
+
+    // Only nodes that can actually run are paid for
+    FGWTSpellOptimization Optimization;
+    FGWTSpellOptimizer::Optimize(this, Optimization);
+
+    for (UGWTSpellNode* Node : Optimization.LiveOrder)
+    {
+        if (UGWTMagicNode* MagicNode = Cast<UGWTMagicNode>(Node))
         {
-            ManaCost += MagicNode->ManaCost;
+            Stats.ManaCost += MagicNode->ManaCost;
         }
     }
 
     // Apply complexity scaling (more nodes = higher cost)
-    float ComplexityFactor = 1.0f + (FMath::Max(0, AllNodes.Num() - 3) * 0.1f);
-    ManaCost *= ComplexityFactor;
-
-    // Update stored value
-    TotalManaCost = ManaCost;
+    const float ComplexityFactor = 1.0f + (FMath::Max(0, Optimization.LiveOrder.Num() - 3) * 0.1f);
+    Stats.ManaCost *= ComplexityFactor;
 
-    UE_LOG(LogTemp, Verbose, TEXT("Calculated mana cost: %.1f (complexity factor: %.2f)"),
-        ManaCost, ComplexityFactor);
+    UE_LOG(LogTemp, Verbose, TEXT("Updated stats for %s (version %d): mana %.1f (complexity factor: %.2f), damage %.1f, valid %s"),
+        *SpellName.ToString(), GraphVersion, Stats.ManaCost, ComplexityFactor, Stats.BaseDamage,
+        Stats.bValid ? TEXT("true") : TEXT("false"));
 
-    return ManaCost;
+    return Stats;
 }
 
-float UGWTSpell::CalculateBaseDamage()
+bool UGWTSpell::ValidateGraph() const
 {
-    // Calculate total base damage of the spell
-    float Damage = 0.0f;
+    // Check if the spell has any nodes
+    if (AllNodes.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Spell validation failed: No nodes"));
+        return false;
+    }
+
+    // Check if it has any root nodes
+    if (RootNodes.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Spell validation failed: No root nodes"));
+        return false;
+    }
 
-    // Sum up damage from all magic nodes
+    // Validate each node's connections
+    bool bAllNodesValid = true;
     for (UGWTSpellNode* Node : AllNodes)
     {
-        UGWTMagicNode* MagicNode = Cast<UGWTMagicNode>(Node);
-        if (MagicNode)
+        if (Node && !Node->ValidateConnections())
         {
-            Damage += MagicNode->BaseDamage;
+            UE_LOG(LogTemp, Warning, TEXT("Node validation failed: %s"), *Node->NodeTitle.ToString());
+            bAllNodesValid = false;
         }
     }
 
-    // Update stored value
-    BaseDamage = Damage;
-
-    UE_LOG(LogTemp, Verbose, TEXT("Calculated base damage: %.1f"), Damage);
+    UE_LOG(LogTemp, Verbose, TEXT("Spell validation result: %s"), bAllNodesValid ? TEXT("Valid") : TEXT("Invalid"));
 
-    return Damage;
+    return bAllNodesValid;
 }
 
 void UGWTSpell::SaveToString(FString& OutString)
@@ -268,41 +397,31 @@ UGWTSpell* UGWTSpell::LoadFromString(const FString& SpellData)
     return NewSpell;
 }
 
-int32 UGWTSpell::CountNodes() const
+void UGWTSpell::SaveToBinary(TArray<uint8>& OutData) const
 {
-    return AllNodes.Num();
+    FGWTSpellSerializer::SaveSpell(this, OutData);
+
+    UE_LOG(LogTemp, Verbose, TEXT("Saved spell %s to %d bytes"), *SpellName.ToString(), OutData.Num());
 }
 
-int32 UGWTSpell::CountConnections() const
+UGWTSpell* UGWTSpell::LoadFromBinary(const TArray<uint8>& SpellData)
 {
-    int32 ConnectionCount = 0;
+    return FGWTSpellSerializer::LoadSpell(SpellData);
+}
 
-    // Count all node connections
-    for (UGWTSpellNode* Node : AllNodes)
-    {
-        if (Node)
-        {
-            ConnectionCount += Node->OutputNodes.Num();
-        }
-    }
+int32 UGWTSpell::CountNodes() const
+{
+    return GetCachedStats().NodeCount;
+}
 
-    return ConnectionCount;
+int32 UGWTSpell::CountConnections() const
+{
+    return GetCachedStats().ConnectionCount;
 }
 
 TArray<UGWTSpellNode*> UGWTSpell::GetNodesOfType(EGWTSpellComponentType NodeType) const
 {
-    TArray<UGWTSpellNode*> NodesOfType;
-
-    // Filter nodes by type
-    for (UGWTSpellNode* Node : AllNodes)
-    {
-        if (Node && Node->GetNodeType() == NodeType)
-        {
-            NodesOfType.Add(Node);
-        }
-    }
-
-    return NodesOfType;
+    return GetCachedStats().NodesByType.FindRef(NodeType);
 }
 
 UGWTSpellNode* UGWTSpell::FindNodeByID(const FGuid& NodeID) const
@@ -332,5 +451,89 @@ void UGWTSpell::UpdateNodeConnections()
         }
     }
 
+    // Connections changed, the old program and stats no longer match the graph
+    MarkGraphChanged();
+
     UE_LOG(LogTemp, Verbose, TEXT("Updated node connections, found %d root nodes"), RootNodes.Num());
+}
+
+bool UGWTSpell::CompileSpell()
+{
+    // Lower the node graph into a VM program, shared with every spell of the same structure
+    CompiledProgram.Reset();
+    bUseNodeExecution = false;
+    bProgramDirty = false;
+
+    const EGWTSpellCompileResult Result = FGWTSpellProgramCache::Get().FindOrCompile(this, CompiledProgram);
+    BuildDiagnostics();
+
+    // Unknown node types still work through their own Execute
+    if (Result == EGWTSpellCompileResult::UnsupportedNode)
+    {
+        bUseNodeExecution = true;
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("Compiled spell '%s': %s"),
+        *SpellName.ToString(), FGWTSpellCompiler::GetResultString(Result));
+
+    return Result == EGWTSpellCompileResult::Success;
+}
+
+const FGWTSpellOptimizationReport* UGWTSpell::GetOptimizationReport() const
+{
+    // Only available once the spell has compiled
+    return Diagnostics.IsValid() ? &Diagnostics->OptimizationReport : nullptr;
+}
+
+void UGWTSpell::BuildDiagnostics()
+{
+    Diagnostics.Reset();
+    if (!CompiledProgram.IsValid())
+    {
+        return;
+    }
+
+    // The program refers to nodes by structural index, which lines up across every spell sharing it
+    TArray<UGWTSpellNode*> StructureNodes;
+    FGWTSpellSerializer::GetStructureNodes(this, StructureNodes);
+
+    TSharedPtr<FGWTSpellDiagnostics> NewDiagnostics = MakeShared<FGWTSpellDiagnostics>();
+    NewDiagnostics->NodeIDs.Reserve(CompiledProgram->NodeSourceIndices.Num());
+    NewDiagnostics->NodeTitles.Reserve(CompiledProgram->NodeSourceIndices.Num());
+    for (int32 SourceIndex : CompiledProgram->NodeSourceIndices)
+    {
+        const UGWTSpellNode* Node = StructureNodes.IsValidIndex(SourceIndex) ? StructureNodes[SourceIndex] : nullptr;
+        NewDiagnostics->NodeIDs.Add(Node ? Node->NodeID : FGuid());
+        NewDiagnostics->NodeTitles.Add(Node ? Node->NodeTitle.ToString() : FString(TEXT("?")));
+    }
+
+    NewDiagnostics->OptimizationReport = CompiledProgram->OptimizationReport;
+    for (FGWTSpellRemovedNode& Removed : NewDiagnostics->OptimizationReport.RemovedNodes)
+    {
+        if (const UGWTSpellNode* Node = StructureNodes.IsValidIndex(Removed.SourceIndex) ? StructureNodes[Removed.SourceIndex] : nullptr)
+        {
+            Removed.NodeID = Node->NodeID;
+            Removed.NodeTitle = Node->NodeTitle.ToString();
+        }
+    }
+
+    Diagnostics = NewDiagnostics;
+}
+
+void UGWTSpell::SyncNodeLookup()
+{
+    // AllNodes is a public property, catch direct edits
+    if (NodeLookup.Num() != AllNodes.Num())
+    {
+        NodeLookup = TSet<UGWTSpellNode*>(AllNodes);
+    }
+}
+
+void UGWTSpell::InvalidateCompiledProgram()
+{
+    // Recompiled lazily on the next cast
+    CompiledProgram.Reset();
+    Diagnostics.Reset();
+    bUseNodeExecution = false;
+    bProgramDirty = true;
 }
\ No newline at end of file
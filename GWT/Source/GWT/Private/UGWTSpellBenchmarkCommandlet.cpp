@@ -0,0 +1,592 @@
+// UGWTSpellBenchmarkCommandlet.cpp
+// Implementation of the headless spell benchmark
+
+#include "UGWTSpellBenchmarkCommandlet.h"
+#include "UGWTSpell.h"
+#include "UGWTSpellNode.h"
+#include "UGWTEffectNode.h"
+#include "UGWTFlowNode.h"
+#include "UGWTVariableNode.h"
+#include "UGWTSpellContextPool.h"
+#include "UGWTSpellScheduler.h"
+#include "UGWTSpellExecutionContext.h"
+#include "FGWTSpellProgramCache.h"
+#include "FGWTSpellVM.h"
+#include "AGWTCharacter.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "UObject/UObjectArray.h"
+
+// Tag for the measured casts, run with -llm to see what they allocate
+LLM_DEFINE_TAG(GWTSpellBenchmark);
+
+UGWTSpellBenchmarkCommandlet::UGWTSpellBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UGWTSpellBenchmarkCommandlet::Main(const FString& Params)
+{
+    int32 NumCasts = 10000;
+    int32 NumTargets = 32;
+    FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("SpellBenchmark.csv");
+    FString BaselinePath;
+
+    FParse::Value(*Params, TEXT("Casts="), NumCasts);
+    FParse::Value(*Params, TEXT("Targets="), NumTargets);
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+    NumCasts = FMath::Max(1, NumCasts);
+    NumTargets = FMath::Max(1, NumTargets);
+
+    // Minimal game world, enough for the subsystems and actor spawning
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("GWTSpellBenchmark"));
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+    World->InitializeActorsForPlay(FURL());
+    World->BeginPlay();
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    AGWTCharacter* Caster = World->SpawnActor<AGWTCharacter>(AGWTCharacter::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+    if (Caster)
+    {
+        // Enough mana for the biggest case, the cast path checks and spends it every time
+        Caster->MaxMana = 1.0e9f;
+        Caster->CurrentMana = Caster->MaxMana;
+    }
+
+    // Targets on a ring around the caster, tough enough that nothing dies mid-run
+    TArray<AGWTCharacter*> Targets;
+    for (int32 i = 0; i < NumTargets; i++)
+    {
+        const float Angle = 2.0f * PI * i / NumTargets;
+        const FVector Location(FMath::Cos(Angle) * 500.0f, FMath::Sin(Angle) * 500.0f, 0.0f);
+
+        AGWTCharacter* Target = World->SpawnActor<AGWTCharacter>(AGWTCharacter::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams);
+        if (Target)
+        {
+            Target->MaxHealth = 1.0e9f;
+            Target->CurrentHealth = Target->MaxHealth;
+            Targets.Add(Target);
+        }
+    }
+
+    if (!Caster || Targets.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Spell benchmark could not spawn its characters"));
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+        return 1;
+    }
+
+    TArray<TPair<FString, UGWTSpell*>> Cases;
+    Cases.Emplace(TEXT("Chain8"), BuildChain(World, 8));
+    Cases.Emplace(TEXT("Chain48"), BuildChain(World, 48));
+    Cases.Emplace(TEXT("Diamond16"), BuildDiamond(World, 16));
+    Cases.Emplace(TEXT("NestedRepeat3x3"), BuildNestedRepeat(World, 3, 3));
+    Cases.Emplace(TEXT("WhileCountdown16"), BuildWhileCountdown(World, 16));
+    Cases.Emplace(TEXT("VariableHeavy64"), BuildVariableHeavy(World, 64));
+    Cases.Emplace(TEXT("IndependentRoots4x12"), BuildIndependentRoots(World, 4, 12));
+
+    // Per-cast logging would dominate the timings
+    const ELogVerbosity::Type PreviousVerbosity = LogTemp.GetVerbosity();
+    LogTemp.SetVerbosity(ELogVerbosity::Warning);
+
+    TArray<FBenchmarkResult> Results;
+    bool bAllSucceeded = true;
+    for (const TPair<FString, UGWTSpell*>& Case : Cases)
+    {
+        FBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+        if (!RunCase(Case.Key, Case.Value, Caster, Targets, NumCasts, Result))
+        {
+            Results.Pop();
+            bAllSucceeded = false;
+        }
+    }
+
+    LogTemp.SetVerbosity(PreviousVerbosity);
+
+    TMap<FString, FBaselineResult> Baseline;
+    if (!BaselinePath.IsEmpty())
+    {
+        LoadBaseline(BaselinePath, Baseline);
+    }
+
+    if (!Results.IsEmpty() && !Results[0].TrackedBytesPerCast.IsSet())
+    {
+        UE_LOG(LogTemp, Display, TEXT("Spell benchmark ran without -llm, bytes per cast are not reported"));
+    }
+
+    for (const FBenchmarkResult& Result : Results)
+    {
+        FString Comparison;
+        if (const FBaselineResult* BaselineResult = Baseline.Find(Result.Name))
+        {
+            if (BaselineResult->NanosecondsPerCast > 0.0)
+            {
+                Comparison += FString::Printf(TEXT("  (%+.1f%% vs baseline)"), (Result.NanosecondsPerCast / BaselineResult->NanosecondsPerCast - 1.0) * 100.0);
+            }
+            if (Result.TrackedBytesPerCast.IsSet() && BaselineResult->TrackedBytesPerCast.IsSet())
+            {
+                Comparison += FString::Printf(TEXT("  (%+.1f bytes/cast vs baseline)"), Result.TrackedBytesPerCast.GetValue() - BaselineResult->TrackedBytesPerCast.GetValue());
+            }
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("%-18s %4d nodes  %10.1f ns/cast  %10.1f ns/run (VM only)  %8s bytes/cast  %6.3f objects/cast  compile %8.1f us%s"),
+            *Result.Name, Result.NumNodes, Result.NanosecondsPerCast, Result.VmNanosecondsPerCast,
+            Result.TrackedBytesPerCast.IsSet() ? *FString::Printf(TEXT("%.1f"), Result.TrackedBytesPerCast.GetValue()) : TEXT("-"),
+            Result.ObjectsPerCast, Result.CompileMicroseconds, *Comparison);
+    }
+
+    const bool bWritten = WriteReport(OutputPath, Results, Baseline);
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+
+    return bAllSucceeded && bWritten ? 0 : 1;
+}
+
+template<typename NodeType>
+NodeType* UGWTSpellBenchmarkCommandlet::NewNode(UGWTSpell* Spell)
+{
+    NodeType* Node = NewObject<NodeType>(Spell);
+    Node->NodeID = FGuid::NewGuid();
+    Spell->AddNode(Node);
+    return Node;
+}
+
+void UGWTSpellBenchmarkCommandlet::Connect(UGWTSpellNode* From, UGWTSpellNode* To)
+{
+    From->AddOutputConnection(To);
+    To->AddInputConnection(From);
+}
+
+UGWTSpell* UGWTSpellBenchmarkCommandlet::BuildChain(UObject* Outer, int32 Length)
+{
+    // Effects one after another
+    UGWTSpell* Spell = NewObject<UGWTSpell>(Outer);
+    UGWTSpellNode* Previous = nullptr;
+
+    for (int32 i = 0; i < Length; i++)
+    {
+        UGWTEffectNode* Node = NewNode<UGWTEffectNode>(Spell);
+        Node->EffectValue = 1.0f;
+        if (Previous)
+        {
+            Connect(Previous, Node);
+        }
+        Previous = Node;
+    }
+
+    Spell->UpdateNodeConnections();
+    return Spell;
+}
+
+UGWTSpell* UGWTSpellBenchmarkCommandlet::BuildDiamond(UObject* Outer, int32 Width)
+{
+    // One effect fanning out to Width effects that all join on a final one
+    UGWTSpell* Spell = NewObject<UGWTSpell>(Outer);
+    UGWTEffectNode* Source = NewNode<UGWTEffectNode>(Spell);
+    UGWTEffectNode* Join = NewNode<UGWTEffectNode>(Spell);
+    Source->EffectValue = 1.0f;
+    Join->EffectValue = 1.0f;
+
+    for (int32 i = 0; i < Width; i++)
+    {
+        UGWTEffectNode* Node = NewNode<UGWTEffectNode>(Spell);
+        Node->EffectValue = 1.0f;
+        Connect(Source, Node);
+        Connect(Node, Join);
+    }
+
+    Spell->UpdateNodeConnections();
+    return Spell;
+}
+
+UGWTSpell* UGWTSpellBenchmarkCommandlet::BuildNestedRepeat(UObject* Outer, int32 Depth, int32 IterationsPerLevel)
+{
+    // Repeat loops nested Depth deep around a single effect
+    UGWTSpell* Spell = NewObject<UGWTSpell>(Outer);
+    UGWTFlowNode* Parent = nullptr;
+
+    for (int32 i = 0; i < Depth; i++)
+    {
+        UGWTFlowNode* Loop = NewNode<UGWTFlowNode>(Spell);
+        Loop->FlowType = EGWTFlowType::Repeat;
+        Loop->IterationCount = IterationsPerLevel;
+        if (Parent)
+        {
+            Connect(Parent, Loop);
+        }
+        Parent = Loop;
+    }
+
+    UGWTEffectNode* Body = NewNode<UGWTEffectNode>(Spell);
+    Body->EffectValue = 1.0f;
+    if (Parent)
+    {
+        Connect(Parent, Body);
+    }
+
+    Spell->UpdateNodeConnections();
+    return Spell;
+}
+
+UGWTSpell* UGWTSpellBenchmarkCommandlet::BuildWhileCountdown(UObject* Outer, int32 Iterations)
+{
+    // Counter = Iterations, then while (Counter) { effect; Counter -= 1 }
+    static const FName CounterName(TEXT("Counter"));
+    UGWTSpell* Spell = NewObject<UGWTSpell>(Outer);
+
+    UGWTVariableNode* Init = NewNode<UGWTVariableNode>(Spell);
+    Init->VariableName = CounterName;
+    Init->VariableType = EGWTVariableType::Int;
+    Init->Operation = UGWTVariableNode::EVariableOperation::Write;
+    Init->DefaultValue.Type = EGWTVariableType::Int;
+    Init->DefaultValue.IntValue = Iterations;
+
+    UGWTFlowNode* Loop = NewNode<UGWTFlowNode>(Spell);
+    Loop->FlowType = EGWTFlowType::While;
+    Loop->ConditionVariableName = CounterName;
+
+    UGWTEffectNode* Body = NewNode<UGWTEffectNode>(Spell);
+    Body->EffectValue = 1.0f;
+
+    UGWTVariableNode* Decrement = NewNode<UGWTVariableNode>(Spell);
+    Decrement->VariableName = CounterName;
+    Decrement->VariableType = EGWTVariableType::Int;
+    Decrement->Operation = UGWTVariableNode::EVariableOperation::Subtract;
+    Decrement->DefaultValue.Type = EGWTVariableType::Int;
+    Decrement->DefaultValue.IntValue = 1;
+
+    Connect(Init, Loop);
+    Connect(Loop, Body);
+    Connect(Body, Decrement);
+
+    Spell->UpdateNodeConnections();
+    return Spell;
+}
+
+UGWTSpell* UGWTSpellBenchmarkCommandlet::BuildVariableHeavy(UObject* Outer, int32 NumOperations)
+{
+    // A long run of additions to one variable, read by a while loop so none of it is optimized away
+    static const FName AccumulatorName(TEXT("Accumulator"));
+    UGWTSpell* Spell = NewObject<UGWTSpell>(Outer);
+    UGWTSpellNode* Previous = nullptr;
+
+    for (int32 i = 0; i < NumOperations; i++)
+    {
+        UGWTVariableNode* Node = NewNode<UGWTVariableNode>(Spell);
+        Node->VariableName = AccumulatorName;
+        Node->VariableType = EGWTVariableType::Int;
+        Node->Operation = i == 0 ? UGWTVariableNode::EVariableOperation::Write : UGWTVariableNode::EVariableOperation::Add;
+        Node->DefaultValue.Type = EGWTVariableType::Int;
+        Node->DefaultValue.IntValue = 1;
+        if (Previous)
+        {
+            Connect(Previous, Node);
+        }
+        Previous = Node;
+    }
+
+    // Runs once: the body clears the accumulator before applying its effect
+    UGWTFlowNode* Loop = NewNode<UGWTFlowNode>(Spell);
+    Loop->FlowType = EGWTFlowType::While;
+    Loop->ConditionVariableName = AccumulatorName;
+
+    UGWTVariableNode* Clear = NewNode<UGWTVariableNode>(Spell);
+    Clear->VariableName = AccumulatorName;
+    Clear->VariableType = EGWTVariableType::Int;
+    Clear->Operation = UGWTVariableNode::EVariableOperation::Write;
+    Clear->DefaultValue.Type = EGWTVariableType::Int;
+    Clear->DefaultValue.IntValue = 0;
+
+    UGWTEffectNode* Effect = NewNode<UGWTEffectNode>(Spell);
+    Effect->EffectValue = 1.0f;
+
+    if (Previous)
+    {
+        Connect(Previous, Loop);
+    }
+    Connect(Loop, Clear);
+    Connect(Clear, Effect);
+
+    Spell->UpdateNodeConnections();
+    return Spell;
+}
+
+UGWTSpell* UGWTSpellBenchmarkCommandlet::BuildIndependentRoots(UObject* Outer, int32 NumRoots, int32 ChainLength)
+{
+    // Several effect chains with no shared state, compiled into parallel root groups
+    UGWTSpell* Spell = NewObject<UGWTSpell>(Outer);
+
+    for (int32 RootIndex = 0; RootIndex < NumRoots; RootIndex++)
+    {
+        UGWTSpellNode* Previous = nullptr;
+        for (int32 i = 0; i < ChainLength; i++)
+        {
+            UGWTEffectNode* Node = NewNode<UGWTEffectNode>(Spell);
+            Node->EffectValue = 1.0f;
+            if (Previous)
+            {
+                Connect(Previous, Node);
+            }
+            Previous = Node;
+        }
+    }
+
+    Spell->UpdateNodeConnections();
+    return Spell;
+}
+
+bool UGWTSpellBenchmarkCommandlet::RunCase(const FString& Name, UGWTSpell* Spell, AGWTCharacter* Caster,
+    const TArray<AGWTCharacter*>& Targets, int32 NumCasts, FBenchmarkResult& OutResult)
+{
+    OutResult.Name = Name;
+    OutResult.NumNodes = Spell ? Spell->CountNodes() : 0;
+    OutResult.NumCasts = NumCasts;
+
+    // Every case starts from a cold program cache so compile times are real, even when shapes repeat
+    FGWTSpellProgramCache::Get().Empty();
+
+    const double CompileStart = FPlatformTime::Seconds();
+    const bool bCompiled = Spell && Spell->CompileSpell();
+    OutResult.CompileMicroseconds = (FPlatformTime::Seconds() - CompileStart) * 1.0e6;
+
+    TSharedPtr<const FGWTSpellProgram> Program;
+    if (bCompiled)
+    {
+        Program = Spell->GetCompiledProgram();
+    }
+    if (!Program.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Spell benchmark case %s failed to compile"), *Name);
+        return false;
+    }
+
+    // UGWTSpell::Cast returns early for invalid spells, such a case would time nothing
+    if (!Spell->ValidateSpell())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Spell benchmark case %s does not validate"), *Name);
+        return false;
+    }
+
+    // Warm up, grows the context pool and touches every code path once
+    const int32 NumWarmupCasts = FMath::Min(NumCasts, 100);
+    for (int32 i = 0; i < NumWarmupCasts; i++)
+    {
+        CastOnce(Spell, Caster, Targets[i % Targets.Num()]);
+        RunProgramOnce(Program, Caster, Targets[i % Targets.Num()]);
+    }
+
+    // Measured casts through the real cast path, memory is what LLM attributes to the casts' tag rather than process totals
+    const int32 ObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+    const TOptional<int64> TrackedBefore = GetTrackedBytes();
+    uint64 StartCycles = 0;
+    uint64 EndCycles = 0;
+    {
+        LLM_SCOPE_BYTAG(GWTSpellBenchmark);
+        StartCycles = FPlatformTime::Cycles64();
+
+        for (int32 i = 0; i < NumCasts; i++)
+        {
+            CastOnce(Spell, Caster, Targets[i % Targets.Num()]);
+        }
+
+        EndCycles = FPlatformTime::Cycles64();
+    }
+    const TOptional<int64> TrackedAfter = GetTrackedBytes();
+    const int32 ObjectsAfter = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+    OutResult.NanosecondsPerCast = FPlatformTime::ToSeconds64(EndCycles - StartCycles) * 1.0e9 / NumCasts;
+    if (TrackedBefore.IsSet() && TrackedAfter.IsSet())
+    {
+        OutResult.TrackedBytesPerCast = (double)(TrackedAfter.GetValue() - TrackedBefore.GetValue()) / NumCasts;
+    }
+    OutResult.ObjectsPerCast = (double)(ObjectsAfter - ObjectsBefore) / NumCasts;
+
+    // The same program run straight on the VM, the gap to the full cast is validation, mana and scheduling
+    StartCycles = FPlatformTime::Cycles64();
+    for (int32 i = 0; i < NumCasts; i++)
+    {
+        RunProgramOnce(Program, Caster, Targets[i % Targets.Num()]);
+    }
+    EndCycles = FPlatformTime::Cycles64();
+
+    OutResult.VmNanosecondsPerCast = FPlatformTime::ToSeconds64(EndCycles - StartCycles) * 1.0e9 / NumCasts;
+
+    return true;
+}
+
+void UGWTSpellBenchmarkCommandlet::CastOnce(UGWTSpell* Spell, AGWTCharacter* Caster, AGWTCharacter* Target)
+{
+    // Damage and mana cost accumulate over thousands of casts, keep both sides topped up
+    Target->CurrentHealth = Target->MaxHealth;
+    Caster->CurrentMana = Caster->MaxMana;
+
+    Spell->Cast(Caster, Target);
+
+    // Loops yield to the scheduler between slices, the benchmark world never ticks so finish them here
+    static constexpr int32 MaxDrainTicks = 1000;
+    UGWTSpellScheduler* Scheduler = UGWTSpellScheduler::Get(Caster);
+    for (int32 Tick = 0; Scheduler && Scheduler->GetNumSuspendedCasts() > 0 && Tick < MaxDrainTicks; Tick++)
+    {
+        Scheduler->Tick(0.0f);
+    }
+}
+
+void UGWTSpellBenchmarkCommandlet::RunProgramOnce(const TSharedPtr<const FGWTSpellProgram>& Program, AGWTCharacter* Caster, AGWTCharacter* Target)
+{
+    // Damage accumulates over thousands of casts, keep the target alive
+    Target->CurrentHealth = Target->MaxHealth;
+
+    // Just the context pool and the VM, no validation, mana or scheduler
+    UGWTSpellContextPool* ContextPool = UGWTSpellContextPool::Get(Caster);
+    UGWTSpellExecutionContext* Context = ContextPool->Acquire(Caster, Target);
+
+    if (Program->ParallelEntries.Num() > 1)
+    {
+        TSharedPtr<FGWTSpellSharedMeter, ESPMode::ThreadSafe> SharedMeter = MakeShared<FGWTSpellSharedMeter, ESPMode::ThreadSafe>();
+        TArray<FGWTSpellTask, TInlineAllocator<8>> Tasks;
+        TArray<FGWTSpellTask*, TInlineAllocator<8>> TaskPointers;
+
+        for (int32 GroupIndex = 0; GroupIndex < Program->ParallelEntries.Num(); GroupIndex++)
+        {
+            FGWTSpellTask& Task = Tasks.Emplace_GetRef(Program, GroupIndex == 0 ? Context : ContextPool->AcquireSibling(Context));
+            Task.EntryPC = Program->ParallelEntries[GroupIndex];
+            Task.SharedMeter = SharedMeter;
+        }
+        for (FGWTSpellTask& Task : Tasks)
+        {
+            TaskPointers.Add(&Task);
+        }
+
+        TArray<EGWTSpellRunResult, TInlineAllocator<8>> Results;
+        FGWTSpellVM::RunSiblings(TaskPointers, 0.0, false, Results);
+
+        for (FGWTSpellTask& Task : Tasks)
+        {
+            ContextPool->Release(Task.Context);
+        }
+        return;
+    }
+
+    FGWTSpellTask Task(Program, Context);
+    FGWTSpellVM::Run(Task, 0.0, false);
+
+    ContextPool->Release(Context);
+}
+
+TOptional<int64> UGWTSpellBenchmarkCommandlet::GetTrackedBytes()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+    if (FLowLevelMemTracker::IsEnabled())
+    {
+        // Threads keep their counts locally until the tracker gathers them
+        FLowLevelMemTracker::Get().UpdateStatsPerFrame();
+        return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, TEXT("GWTSpellBenchmark"), ELLMTagSet::None);
+    }
+#endif
+    return TOptional<int64>();
+}
+
+void UGWTSpellBenchmarkCommandlet::LoadBaseline(const FString& Path, TMap<FString, FBaselineResult>& OutBaseline)
+{
+    FString Contents;
+    if (!FFileHelper::LoadFileToString(Contents, *Path))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Spell benchmark baseline not found: %s"), *Path);
+        return;
+    }
+
+    // Columns are found by header name, so reports from older builds still load
+    TArray<FString> Lines;
+    Contents.ParseIntoArrayLines(Lines);
+    if (Lines.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<FString> Header;
+    Lines[0].ParseIntoArray(Header, TEXT(","), false);
+    const int32 NsColumn = Header.IndexOfByKey(TEXT("NsPerCast"));
+    const int32 BytesColumn = Header.IndexOfByKey(TEXT("TrackedBytesPerCast"));
+    if (NsColumn == INDEX_NONE)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Spell benchmark baseline has no NsPerCast column: %s"), *Path);
+        return;
+    }
+
+    for (int32 i = 1; i < Lines.Num(); i++)
+    {
+        TArray<FString> Columns;
+        Lines[i].ParseIntoArray(Columns, TEXT(","), false);
+        if (!Columns.IsValidIndex(NsColumn))
+        {
+            continue;
+        }
+
+        FBaselineResult& BaselineResult = OutBaseline.Add(Columns[0]);
+        BaselineResult.NanosecondsPerCast = FCString::Atod(*Columns[NsColumn]);
+        if (Columns.IsValidIndex(BytesColumn) && !Columns[BytesColumn].IsEmpty())
+        {
+            BaselineResult.TrackedBytesPerCast = FCString::Atod(*Columns[BytesColumn]);
+        }
+    }
+}
+
+bool UGWTSpellBenchmarkCommandlet::WriteReport(const FString& Path, const TArray<FBenchmarkResult>& Results, const TMap<FString, FBaselineResult>& Baseline)
+{
+    FString Report = TEXT("Name,Nodes,Casts,CompileUs,NsPerCast,VmNsPerCast,TrackedBytesPerCast,ObjectsPerCast,BaselineNsPerCast,DeltaPercent,BaselineTrackedBytesPerCast,DeltaBytesPerCast\n");
+
+    for (const FBenchmarkResult& Result : Results)
+    {
+        // Byte columns stay empty without -llm, baseline columns for new cases
+        Report += FString::Printf(TEXT("%s,%d,%d,%.2f,%.2f,%.2f,%s,%.4f"),
+            *Result.Name, Result.NumNodes, Result.NumCasts, Result.CompileMicroseconds,
+            Result.NanosecondsPerCast, Result.VmNanosecondsPerCast,
+            Result.TrackedBytesPerCast.IsSet() ? *FString::Printf(TEXT("%.1f"), Result.TrackedBytesPerCast.GetValue()) : TEXT(""),
+            Result.ObjectsPerCast);
+
+        const FBaselineResult* BaselineResult = Baseline.Find(Result.Name);
+        if (BaselineResult && BaselineResult->NanosecondsPerCast > 0.0)
+        {
+            Report += FString::Printf(TEXT(",%.2f,%.2f"), BaselineResult->NanosecondsPerCast,
+                (Result.NanosecondsPerCast / BaselineResult->NanosecondsPerCast - 1.0) * 100.0);
+        }
+        else
+        {
+            Report += TEXT(",,");
+        }
+
+        // Bytes compared as a difference, a baseline of zero has no percentage
+        if (BaselineResult && BaselineResult->TrackedBytesPerCast.IsSet() && Result.TrackedBytesPerCast.IsSet())
+        {
+            Report += FString::Printf(TEXT(",%.1f,%+.1f\n"), BaselineResult->TrackedBytesPerCast.GetValue(),
+                Result.TrackedBytesPerCast.GetValue() - BaselineResult->TrackedBytesPerCast.GetValue());
+        }
+        else
+        {
+            Report += TEXT(",,\n");
+        }
+    }
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+    if (!FFileHelper::SaveStringToFile(Report, *Path))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Could not write spell benchmark report to %s"), *Path);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Spell benchmark report written to %s"), *Path);
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+// UGWTSpellContextPool.cpp
+// Implementation of the spell execution context pool
+
+#include "UGWTSpellContextPool.h"
+#include "UGWTSpellExecutionContext.h"
+#include "UGWTRandomService.h"
+#include "AGWTCharacter.h"
+#include "Engine/World.h"
+
+void UGWTSpellContextPool::Deinitialize()
+{
+    UE_LOG(LogTemp, Verbose, TEXT("Spell context pool shutting down: %d contexts created"), AllContexts.Num());
+
+    FreeContexts.Empty();
+    AllContexts.Empty();
+
+    Super::Deinitialize();
+}
+
+UGWTSpellExecutionContext* UGWTSpellContextPool::Acquire(AActor* Caster, AActor* Target)
+{
+    UGWTSpellExecutionContext* Context = TakeFreeContext();
+
+    Context->Caster = Caster;
+    Context->Target = Target;
+
+    // Each cast gets its own random stream, so rolls do not depend on what other casters did
+    const AGWTCharacter* CasterCharacter = Cast<AGWTCharacter>(Caster);
+    Context->RandomStream = CasterCharacter ? CasterCharacter->GetRandomStreamID() : UGWTRandomService::GetStreamID(Caster);
+    UGWTRandomService* RandomService = GetWorld()->GetSubsystem<UGWTRandomService>();
+    Context->CastID = RandomService ? RandomService->NextCastID(Caster) : 0;
+
+    return Context;
+}
+
+UGWTSpellExecutionContext* UGWTSpellContextPool::AcquireSibling(const UGWTSpellExecutionContext* Source)
+{
+    UGWTSpellExecutionContext* Context = TakeFreeContext();
+
+    // Same cast, so the same participants and random stream
+    Context->Caster = Source->Caster;
+    Context->Target = Source->Target;
+    Context->HitResult = Source->HitResult;
+    Context->RandomStream = Source->RandomStream;
+    Context->CastID = Source->CastID;
+
+    return Context;
+}
+
+void UGWTSpellContextPool::Release(UGWTSpellExecutionContext* Context)
+{
+    // Only take back contexts this pool created
+    if (!Context || Context->GetOuter() != this)
+    {
+        return;
+    }
+
+    // Whatever the cast left pending lands now, then clear per-cast state but keep the allocations
+    Context->EffectCommands.Flush();
+    Context->ResetContext();
+    FreeContexts.Add(Context);
+}
+
+UGWTSpellContextPool* UGWTSpellContextPool::Get(const AActor* WorldContext)
+{
+    UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UGWTSpellContextPool>() : nullptr;
+}
+
+UGWTSpellExecutionContext* UGWTSpellContextPool::TakeFreeContext()
+{
+    UGWTSpellExecutionContext* Context = nullptr;
+
+    if (FreeContexts.Num() > 0)
+    {
+        // Reuse a released context
+        Context = FreeContexts.Pop(false);
+    }
+    else
+    {
+        // Grow the pool, only happens until the peak number of concurrent casts is reached
+        Context = NewObject<UGWTSpellExecutionContext>(this);
+        Context->Variables.Reserve(ReservedVariables);
+        AllContexts.Add(Context);
+
+        UE_LOG(LogTemp, Verbose, TEXT("Spell context pool grew to %d contexts"), AllContexts.Num());
+    }
+
+    return Context;
+}
\ No newline at end of file
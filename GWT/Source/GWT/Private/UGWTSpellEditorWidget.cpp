@@ -336,6 +336,12 @@ void UGWTSpellEditorWidget::EndConnectionDrag(UGWTNodeWidget* TargetNode, int32
             // Add connection
             TargetSpellNode->AddInputConnection(SourceSpellNode);
 
+            // Refresh root nodes and drop the stale compiled program
+            if (CurrentSpell)
+            {
+                CurrentSpell->UpdateNodeConnections();
+            }
+
             UE_LOG(LogTemp, Display, TEXT("Connected node %s to %s"),
                 *SourceSpellNode->NodeTitle.ToString(),
                 *TargetSpellNode->NodeTitle.ToString());
@@ -555,6 +561,9 @@ void UGWTSpellEditorWidget::SaveSpell()
             }
         }
 
+        // Node properties may have been edited, refresh stats and recompile on next cast
+        CurrentSpell->MarkGraphChanged();
+
         // Add to grimoire if needed
         if (Grimoire && !Grimoire->Spells.Contains(CurrentSpell))
         {
@@ -575,6 +584,9 @@ void UGWTSpellEditorWidget::TestSpell()
     // Test the current spell
     if (CurrentSpell)
     {
+        // Pick up any node property edits made since the last compile
+        CurrentSpell->MarkGraphChanged();
+
         // Validate the spell
         if (CurrentSpell->ValidateSpell())
         {
@@ -844,10 +856,7 @@ bool UGWTSpellEditorWidget::CanConnectNodes(UGWTNodeWidget* SourceNode, UGWTNode
         return false;
     }
 
-    // Check if connection would create a cycle
-    // (This would require a more complex check in a full implementation)
-
-    // Check if source can connect to target
+    // Check if source can connect to target, this also rejects connections that would create a cycle
     return SourceNode->SpellNode->CanConnectOutput(TargetNode->SpellNode) &&
         TargetNode->SpellNode->CanConnectInput(SourceNode->SpellNode);
 }
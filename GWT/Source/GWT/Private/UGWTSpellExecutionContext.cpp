@@ -4,6 +4,33 @@
 #include "UGWTSpellExecutionContext.h"
 #include "UGWTSpellNode.h"
 #include "AGWTCharacter.h"
+#include "UGWTRandomService.h"
+
+// Copy what the kernels read from one actor
+static void CaptureActorState(const AActor* Actor, FGWTSpellActorState& OutState)
+{
+    OutState = FGWTSpellActorState();
+    if (!Actor)
+    {
+        return;
+    }
+
+    OutState.Actor = Actor;
+    OutState.Location = Actor->GetActorLocation();
+
+    if (const AGWTCharacter* Character = Cast<AGWTCharacter>(Actor))
+    {
+        OutState.bIsCharacter = true;
+        OutState.CurrentHealth = Character->CurrentHealth;
+        OutState.MaxHealth = Character->MaxHealth;
+        OutState.CurrentMana = Character->CurrentMana;
+        OutState.MaxMana = Character->MaxMana;
+        for (const FGWTStatusEffect& Effect : Character->ActiveEffects)
+        {
+            OutState.StatusEffects.Add(Effect.EffectType);
+        }
+    }
+}
 
 UGWTSpellExecutionContext::UGWTSpellExecutionContext()
 {
@@ -17,8 +44,16 @@ UGWTSpellExecutionContext::UGWTSpellExecutionContext()
 
 void UGWTSpellExecutionContext::SetVariable(FName Name, const FGWTVariableValue& Value)
 {
-    // Store variable in the map
-    Variables.Add(Name, Value);
+    // Compiled spells keep their variables in slots, everything else goes in the map
+    const int32 Slot = VariableSlotNames ? VariableSlotNames->IndexOfByKey(Name) : INDEX_NONE;
+    if (Slot != INDEX_NONE)
+    {
+        SetSlot(Slot, FGWTRuntimeValue::FromVariableValue(Value));
+    }
+    else
+    {
+        Variables.Add(Name, Value);
+    }
 
     // Log variable details based on type
     switch (Value.Type)
@@ -54,10 +89,17 @@ void UGWTSpellExecutionContext::SetVariable(FName Name, const FGWTVariableValue&
 
 FGWTVariableValue UGWTSpellExecutionContext::GetVariable(FName Name)
 {
+    // Slot variables are converted back to the Blueprint struct
+    const int32 Slot = VariableSlotNames ? VariableSlotNames->IndexOfByKey(Name) : INDEX_NONE;
+    if (Slot != INDEX_NONE && VariableSlotsSet[Slot])
+    {
+        return VariableSlots[Slot].ToVariableValue();
+    }
+
     // Try to find the variable
-    if (Variables.Contains(Name))
+    if (const FGWTVariableValue* Value = Variables.Find(Name))
     {
-        return Variables[Name];
+        return *Value;
     }
 
     // Return default value if not found
@@ -65,6 +107,38 @@ FGWTVariableValue UGWTSpellExecutionContext::GetVariable(FName Name)
     return FGWTVariableValue();
 }
 
+bool UGWTSpellExecutionContext::TryGetVariable(FName Name, FGWTRuntimeValue& OutValue) const
+{
+    // Check bound slots first, then the named map
+    const int32 Slot = VariableSlotNames ? VariableSlotNames->IndexOfByKey(Name) : INDEX_NONE;
+    if (Slot != INDEX_NONE)
+    {
+        if (const FGWTRuntimeValue* SlotValue = FindSlot(Slot))
+        {
+            OutValue = *SlotValue;
+            return true;
+        }
+        return false;
+    }
+
+    if (const FGWTVariableValue* Value = Variables.Find(Name))
+    {
+        OutValue = FGWTRuntimeValue::FromVariableValue(*Value);
+        return true;
+    }
+
+    return false;
+}
+
+void UGWTSpellExecutionContext::BindVariableSlots(const TArray<FName>& SlotNames)
+{
+    // Reuses the existing allocation when the context comes from the pool
+    VariableSlots.Reset();
+    VariableSlots.SetNum(SlotNames.Num());
+    VariableSlotsSet.Init(false, SlotNames.Num());
+    VariableSlotNames = &SlotNames;
+}
+
 void UGWTSpellExecutionContext::PushToStack(UGWTSpellNode* Node)
 {
     // Add node to execution stack
@@ -144,22 +218,118 @@ void UGWTSpellExecutionContext::ApplyEffect(AGWTCharacter* Target, EGWTEffectTyp
 
 bool UGWTSpellExecutionContext::HasVariable(FName Name) const
 {
+    const int32 Slot = VariableSlotNames ? VariableSlotNames->IndexOfByKey(Name) : INDEX_NONE;
+    if (Slot != INDEX_NONE)
+    {
+        return VariableSlotsSet[Slot];
+    }
+
     return Variables.Contains(Name);
 }
 
 void UGWTSpellExecutionContext::ClearVariables()
 {
     Variables.Empty();
+    VariableSlotsSet.Init(false, VariableSlots.Num());
     UE_LOG(LogTemp, Verbose, TEXT("Cleared all variables from context"));
 }
 
+void UGWTSpellExecutionContext::ResetContext()
+{
+    // Reset rather than Empty so the next cast reuses the storage
+    Caster = nullptr;
+    Target = nullptr;
+    HitResult = FHitResult();
+    Variables.Reset();
+    VariableSlots.Reset();
+    VariableSlotsSet.Init(false, 0);
+    VariableSlotNames = nullptr;
+    ExecutionStack.Reset();
+    EffectCommands.Reset();
+    WorldSnapshot = nullptr;
+}
+
+AActor* UGWTSpellExecutionContext::GetActor(EGWTSpellActor Which) const
+{
+    check(!WorldSnapshot);
+
+    switch (Which)
+    {
+    case EGWTSpellActor::Caster:
+        return Caster;
+
+    case EGWTSpellActor::Target:
+        return Target;
+
+    default:
+        return HitResult.GetActor();
+    }
+}
+
+FGWTSpellActorState UGWTSpellExecutionContext::ReadActor(EGWTSpellActor Which) const
+{
+    if (WorldSnapshot)
+    {
+        switch (Which)
+        {
+        case EGWTSpellActor::Caster:
+            return WorldSnapshot->Caster;
+
+        case EGWTSpellActor::Target:
+            return WorldSnapshot->Target;
+
+        default:
+            return WorldSnapshot->HitActor;
+        }
+    }
+
+    FGWTSpellActorState State;
+    CaptureActorState(GetActor(Which), State);
+    return State;
+}
+
+void UGWTSpellExecutionContext::CaptureWorld(FGWTSpellWorldSnapshot& OutSnapshot) const
+{
+    check(IsInGameThread() && !WorldSnapshot);
+
+    CaptureActorState(Caster, OutSnapshot.Caster);
+    CaptureActorState(Target, OutSnapshot.Target);
+    CaptureActorState(HitResult.GetActor(), OutSnapshot.HitActor);
+
+    // Same fallback as UGWTRandomService::FRand, seed 0 without a service
+    const UGWTRandomService* RandomService = UGWTRandomService::Get(Caster);
+    OutSnapshot.RandomSeed = RandomService ? RandomService->GetMatchSeed() : 0;
+}
+
+float UGWTSpellExecutionContext::RandomFRand(const FGWTRandomKey& Key) const
+{
+    if (WorldSnapshot)
+    {
+        return UGWTRandomService::ToUnitFloat(WorldSnapshot->RandomSeed, Key);
+    }
+
+    return UGWTRandomService::FRand(Caster, Key);
+}
+
+void UGWTSpellExecutionContext::FlushBeforeRead()
+{
+    // Worker casts defer their payloads instead of queueing them, so there is never anything to land
+    if (WorldSnapshot)
+    {
+        check(EffectCommands.Num() == 0);
+        return;
+    }
+
+    EffectCommands.Flush();
+}
+
 void UGWTSpellExecutionContext::LogContextState()
 {
     // Log current state for debugging
     UE_LOG(LogTemp, Display, TEXT("=== Spell Execution Context ==="));
     UE_LOG(LogTemp, Display, TEXT("Caster: %s"), Caster ? *Caster->GetName() : TEXT("None"));
     UE_LOG(LogTemp, Display, TEXT("Target: %s"), Target ? *Target->GetName() : TEXT("None"));
-    UE_LOG(LogTemp, Display, TEXT("Variables: %d"), Variables.Num());
+    UE_LOG(LogTemp, Display, TEXT("Variables: %d (+%d slots)"), Variables.Num(), VariableSlots.Num());
     UE_LOG(LogTemp, Display, TEXT("Stack Size: %d"), ExecutionStack.Num());
 
     // Log variables
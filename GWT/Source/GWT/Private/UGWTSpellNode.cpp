@@ -3,6 +3,7 @@
 
 #include "UGWTSpellNode.h"
 #include "UGWTSpellExecutionContext.h"
+#include "UGWTSpell.h"
 
 UGWTSpellNode::UGWTSpellNode()
 {
@@ -44,25 +45,34 @@ bool UGWTSpellNode::ValidateConnections()
 
 bool UGWTSpellNode::CanConnectInput(UGWTSpellNode* Node)
 {
-    // Default implementation allows any node as input
+    // Default implementation allows any node as input that would not close a loop
     // Derived classes may have restrictions
-    return Node != nullptr && Node != this;
+    return Node != nullptr && Node != this && !CanReach(Node);
 }
 
 bool UGWTSpellNode::CanConnectOutput(UGWTSpellNode* Node)
 {
-    // Default implementation allows any node as output
+    // Default implementation allows any node as output that would not close a loop
     // Derived classes may have restrictions
-    return Node != nullptr && Node != this;
+    return Node != nullptr && Node != this && !Node->CanReach(this);
 }
 
 void UGWTSpellNode::AddInputConnection(UGWTSpellNode* Node)
 {
+    // Reject connections that would let execution loop back on itself
+    if (Node && CanReach(Node))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Rejected connection %s -> %s: it would create a cycle"),
+            *Node->NodeTitle.ToString(), *NodeTitle.ToString());
+        return;
+    }
+
     // Add to inputs if valid and not already connected
     if (Node && Node != this && !InputNodes.Contains(Node))
     {
         InputNodes.Add(Node);
         Node->AddOutputConnection(this);
+        MarkModified();
 
         // Log connection
         UE_LOG(LogTemp, Verbose, TEXT("Node connection added: %s -> %s"),
@@ -72,10 +82,19 @@ void UGWTSpellNode::AddInputConnection(UGWTSpellNode* Node)
 
 void UGWTSpellNode::AddOutputConnection(UGWTSpellNode* Node)
 {
+    // Reject connections that would let execution loop back on itself
+    if (Node && Node != this && !OutputNodes.Contains(Node) && Node->CanReach(this))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Rejected output connection %s -> %s: it would create a cycle"),
+            *NodeTitle.ToString(), *Node->NodeTitle.ToString());
+        return;
+    }
+
     // Add to outputs if valid and not already connected
     if (Node && Node != this && !OutputNodes.Contains(Node))
     {
         OutputNodes.Add(Node);
+        MarkModified();
 
         // Log connection (don't add reciprocal connection to avoid infinite recursion)
         UE_LOG(LogTemp, Verbose, TEXT("Node output connection added: %s -> %s"),
@@ -90,6 +109,7 @@ void UGWTSpellNode::RemoveInputConnection(UGWTSpellNode* Node)
     {
         InputNodes.Remove(Node);
         Node->RemoveOutputConnection(this);
+        MarkModified();
 
         // Log disconnection
         UE_LOG(LogTemp, Verbose, TEXT("Node connection removed: %s -> %s"),
@@ -103,6 +123,7 @@ void UGWTSpellNode::RemoveOutputConnection(UGWTSpellNode* Node)
     if (Node && OutputNodes.Contains(Node))
     {
         OutputNodes.Remove(Node);
+        MarkModified();
 
         // Log disconnection (don't remove reciprocal connection to avoid infinite recursion)
         UE_LOG(LogTemp, Verbose, TEXT("Node output connection removed: %s -> %s"),
@@ -110,6 +131,64 @@ void UGWTSpellNode::RemoveOutputConnection(UGWTSpellNode* Node)
     }
 }
 
+void UGWTSpellNode::MarkModified()
+{
+    // Cached stats and the compiled program are keyed on the spell's graph version
+    if (OwningSpell)
+    {
+        OwningSpell->MarkGraphChanged();
+    }
+}
+
+#if WITH_EDITOR
+void UGWTSpellNode::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    // Any edited property can change the spell's cost or program
+    MarkModified();
+}
+#endif
+
+bool UGWTSpellNode::CanReach(const UGWTSpellNode* Node) const
+{
+    if (!Node)
+    {
+        return false;
+    }
+
+    // Iterative depth-first search so deep graphs cannot overflow the stack
+    TArray<const UGWTSpellNode*, TInlineAllocator<32>> Pending;
+    TSet<const UGWTSpellNode*> Visited;
+    Pending.Add(this);
+
+    while (Pending.Num() > 0)
+    {
+        const UGWTSpellNode* Current = Pending.Pop(false);
+        if (Current == Node)
+        {
+            return true;
+        }
+
+        bool bAlreadyVisited = false;
+        Visited.Add(Current, &bAlreadyVisited);
+        if (bAlreadyVisited)
+        {
+            continue;
+        }
+
+        for (const UGWTSpellNode* OutputNode : Current->OutputNodes)
+        {
+            if (OutputNode)
+            {
+                Pending.Add(OutputNode);
+            }
+        }
+    }
+
+    return false;
+}
+
 void UGWTSpellNode::Serialize(FArchive& Ar)
 {
     Super::Serialize(Ar);
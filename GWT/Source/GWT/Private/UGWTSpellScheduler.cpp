@@ -0,0 +1,230 @@
+// UGWTSpellScheduler.cpp
+// Implementation of the latent spell scheduler
+
+#include "UGWTSpellScheduler.h"
+#include "UGWTSpellContextPool.h"
+#include "UGWTSpellExecutionContext.h"
+#include "Engine/World.h"
+
+void UGWTSpellScheduler::Deinitialize()
+{
+    UE_LOG(LogTemp, Verbose, TEXT("Spell scheduler shutting down with %d suspended casts"), GetNumSuspendedCasts());
+
+    ActiveTasks.Empty();
+    IncomingTasks.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UGWTSpellScheduler::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UGWTSpellScheduler, STATGROUP_Tickables);
+}
+
+void UGWTSpellScheduler::StartCast(TSharedPtr<const FGWTSpellProgram> Program, UGWTSpellExecutionContext* Context,
+    TSharedPtr<const FGWTSpellDiagnostics> Diagnostics)
+{
+    if (Program.IsValid() && Program->ParallelEntries.Num() > 1)
+    {
+        StartParallelCast(MoveTemp(Program), Context, MoveTemp(Diagnostics));
+        return;
+    }
+
+    FGWTSpellTask Task(MoveTemp(Program), Context);
+    Task.Diagnostics = MoveTemp(Diagnostics);
+
+    // Run immediately so instant spells never wait a frame
+    const EGWTSpellRunResult Result = FGWTSpellVM::Run(Task, GetWorld()->GetTimeSeconds(), true);
+
+    if (Result == EGWTSpellRunResult::Suspended)
+    {
+        IncomingTasks.Add(MoveTemp(Task));
+        return;
+    }
+
+    FinishTask(Task);
+}
+
+void UGWTSpellScheduler::StartParallelCast(TSharedPtr<const FGWTSpellProgram> Program, UGWTSpellExecutionContext* Context,
+    TSharedPtr<const FGWTSpellDiagnostics> Diagnostics)
+{
+    UGWTSpellContextPool* ContextPool = GetWorld()->GetSubsystem<UGWTSpellContextPool>();
+    TSharedPtr<FGWTSpellSharedMeter, ESPMode::ThreadSafe> SharedMeter = MakeShared<FGWTSpellSharedMeter, ESPMode::ThreadSafe>();
+    if (++LastSiblingGroup == 0)
+    {
+        LastSiblingGroup = 1;
+    }
+    const uint32 SiblingGroup = LastSiblingGroup;
+
+    TArray<FGWTSpellTask, TInlineAllocator<8>> Tasks;
+    TArray<FGWTSpellTask*, TInlineAllocator<8>> TaskPointers;
+    for (int32 GroupIndex = 0; GroupIndex < Program->ParallelEntries.Num(); GroupIndex++)
+    {
+        UGWTSpellExecutionContext* TaskContext = GroupIndex == 0 ? Context : ContextPool->AcquireSibling(Context);
+
+        FGWTSpellTask& Task = Tasks.Emplace_GetRef(Program, TaskContext);
+        Task.EntryPC = Program->ParallelEntries[GroupIndex];
+        Task.SiblingGroup = SiblingGroup;
+        Task.SharedMeter = SharedMeter;
+        Task.Diagnostics = Diagnostics;
+    }
+    for (FGWTSpellTask& Task : Tasks)
+    {
+        TaskPointers.Add(&Task);
+    }
+
+    // First slices now, like a single-task cast
+    TArray<EGWTSpellRunResult, TInlineAllocator<8>> Results;
+    FGWTSpellVM::RunSiblings(TaskPointers, GetWorld()->GetTimeSeconds(), true, Results);
+
+    for (int32 i = 0; i < Tasks.Num(); i++)
+    {
+        if (Results[i] == EGWTSpellRunResult::Suspended)
+        {
+            IncomingTasks.Add(MoveTemp(Tasks[i]));
+        }
+        else
+        {
+            FinishTask(Tasks[i]);
+        }
+    }
+}
+
+void UGWTSpellScheduler::ResumeSiblings(int32 FirstIndex, double CurrentTime, TMap<int32, EGWTSpellRunResult>& OutResults)
+{
+    const uint32 SiblingGroup = ActiveTasks[FirstIndex].SiblingGroup;
+
+    // Siblings are never moved ahead of each other, so the rest of the group is further down the list
+    TArray<int32, TInlineAllocator<8>> Indices;
+    TArray<FGWTSpellTask*, TInlineAllocator<8>> Tasks;
+    for (int32 i = FirstIndex; i < ActiveTasks.Num(); i++)
+    {
+        FGWTSpellTask& Task = ActiveTasks[i];
+        if (Task.SiblingGroup == SiblingGroup && CanResume(Task) && Task.ResumeTime <= CurrentTime)
+        {
+            Indices.Add(i);
+            Tasks.Add(&Task);
+        }
+    }
+
+    TArray<EGWTSpellRunResult, TInlineAllocator<8>> Results;
+    FGWTSpellVM::RunSiblings(Tasks, CurrentTime, true, Results);
+
+    for (int32 i = 0; i < Indices.Num(); i++)
+    {
+        OutResults.Add(Indices[i], Results[i]);
+    }
+}
+
+bool UGWTSpellScheduler::CanResume(const FGWTSpellTask& Task)
+{
+    // Cancelled, or the caster left while the spell was suspended
+    return !Task.bCancelled && Task.Context && IsValid(Task.Context->Caster);
+}
+
+void UGWTSpellScheduler::Tick(float DeltaTime)
+{
+    // Pick up casts that suspended since the last tick
+    if (IncomingTasks.Num() > 0)
+    {
+        ActiveTasks.Append(MoveTemp(IncomingTasks));
+        IncomingTasks.Reset();
+    }
+
+    if (ActiveTasks.Num() == 0)
+    {
+        return;
+    }
+
+    const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+    // Results of siblings resumed alongside an earlier task of their cast
+    TMap<int32, EGWTSpellRunResult> SiblingResults;
+
+    // Resume everything that is due, compacting the list in place to keep cast order
+    int32 WriteIndex = 0;
+    for (int32 ReadIndex = 0; ReadIndex < ActiveTasks.Num(); ReadIndex++)
+    {
+        FGWTSpellTask& Task = ActiveTasks[ReadIndex];
+        bool bKeep = true;
+
+        if (!CanResume(Task))
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("Dropping suspended cast"));
+            FinishTask(Task);
+            bKeep = false;
+        }
+        else if (Task.ResumeTime <= CurrentTime)
+        {
+            EGWTSpellRunResult Result;
+            if (Task.SiblingGroup != 0)
+            {
+                // The first due sibling runs the whole group
+                if (!SiblingResults.Contains(ReadIndex))
+                {
+                    ResumeSiblings(ReadIndex, CurrentTime, SiblingResults);
+                }
+                Result = SiblingResults.FindAndRemoveChecked(ReadIndex);
+            }
+            else
+            {
+                Result = FGWTSpellVM::Run(Task, CurrentTime, true);
+            }
+
+            bKeep = Result == EGWTSpellRunResult::Suspended;
+            if (!bKeep)
+            {
+                FinishTask(Task);
+            }
+        }
+
+        if (bKeep)
+        {
+            if (WriteIndex != ReadIndex)
+            {
+                ActiveTasks[WriteIndex] = MoveTemp(Task);
+            }
+            WriteIndex++;
+        }
+    }
+
+    ActiveTasks.SetNum(WriteIndex, false);
+}
+
+void UGWTSpellScheduler::CancelCastsFor(AActor* Caster)
+{
+    // Only flag them, this can be called from inside Tick when a spell kills its caster
+    for (FGWTSpellTask& Task : ActiveTasks)
+    {
+        if (Task.Context && Task.Context->Caster == Caster)
+        {
+            Task.bCancelled = true;
+        }
+    }
+
+    for (FGWTSpellTask& Task : IncomingTasks)
+    {
+        if (Task.Context && Task.Context->Caster == Caster)
+        {
+            Task.bCancelled = true;
+        }
+    }
+}
+
+void UGWTSpellScheduler::FinishTask(FGWTSpellTask& Task)
+{
+    // Contexts are pool-owned, which is also what keeps them alive while suspended
+    if (UGWTSpellContextPool* ContextPool = GetWorld()->GetSubsystem<UGWTSpellContextPool>())
+    {
+        ContextPool->Release(Task.Context);
+    }
+
+    Task.Context = nullptr;
+    Task.Program.Reset();
+}
+
+UGWTSpellScheduler* UGWTSpellScheduler::Get(const AActor* WorldContext)
+{
+    UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UGWTSpellScheduler>() : nullptr;
+}
\ No newline at end of file
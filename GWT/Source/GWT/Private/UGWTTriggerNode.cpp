@@ -30,37 +30,10 @@ void UGWTTriggerNode::Execute(UGWTSpellExecutionContext* Context)
         return;
     }
 
-    // Handle based on trigger type
-    switch (TriggerType)
+    // Execute all output nodes if the trigger fires
+    if (EvaluateTrigger(Context, TriggerType, TriggerValue))
     {
-    case EGWTTriggerType::OnCast:
-        HandleOnCast(Context);
-        break;
-
-    case EGWTTriggerType::OnHit:
-        HandleOnHit(Context);
-        break;
-
-    case EGWTTriggerType::OnEnemyEnter:
-        HandleOnEnemyEnter(Context);
-        break;
-
-    case EGWTTriggerType::OnHealthBelow:
-        HandleOnHealthBelow(Context);
-        break;
-
-    case EGWTTriggerType::OnManaAbove:
-        HandleOnManaAbove(Context);
-        break;
-
-    case EGWTTriggerType::OnTimerExpired:
-        HandleOnTimerExpired(Context);
-        break;
-
-    default:
-        // Unknown trigger type, log warning
-        UE_LOG(LogTemp, Warning, TEXT("Unknown trigger type in Trigger node"));
-        break;
+        Super::Execute(Context);
     }
 }
 
@@ -81,132 +54,129 @@ bool UGWTTriggerNode::ShouldTrigger(UGWTSpellExecutionContext* Context)
     return true;
 }
 
-void UGWTTriggerNode::HandleOnCast(UGWTSpellExecutionContext* Context)
+bool UGWTTriggerNode::EvaluateTrigger(UGWTSpellExecutionContext* Context, EGWTTriggerType InTriggerType, float InTriggerValue)
 {
-    // OnCast trigger always executes on initial spell cast
-    // Simply execute all output nodes
-    for (UGWTSpellNode* OutputNode : OutputNodes)
+    // Handle based on trigger type
+    switch (InTriggerType)
     {
-        if (OutputNode)
-        {
-            OutputNode->Execute(Context);
-        }
+    case EGWTTriggerType::OnCast:
+        return HandleOnCast(Context);
+
+    case EGWTTriggerType::OnHit:
+        return HandleOnHit(Context);
+
+    case EGWTTriggerType::OnEnemyEnter:
+        return HandleOnEnemyEnter(Context);
+
+    case EGWTTriggerType::OnHealthBelow:
+        // Queued healing or damage must land before health is read
+        Context->FlushBeforeRead();
+        return HandleOnHealthBelow(Context, InTriggerValue);
+
+    case EGWTTriggerType::OnManaAbove:
+        return HandleOnManaAbove(Context, InTriggerValue);
+
+    case EGWTTriggerType::OnTimerExpired:
+        return HandleOnTimerExpired(Context, InTriggerValue);
+
+    default:
+        // Unknown trigger type, log warning
+        UE_LOG(LogTemp, Warning, TEXT("Unknown trigger type in Trigger node"));
+        return false;
     }
+}
 
+bool UGWTTriggerNode::HandleOnCast(UGWTSpellExecutionContext* Context)
+{
+    // OnCast trigger always executes on initial spell cast
     UE_LOG(LogTemp, Verbose, TEXT("OnCast trigger executed"));
+
+    return true;
 }
 
-void UGWTTriggerNode::HandleOnHit(UGWTSpellExecutionContext* Context)
+bool UGWTTriggerNode::HandleOnHit(UGWTSpellExecutionContext* Context)
 {
     // OnHit requires a valid hit result
-    if (Context->HitResult.GetActor())
+    if (Context->ReadActor(EGWTSpellActor::HitActor).IsValid())
     {
-        // Execute all output nodes
-        for (UGWTSpellNode* OutputNode : OutputNodes)
-        {
-            if (OutputNode)
-            {
-                OutputNode->Execute(Context);
-            }
-        }
+        UE_LOG(LogTemp, Verbose, TEXT("OnHit trigger executed"));
 
-        UE_LOG(LogTemp, Verbose, TEXT("OnHit trigger executed, hit actor: %s"),
-            *Context->HitResult.GetActor()->GetName());
+        return true;
     }
+
+    return false;
 }
 
-void UGWTTriggerNode::HandleOnEnemyEnter(UGWTSpellExecutionContext* Context)
+bool UGWTTriggerNode::HandleOnEnemyEnter(UGWTSpellExecutionContext* Context)
 {
     // This would typically be implemented with overlap events
     // For this example, we'll simulate it based on the hit result
 
-    if (Context->HitResult.GetActor())
+    const FGWTSpellActorState HitActor = Context->ReadActor(EGWTSpellActor::HitActor);
+    if (HitActor.IsValid())
     {
         // Check if hit actor is an enemy (simplified implementation)
-        AGWTCharacter* HitCharacter = Cast<AGWTCharacter>(Context->HitResult.GetActor());
-        if (HitCharacter && HitCharacter != Context->Caster)
+        if (HitActor.bIsCharacter && HitActor.Actor != Context->Caster)
         {
-            // Execute all output nodes
-            for (UGWTSpellNode* OutputNode : OutputNodes)
-            {
-                if (OutputNode)
-                {
-                    OutputNode->Execute(Context);
-                }
-            }
-
-            UE_LOG(LogTemp, Verbose, TEXT("OnEnemyEnter trigger executed for enemy: %s"),
-                *HitCharacter->GetName());
+            UE_LOG(LogTemp, Verbose, TEXT("OnEnemyEnter trigger executed"));
+
+            return true;
         }
     }
+
+    return false;
 }
 
-void UGWTTriggerNode::HandleOnHealthBelow(UGWTSpellExecutionContext* Context)
+bool UGWTTriggerNode::HandleOnHealthBelow(UGWTSpellExecutionContext* Context, float InTriggerValue)
 {
     // Check caster's health
-    AGWTCharacter* CasterCharacter = Cast<AGWTCharacter>(Context->Caster);
-    if (CasterCharacter)
+    const FGWTSpellActorState CasterState = Context->ReadActor(EGWTSpellActor::Caster);
+    if (CasterState.bIsCharacter)
     {
-        float HealthPercentage = (CasterCharacter->CurrentHealth / CasterCharacter->MaxHealth) * 100.0f;
+        float HealthPercentage = (CasterState.CurrentHealth / CasterState.MaxHealth) * 100.0f;
 
         // If health percentage is below trigger value
-        if (HealthPercentage <= TriggerValue)
+        if (HealthPercentage <= InTriggerValue)
         {
-            // Execute all output nodes
-            for (UGWTSpellNode* OutputNode : OutputNodes)
-            {
-                if (OutputNode)
-                {
-                    OutputNode->Execute(Context);
-                }
-            }
-
             UE_LOG(LogTemp, Verbose, TEXT("OnHealthBelow trigger executed, health: %.1f%%, threshold: %.1f%%"),
-                HealthPercentage, TriggerValue);
+                HealthPercentage, InTriggerValue);
+
+            return true;
         }
     }
+
+    return false;
 }
 
-void UGWTTriggerNode::HandleOnManaAbove(UGWTSpellExecutionContext* Context)
+bool UGWTTriggerNode::HandleOnManaAbove(UGWTSpellExecutionContext* Context, float InTriggerValue)
 {
     // Check caster's mana
-    AGWTCharacter* CasterCharacter = Cast<AGWTCharacter>(Context->Caster);
-    if (CasterCharacter)
+    const FGWTSpellActorState CasterState = Context->ReadActor(EGWTSpellActor::Caster);
+    if (CasterState.bIsCharacter)
     {
-        float ManaPercentage = (CasterCharacter->CurrentMana / CasterCharacter->MaxMana) * 100.0f;
+        float ManaPercentage = (CasterState.CurrentMana / CasterState.MaxMana) * 100.0f;
 
         // If mana percentage is above trigger value
-        if (ManaPercentage >= TriggerValue)
+        if (ManaPercentage >= InTriggerValue)
         {
-            // Execute all output nodes
-            for (UGWTSpellNode* OutputNode : OutputNodes)
-            {
-                if (OutputNode)
-                {
-                    OutputNode->Execute(Context);
-                }
-            }
-
             UE_LOG(LogTemp, Verbose, TEXT("OnManaAbove trigger executed, mana: %.1f%%, threshold: %.1f%%"),
-                ManaPercentage, TriggerValue);
+                ManaPercentage, InTriggerValue);
+
+            return true;
         }
     }
+
+    return false;
 }
 
-void UGWTTriggerNode::HandleOnTimerExpired(UGWTSpellExecutionContext* Context)
+bool UGWTTriggerNode::HandleOnTimerExpired(UGWTSpellExecutionContext* Context, float InTriggerValue)
 {
     // Timer-based triggers would typically be implemented with a timer system
     // For this example, we'll just log that it would execute after the specified time
 
-    UE_LOG(LogTemp, Display, TEXT("Timer trigger would execute after %.1f seconds"), TriggerValue);
+    UE_LOG(LogTemp, Display, TEXT("Timer trigger would execute after %.1f seconds"), InTriggerValue);
 
     // In a real implementation, you'd set up a timer
     // For now, we'll execute immediately for demonstration
-    for (UGWTSpellNode* OutputNode : OutputNodes)
-    {
-        if (OutputNode)
-        {
-            OutputNode->Execute(Context);
-        }
-    }
+    return true;
 }
\ No newline at end of file
@@ -32,31 +32,63 @@ void UGWTVariableNode::Execute(UGWTSpellExecutionContext* Context)
         return;
     }
 
+    // Perform the operation
+    ApplyVariableOperation(Context, VariableName, Operation, DefaultValue);
+
+    // Execute connected nodes
+    Super::Execute(Context);
+}
+
+void UGWTVariableNode::ApplyVariableOperation(UGWTSpellExecutionContext* Context, FName InVariableName,
+    EVariableOperation InOperation, const FGWTVariableValue& InDefaultValue)
+{
+    // Resolve against the context's named variables, converting at the boundary
+    FGWTRuntimeValue CurrentValue;
+    const bool bHasValue = Context->TryGetVariable(InVariableName, CurrentValue);
+
+    FGWTRuntimeValue NewValue;
+    if (ResolveOperation(Context, InVariableName, InOperation, bHasValue ? &CurrentValue : nullptr,
+        FGWTRuntimeValue::FromVariableValue(InDefaultValue), NewValue))
+    {
+        Context->SetVariable(InVariableName, NewValue.ToVariableValue());
+    }
+}
+
+void UGWTVariableNode::ApplyVariableOperationToSlot(UGWTSpellExecutionContext* Context, int32 Slot, FName InVariableName,
+    EVariableOperation InOperation, const FGWTRuntimeValue& InDefaultValue)
+{
+    // Same as above, but indexed directly into the context's slot array
+    FGWTRuntimeValue NewValue;
+    if (ResolveOperation(Context, InVariableName, InOperation, Context->FindSlot(Slot), InDefaultValue, NewValue))
+    {
+        Context->SetSlot(Slot, NewValue);
+    }
+}
+
+bool UGWTVariableNode::ResolveOperation(UGWTSpellExecutionContext* Context, FName InVariableName, EVariableOperation InOperation,
+    const FGWTRuntimeValue* CurrentValue, const FGWTRuntimeValue& InDefaultValue, FGWTRuntimeValue& OutValue)
+{
     // Handle based on operation type
-    switch (Operation)
+    switch (InOperation)
     {
     case EVariableOperation::Read:
-        ReadVariable(Context);
-        break;
+        return ReadVariable(InVariableName, CurrentValue, InDefaultValue, OutValue);
 
     case EVariableOperation::Write:
-        WriteVariable(Context);
-        break;
+        WriteVariable(Context, InVariableName, InDefaultValue, OutValue);
+        return true;
 
     case EVariableOperation::Add:
     case EVariableOperation::Subtract:
     case EVariableOperation::Multiply:
     case EVariableOperation::Divide:
-        ModifyVariable(Context);
-        break;
+        ModifyVariable(Context, InVariableName, InOperation, CurrentValue, InDefaultValue, OutValue);
+        return true;
 
     default:
         UE_LOG(LogTemp, Warning, TEXT("Unknown operation type in Variable node"));
-        break;
+        return false;
     }
-
-    // Execute connected nodes
-    Super::Execute(Context);
 }
 
 EGWTSpellComponentType UGWTVariableNode::GetNodeType() const
@@ -69,143 +101,70 @@ FString UGWTVariableNode::GetNodeTypeAsString() const
     return TEXT("Variable");
 }
 
-void UGWTVariableNode::ReadVariable(UGWTSpellExecutionContext* Context)
+bool UGWTVariableNode::ReadVariable(FName InVariableName, const FGWTRuntimeValue* CurrentValue,
+    const FGWTRuntimeValue& InDefaultValue, FGWTRuntimeValue& OutValue)
 {
     // Check if variable exists in context
-    if (Context->HasVariable(VariableName))
+    if (CurrentValue)
     {
-        // Variable exists, use it
-        FGWTVariableValue Value = Context->GetVariable(VariableName);
-
-        // Log the variable value
-        switch (Value.Type)
-        {
-        case EGWTVariableType::Float:
-            UE_LOG(LogTemp, Verbose, TEXT("Read variable %s: %f"), *VariableName.ToString(), Value.FloatValue);
-            break;
-
-        case EGWTVariableType::Int:
-            UE_LOG(LogTemp, Verbose, TEXT("Read variable %s: %d"), *VariableName.ToString(), Value.IntValue);
-            break;
-
-        case EGWTVariableType::Bool:
-            UE_LOG(LogTemp, Verbose, TEXT("Read variable %s: %s"), *VariableName.ToString(),
-                Value.BoolValue ? TEXT("True") : TEXT("False"));
-            break;
-
-        case EGWTVariableType::Vector:
-            UE_LOG(LogTemp, Verbose, TEXT("Read variable %s: (%f, %f, %f)"), *VariableName.ToString(),
-                Value.VectorValue.X, Value.VectorValue.Y, Value.VectorValue.Z);
-            break;
-
-        case EGWTVariableType::Target:
-            UE_LOG(LogTemp, Verbose, TEXT("Read variable %s: %s"), *VariableName.ToString(),
-                Value.TargetValue ? *Value.TargetValue->GetName() : TEXT("None"));
-            break;
-
-        default:
-            UE_LOG(LogTemp, Warning, TEXT("Unknown variable type"));
-            break;
-        }
+        // Variable exists, nothing to store
+        UE_LOG(LogTemp, Verbose, TEXT("Read variable %s: %s"), *InVariableName.ToString(), *CurrentValue->ToString());
+        return false;
     }
-    else
-    {
-        // Variable doesn't exist, use default
-        Context->SetVariable(VariableName, DefaultValue);
 
-        UE_LOG(LogTemp, Verbose, TEXT("Variable %s not found, using default value"), *VariableName.ToString());
-    }
+    // Variable doesn't exist, use default
+    OutValue = InDefaultValue;
+
+    UE_LOG(LogTemp, Verbose, TEXT("Variable %s not found, using default value"), *InVariableName.ToString());
+    return true;
 }
 
-void UGWTVariableNode::WriteVariable(UGWTSpellExecutionContext* Context)
+void UGWTVariableNode::WriteVariable(UGWTSpellExecutionContext* Context, FName InVariableName,
+    const FGWTRuntimeValue& InDefaultValue, FGWTRuntimeValue& OutValue)
 {
-    // Get the value to write
-    FGWTVariableValue ValueToWrite = GetOperationValue(Context);
-
-    // Write to the context
-    Context->SetVariable(VariableName, ValueToWrite);
-
-    // Log the variable write
-    switch (ValueToWrite.Type)
-    {
-    case EGWTVariableType::Float:
-        UE_LOG(LogTemp, Verbose, TEXT("Write variable %s = %f"), *VariableName.ToString(), ValueToWrite.FloatValue);
-        break;
-
-    case EGWTVariableType::Int:
-        UE_LOG(LogTemp, Verbose, TEXT("Write variable %s = %d"), *VariableName.ToString(), ValueToWrite.IntValue);
-        break;
+    // Get the value to write, the caller stores it
+    OutValue = GetOperationValue(Context, InDefaultValue);
 
-    case EGWTVariableType::Bool:
-        UE_LOG(LogTemp, Verbose, TEXT("Write variable %s = %s"), *VariableName.ToString(),
-            ValueToWrite.BoolValue ? TEXT("True") : TEXT("False"));
-        break;
-
-    case EGWTVariableType::Vector:
-        UE_LOG(LogTemp, Verbose, TEXT("Write variable %s = (%f, %f, %f)"), *VariableName.ToString(),
-            ValueToWrite.VectorValue.X, ValueToWrite.VectorValue.Y, ValueToWrite.VectorValue.Z);
-        break;
-
-    case EGWTVariableType::Target:
-        UE_LOG(LogTemp, Verbose, TEXT("Write variable %s = %s"), *VariableName.ToString(),
-            ValueToWrite.TargetValue ? *ValueToWrite.TargetValue->GetName() : TEXT("None"));
-        break;
-
-    default:
-        UE_LOG(LogTemp, Warning, TEXT("Unknown variable type"));
-        break;
-    }
+    UE_LOG(LogTemp, Verbose, TEXT("Write variable %s = %s"), *InVariableName.ToString(), *OutValue.ToString());
 }
 
-void UGWTVariableNode::ModifyVariable(UGWTSpellExecutionContext* Context)
+void UGWTVariableNode::ModifyVariable(UGWTSpellExecutionContext* Context, FName InVariableName, EVariableOperation InOperation,
+    const FGWTRuntimeValue* ExistingValue, const FGWTRuntimeValue& InDefaultValue, FGWTRuntimeValue& OutValue)
 {
     // Get the current value (or default if it doesn't exist)
-    FGWTVariableValue CurrentValue;
-    if (Context->HasVariable(VariableName))
-    {
-        CurrentValue = Context->GetVariable(VariableName);
-    }
-    else
-    {
-        CurrentValue = DefaultValue;
-    }
+    const FGWTRuntimeValue& CurrentValue = ExistingValue ? *ExistingValue : InDefaultValue;
 
     // Get the operation value
-    FGWTVariableValue OperationValue = GetOperationValue(Context);
+    const FGWTRuntimeValue OperationValue = GetOperationValue(Context, InDefaultValue);
 
-    // Apply modification based on operation type
-    FGWTVariableValue ResultValue = CurrentValue; // Start with current value
+    // Start with current value
+    OutValue = CurrentValue;
 
     // Only numeric types can be modified
-    if (CurrentValue.Type == EGWTVariableType::Float && OperationValue.Type == EGWTVariableType::Float)
+    if (CurrentValue.GetType() == EGWTVariableType::Float && OperationValue.GetType() == EGWTVariableType::Float)
     {
+        const float A = CurrentValue.GetFloat();
+        const float B = OperationValue.GetFloat();
+
         // Apply float operation
-        switch (Operation)
+        switch (InOperation)
         {
         case EVariableOperation::Add:
-            ResultValue.FloatValue = CurrentValue.FloatValue + OperationValue.FloatValue;
-            UE_LOG(LogTemp, Verbose, TEXT("Modified variable %s: %f + %f = %f"),
-                *VariableName.ToString(), CurrentValue.FloatValue, OperationValue.FloatValue, ResultValue.FloatValue);
+            OutValue = FGWTRuntimeValue::MakeFloat(A + B);
             break;
 
         case EVariableOperation::Subtract:
-            ResultValue.FloatValue = CurrentValue.FloatValue - OperationValue.FloatValue;
-            UE_LOG(LogTemp, Verbose, TEXT("Modified variable %s: %f - %f = %f"),
-                *VariableName.ToString(), CurrentValue.FloatValue, OperationValue.FloatValue, ResultValue.FloatValue);
+            OutValue = FGWTRuntimeValue::MakeFloat(A - B);
             break;
 
         case EVariableOperation::Multiply:
-            ResultValue.FloatValue = CurrentValue.FloatValue * OperationValue.FloatValue;
-            UE_LOG(LogTemp, Verbose, TEXT("Modified variable %s: %f * %f = %f"),
-                *VariableName.ToString(), CurrentValue.FloatValue, OperationValue.FloatValue, ResultValue.FloatValue);
+            OutValue = FGWTRuntimeValue::MakeFloat(A * B);
             break;
 
         case EVariableOperation::Divide:
-            if (OperationValue.FloatValue != 0.0f)
+            if (B != 0.0f)
             {
-                ResultValue.FloatValue = CurrentValue.FloatValue / OperationValue.FloatValue;
-                UE_LOG(LogTemp, Verbose, TEXT("Modified variable %s: %f / %f = %f"),
-                    *VariableName.ToString(), CurrentValue.FloatValue, OperationValue.FloatValue, ResultValue.FloatValue);
+                OutValue = FGWTRuntimeValue::MakeFloat(A / B);
             }
             else
             {
@@ -218,35 +177,30 @@ void UGWTVariableNode::ModifyVariable(UGWTSpellExecutionContext* Context)
             break;
         }
     }
-    else if (CurrentValue.Type == EGWTVariableType::Int && OperationValue.Type == EGWTVariableType::Int)
+    else if (CurrentValue.GetType() == EGWTVariableType::Int && OperationValue.GetType() == EGWTVariableType::Int)
     {
+        const int32 A = CurrentValue.GetInt();
+        const int32 B = OperationValue.GetInt();
+
         // Apply int operation
-        switch (Operation)
+        switch (InOperation)
         {
         case EVariableOperation::Add:
-            ResultValue.IntValue = CurrentValue.IntValue + OperationValue.IntValue;
-            UE_LOG(LogTemp, Verbose, TEXT("Modified variable %s: %d + %d = %d"),
-                *VariableName.ToString(), CurrentValue.IntValue, OperationValue.IntValue, ResultValue.IntValue);
+            OutValue = FGWTRuntimeValue::MakeInt(A + B);
             break;
 
         case EVariableOperation::Subtract:
-            ResultValue.IntValue = CurrentValue.IntValue - OperationValue.IntValue;
-            UE_LOG(LogTemp, Verbose, TEXT("Modified variable %s: %d - %d = %d"),
-                *VariableName.ToString(), CurrentValue.IntValue, OperationValue.IntValue, ResultValue.IntValue);
+            OutValue = FGWTRuntimeValue::MakeInt(A - B);
             break;
 
         case EVariableOperation::Multiply:
-            ResultValue.IntValue = CurrentValue.IntValue * OperationValue.IntValue;
-            UE_LOG(LogTemp, Verbose, TEXT("Modified variable %s: %d * %d = %d"),
-                *VariableName.ToString(), CurrentValue.IntValue, OperationValue.IntValue, ResultValue.IntValue);
+            OutValue = FGWTRuntimeValue::MakeInt(A * B);
             break;
 
         case EVariableOperation::Divide:
-            if (OperationValue.IntValue != 0)
+            if (B != 0)
             {
-                ResultValue.IntValue = CurrentValue.IntValue / OperationValue.IntValue;
-                UE_LOG(LogTemp, Verbose, TEXT("Modified variable %s: %d / %d = %d"),
-                    *VariableName.ToString(), CurrentValue.IntValue, OperationValue.IntValue, ResultValue.IntValue);
+                OutValue = FGWTRuntimeValue::MakeInt(A / B);
             }
             else
             {
@@ -261,26 +215,24 @@ void UGWTVariableNode::ModifyVariable(UGWTSpellExecutionContext* Context)
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("Cannot modify variable of type %d"), (int)CurrentValue.Type);
+        UE_LOG(LogTemp, Warning, TEXT("Cannot modify variable of type %d"), (int)CurrentValue.GetType());
+        return;
     }
 
-    // Write the result back to the context
-    Context->SetVariable(VariableName, ResultValue);
+    UE_LOG(LogTemp, Verbose, TEXT("Modified variable %s: %s -> %s"),
+        *InVariableName.ToString(), *CurrentValue.ToString(), *OutValue.ToString());
 }
 
-FGWTVariableValue UGWTVariableNode::GetOperationValue(UGWTSpellExecutionContext* Context)
+FGWTRuntimeValue UGWTVariableNode::GetOperationValue(UGWTSpellExecutionContext* Context, const FGWTRuntimeValue& InDefaultValue)
 {
     // For this implementation, we'll just use the default value
     // In a full implementation, this might come from input connections or other sources
 
-    // Create a context-specific value
-    FGWTVariableValue Value = DefaultValue;
-
     // If the variable type is Target, we might want to use the current target
-    if (Value.Type == EGWTVariableType::Target && Value.TargetValue == nullptr && Context->Target)
+    if (InDefaultValue.GetType() == EGWTVariableType::Target && InDefaultValue.GetTarget() == nullptr && Context->Target)
     {
-        Value.TargetValue = Context->Target;
+        return FGWTRuntimeValue::MakeTarget(Context->Target);
     }
 
-    return Value;
+    return InDefaultValue;
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "UGWTWand.h"
 #include "AGWTCharacter.h"
+#include "UGWTRandomService.h"
 
 UGWTWand::UGWTWand()
 {
@@ -149,6 +150,7 @@ float UGWTWand::GetManaCostMultiplier() const
 bool UGWTWand::ShouldCrit() const
 {
     // Determine if a spell should critically hit
-    float Random = FMath::FRand() * 100.0f;
+    const FGWTRandomKey Key(EGWTRandomDomain::CriticalHit, UGWTRandomService::GetStreamID(this), CritRollCount++);
+    float Random = UGWTRandomService::FRand(this, Key) * 100.0f;
     return Random <= CriticalHitChance;
 }
\ No newline at end of file
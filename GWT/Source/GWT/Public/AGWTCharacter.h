@@ -54,10 +54,25 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     USkeletalMeshComponent* RobeMesh;
 
+    // Equipped items that modify spellcasting
+    UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+    class UGWTWand* EquippedWand = nullptr;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+    class UGWTRobe* EquippedRobe = nullptr;
+
+    // Room whose trigger this character is inside, kept by AGWTRoom, null in doorways
+    UPROPERTY(BlueprintReadOnly, Category = "Position")
+    class AGWTRoom* CurrentRoom = nullptr;
+
     // Methods
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
 
+    // Per-frame upkeep done by Tick, called directly for characters whose actor tick is off
+    void TickCharacterState(float DeltaTime);
+
     UFUNCTION(BlueprintCallable, Category = "Health")
     virtual void TakeDamage(float Damage, EGWTElementType DamageType, AActor* DamageCauser);
 
@@ -92,6 +107,18 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Equipment")
     virtual void EquipRobe(class UGWTRobe* Robe);
 
+    // Mana cost multiplier from equipment, spells cache their final cost against GetManaCostVersion
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Mana")
+    virtual float GetManaCostMultiplier() const;
+
+    int32 GetManaCostVersion() const { return ManaCostVersion; }
+
+    // Call when anything feeding GetManaCostMultiplier changes
+    void MarkManaCostChanged() { ManaCostVersion++; }
+
+    // This character's stream for combat rolls, see UGWTRandomService
+    uint32 GetRandomStreamID() const { return RandomStreamID; }
+
     // Status getters
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Stats")
     float GetHealthPercent() const;
@@ -103,12 +130,29 @@ public:
     bool HasStatusEffect(EGWTStatusEffectType EffectType) const;
 
 protected:
+    // Undo OnDeath so a pooled character can be handed out again, full health and mana and no effects
+    void Revive();
+
+    // Remove every active effect through RemoveStatusEffect so their side effects are undone too
+    void ClearStatusEffects();
+
     // Apply damage over time from status effects
     void ApplyStatusEffectDamage(float DeltaTime);
 
     // Update status effect durations
     void UpdateStatusEffectDurations(float DeltaTime);
 
+    // Bumped whenever the mana cost multiplier may have changed
+    int32 ManaCostVersion = 0;
+
+    // Random stream, set at BeginPlay, and the number of damage events rolled on it
+    uint32 RandomStreamID = 0;
+    uint32 DamageEventCount = 0;
+
+    // Proximity index this character is filed in while alive, see UGWTCharacterSpatialHash
+    UPROPERTY()
+    class UGWTCharacterSpatialHash* SpatialHash = nullptr;
+
     // Mana regeneration timer
     FTimerHandle ManaRegenTimerHandle;
 
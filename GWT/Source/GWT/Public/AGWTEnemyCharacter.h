@@ -6,20 +6,21 @@
 #include "CoreMinimal.h"
 #include "AGWTCharacter.h"
 #include "GWTTypes.h"
+#include "UGWTActorPool.h"
 #include "AGWTEnemyCharacter.generated.h"
 
 // Forward declarations
-class UAIPerceptionComponent;
-class UPawnSensingComponent;
 class UGWTSpell;
+class AGWTPlayerCharacter;
 
 /**
  * Base enemy character class for Grand Wizard Tournament
  * Provides AI behavior, perception, and combat functionality
  * Serves as the foundation for all different enemy types
+ * Spawned enemies come from UGWTActorPool and go back to it after death
  */
 UCLASS()
-class GWT_API AGWTEnemyCharacter : public AGWTCharacter
+class GWT_API AGWTEnemyCharacter : public AGWTCharacter, public IGWTPooledActor
 {
     GENERATED_BODY()
 
@@ -51,12 +52,23 @@ public:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Enemy")
     float MaxAttackCooldown = 4.0f;
 
-    // AI components
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-    UAIPerceptionComponent* PerceptionComponent;
+    // Seconds a pooled enemy's body lies before it goes back to the pool
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Enemy")
+    float CorpseDuration = 3.0f;
+
+    // Senses, evaluated by UGWTSensingService
+    // Degrees either side of the facing direction
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Senses")
+    float PeripheralVisionAngle = 90.0f;
 
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-    UPawnSensingComponent* SensingComponent;
+    // Noises are heard through walls within this range, and within LOSHearingThreshold with a clear line
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Senses")
+    float HearingThreshold = 500.0f;
+
+    // Beyond HearingThreshold a noise waits for a trace to its instigator, in any direction, and is heard
+    // a tick or two late if the line is clear, or dropped after UGWTSensingService::HearingTraceTimeout
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Senses")
+    float LOSHearingThreshold = 1000.0f;
 
     // Current target
     UPROPERTY(BlueprintReadOnly, Category = "AI")
@@ -72,6 +84,10 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "AI")
     bool bIsAttacking = false;
 
+    // Level of detail set by UGWTEnemyAIManager from the distance to the players
+    UPROPERTY(BlueprintReadOnly, Category = "AI")
+    EGWTAILOD AILOD = EGWTAILOD::Full;
+
     // Patrol points
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Patrol")
     TArray<FVector> PatrolPoints;
@@ -88,9 +104,14 @@ public:
 
     // Methods
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
     virtual void OnDeath() override;
 
+    // Pooled actor interface
+    virtual void OnAcquiredFromPool() override;
+    virtual void OnReleasedToPool() override;
+
     UFUNCTION(BlueprintCallable, Category = "AI")
     virtual void DetectPlayer();
 
@@ -115,7 +136,7 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Rewards")
     virtual void GrantExperience();
 
-    // Sensory events
+    // Sensory events, raised by UGWTSensingService
     UFUNCTION()
     void OnSeePlayer(APawn* Pawn);
 
@@ -134,10 +155,27 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AI")
     APawn* GetClosestPlayer() const;
 
+    // Decision outcomes, shared by Tick and UGWTEnemyAIManager
+    // Drop the target and go back to patrolling
+    void LoseTarget();
+
+    // Start the attack sequence unless it is already running
+    void BeginAttack();
+
+    // Step along Direction and face Facing
+    void MoveAndFace(const FVector& Direction, const FRotator& Facing);
+
+    // Take a nearby player as target once line of sight confirms it
+    void TryDetect(APawn* Player);
+
+    // Throttle animation and movement for a level of detail, the sensing service reads AILOD itself
+    void SetAILOD(EGWTAILOD NewLOD);
+
 protected:
     // AI behavior timers
     FTimerHandle AttackTimerHandle;
     FTimerHandle PatrolTimerHandle;
+    FTimerHandle PoolReleaseTimerHandle;
 
     // Current attack cooldown
     float CurrentAttackCooldown = 2.0f;
@@ -145,6 +183,15 @@ protected:
     // Initialize AI behavior
     virtual void InitializeAI();
 
+    // Start thinking and sensing, at BeginPlay and whenever the pool hands the enemy out
+    void ActivateAI();
+
+    // Stop thinking and sensing, at death and whenever the enemy goes back to the pool
+    void DeactivateAI();
+
+    // Corpse timer callback
+    void ReturnToPool();
+
     // Set up patrol points
     virtual void SetupPatrolPoints();
 
@@ -161,6 +208,9 @@ protected:
     // Get movement destination for patrol
     virtual FVector GetNextPatrolPoint() const;
 
+    // Living players within Range, used to share out rewards
+    void GetPlayersInRange(float Range, TArray<AGWTPlayerCharacter*>& OutPlayers) const;
+
     // Create and initialize enemy spells
     virtual void InitializeSpells();
 };
\ No newline at end of file
@@ -7,9 +7,13 @@
 #include "GameFramework/GameState.h"
 #include "AGWTGameState.generated.h"
 
+// Forward declarations
+class AGWTPlayerCharacter;
+
 /**
  * Game state class for Grand Wizard Tournament
  * Tracks score, time, and other global game information
+ * Owns the registry of live players that enemy AI searches
  */
 UCLASS()
 class GWT_API AGWTGameState : public AGameState
@@ -58,4 +62,29 @@ public:
 
     UFUNCTION(BlueprintCallable, Category = "Enemies")
     void EnemySpawned();
-};
+
+    // Player registry, kept by the players on possess, unpossess and death
+    void RegisterPlayer(AGWTPlayerCharacter* Player);
+    void UnregisterPlayer(AGWTPlayerCharacter* Player);
+
+    // Living possessed players, contiguous and in registration order
+    const TArray<AGWTPlayerCharacter*>& GetLivePlayers() const { return LivePlayers; }
+
+    // Locations parallel to GetLivePlayers, sampled once per frame
+    const TArray<FVector>& GetLivePlayerLocations();
+
+    // Nearest live player within MaxRange, or null
+    AGWTPlayerCharacter* FindClosestPlayer(const FVector& Location, float MaxRange);
+
+    // Every live player within Range, in registration order
+    void GetPlayersInRange(const FVector& Location, float Range, TArray<AGWTPlayerCharacter*>& OutPlayers);
+
+protected:
+    UPROPERTY()
+    TArray<AGWTPlayerCharacter*> LivePlayers;
+
+    TArray<FVector> LivePlayerLocations;
+
+    // Frame LivePlayerLocations was sampled on, reset whenever the registry changes
+    uint64 LocationsFrame = MAX_uint64;
+};
\ No newline at end of file
@@ -111,6 +111,21 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Navigation")
     AGWTRoom* GetRoom(int32 X, int32 Y, int32 Z) const;
 
+    // Grid cell of the room centred nearest a world position, may lie outside the grid
+    UFUNCTION(BlueprintCallable, Category = "Navigation")
+    FIntVector WorldToGridPosition(const FVector& WorldPosition) const;
+
+    // Room containing a world position, a constant-time grid lookup, null outside the labyrinth
+    UFUNCTION(BlueprintCallable, Category = "Navigation")
+    AGWTRoom* GetRoomAtLocation(const FVector& WorldPosition) const;
+
+    // Door steps from the nearest source room to every room within MaxDistance, sources are 0
+    void GetRoomDistances(const TArray<const AGWTRoom*>& SourceRooms, int32 MaxDistance,
+        TMap<const AGWTRoom*, int32>& OutDistances) const;
+
+    // Room through a room's open door, null when the door is closed or leads off the grid
+    AGWTRoom* GetRoomThroughDoor(const AGWTRoom* Room, EGWTDirection Direction) const;
+
     UFUNCTION(BlueprintCallable, Category = "Navigation")
     FIntVector GetSpawnRoomPosition() const;
 
@@ -62,6 +62,8 @@ public:
     virtual void Tick(float DeltaTime) override;
     virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
     virtual void OnDeath() override;
+    virtual void PossessedBy(AController* NewController) override;
+    virtual void UnPossessed() override;
 
     // Movement methods
     UFUNCTION(BlueprintCallable, Category = "Movement")
@@ -114,6 +116,9 @@ public:
     // Override status effect handling for player-specific behavior
     virtual void ApplyStatusEffect(FGWTStatusEffect Effect) override;
 
+    // Equipment multiplier plus the Mana Efficiency skill
+    virtual float GetManaCostMultiplier() const override;
+
 protected:
     // Input flags
     bool bMoveForward = false;
@@ -11,12 +11,15 @@
 // Forward declarations
 class UStaticMeshComponent;
 class UChildActorComponent;
+class UBoxComponent;
 class AGWTCharacter;
+class AGWTEnemyCharacter;
 
 /**
  * Room class that represents a single cell in the labyrinth
  * Handles doors, enemy spawning, and player interaction
  * Rooms are connected in a 3D grid to form the complete labyrinth
+ * Keeps its own occupant sets so room logic never has to query physics
  */
 UCLASS()
 class GWT_API AGWTRoom : public AActor
@@ -72,8 +75,23 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "Doors")
     TMap<EGWTDirection, bool> DoorStates;
 
+    // Actors inside the trigger box, kept by the overlap events
+    UPROPERTY(BlueprintReadOnly, Category = "Occupants")
+    TSet<AGWTCharacter*> PlayerOccupants;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Occupants")
+    TSet<AGWTEnemyCharacter*> EnemyOccupants;
+
+    // Item pickups, recognised by ItemTag
+    UPROPERTY(BlueprintReadOnly, Category = "Occupants")
+    TSet<AActor*> ItemOccupants;
+
+    // Actor tag marking item pickups as room occupants
+    static const FName ItemTag;
+
     // Methods
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
 
     UFUNCTION(BlueprintCallable, Category = "Doors")
@@ -94,9 +112,27 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Interaction")
     void OnPlayerExited(AGWTCharacter* Player);
 
+    // Clears a combat or boss room once its last enemy is gone
+    UFUNCTION(BlueprintCallable, Category = "State")
+    void OnEnemyKilled(AGWTEnemyCharacter* Enemy);
+
     UFUNCTION(BlueprintCallable, Category = "State")
     void MarkAsCleared();
 
+    // Occupant bookkeeping, normally driven by the trigger box
+    // Both return false when nothing changed, such as a second component of the same actor
+    bool AddOccupant(AActor* Actor);
+    bool RemoveOccupant(AActor* Actor);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Occupants")
+    int32 GetNumPlayers() const { return PlayerOccupants.Num(); }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Occupants")
+    int32 GetNumEnemies() const { return EnemyOccupants.Num(); }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Occupants")
+    int32 GetNumItems() const { return ItemOccupants.Num(); }
+
     UFUNCTION(BlueprintImplementableEvent, Category = "Visualization")
     void UpdateRoomAppearance();
 
@@ -116,6 +152,9 @@ protected:
     void SetupDoors();
     void InitializeRoomState();
 
+    // Pick up actors that were already inside the trigger box before the events were bound
+    void SeedOccupants(UBoxComponent* TriggerBox);
+
     // Event handlers
     UFUNCTION()
     void OnRoomBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
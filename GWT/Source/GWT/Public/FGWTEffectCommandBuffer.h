@@ -0,0 +1,98 @@
+// FGWTEffectCommandBuffer.h
+// Deferred effect commands recorded while a spell runs
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GWTTypes.h"
+
+// Forward declarations
+class AActor;
+
+// Kinds of deferred effect
+enum class EGWTEffectCommandType : uint8
+{
+    Status,
+    Damage,
+    Heal,
+    Knockback,
+    Teleport,
+    Summon
+};
+
+/**
+ * One effect recorded by a spell node
+ * Actors are held weakly, a target can be destroyed before the batch lands
+ */
+struct FGWTEffectCommand
+{
+    EGWTEffectCommandType Type = EGWTEffectCommandType::Damage;
+    EGWTElementType Element = EGWTElementType::None;
+    EGWTStatusEffectType StatusType = EGWTStatusEffectType::Burning;
+
+    TWeakObjectPtr<AActor> Target;
+    TWeakObjectPtr<AActor> Causer;
+
+    // Damage, healing, status strength or knockback strength
+    float Value = 0.0f;
+    float Duration = 0.0f;
+
+    // Destination of a teleport or summon
+    FVector Location = FVector::ZeroVector;
+
+    // Position of the target's first command in the batch, set by Flush
+    int32 TargetOrder = 0;
+};
+
+/**
+ * Effects a cast has produced but not applied yet
+ * Flush groups them per target, keeps each target's issue order and merges repeats that nothing
+ * in between depends on, so a target hit ten times by a loop takes one damage event and one proc roll
+ * Damage to a shielded target is never merged, the shield absorbs per hit
+ */
+class GWT_API FGWTEffectCommandBuffer
+{
+public:
+    // Recording, only ever touches the buffer
+    void AddDamage(AActor* Target, float Damage, EGWTElementType Element, AActor* Causer);
+    void AddHeal(AActor* Target, float Amount);
+    void AddStatus(AActor* Target, EGWTStatusEffectType StatusType, float Strength, float Duration, AActor* Causer);
+    void AddKnockback(AActor* Target, float Strength, AActor* Causer);
+    void AddTeleport(AActor* Target, const FVector& Location);
+    void AddSummon(const FVector& Location, AActor* Causer);
+
+    // Apply everything recorded so far in one pass, does nothing when empty
+    void Flush();
+
+    // Drop pending commands without applying them, keeps the storage
+    void Reset();
+
+    int32 Num() const { return Commands.Num(); }
+
+private:
+    FGWTEffectCommand& AddCommand(EGWTEffectCommandType Type, AActor* Target);
+
+    // Commands for one target that collapse into a single update
+    static bool CanMerge(const FGWTEffectCommand& Into, const FGWTEffectCommand& From);
+    static void Merge(FGWTEffectCommand& Into, const FGWTEffectCommand& From);
+
+    // Whether two commands for the same target give the same result in either order, so a merge may move one past the other
+    static bool Commutes(const FGWTEffectCommand& A, const FGWTEffectCommand& B);
+
+    // Whether the target has or gets in this batch a modifier that works per damage event, such as a shield
+    static bool HasPerHitDamage(const AActor* Target, TArrayView<const FGWTEffectCommand> TargetCommands);
+
+    // World-changing side of each command
+    static void ApplyCommand(const FGWTEffectCommand& Command);
+    static void ApplyKnockback(AActor* Target, AActor* Causer, float Strength);
+    static void ApplySummon(const FVector& Location);
+
+    TArray<FGWTEffectCommand> Commands;
+
+    // The batch being applied, a death handler may record into Commands meanwhile
+    TArray<FGWTEffectCommand> Applying;
+    TMap<const AActor*, int32> TargetOrders;
+
+    // One target's updates after merging, in issue order
+    TArray<FGWTEffectCommand> Updates;
+};
\ No newline at end of file
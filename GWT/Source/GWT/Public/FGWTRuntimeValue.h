@@ -0,0 +1,59 @@
+// FGWTRuntimeValue.h
+// Compact tagged value used for spell variables at runtime
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "GWTTypes.h"
+
+/**
+ * 16-byte runtime form of FGWTVariableValue
+ * Only the field selected by the type tag is stored, targets are weak handles
+ * FGWTVariableValue stays the Blueprint/editor type and is converted at the boundary
+ */
+struct GWT_API FGWTRuntimeValue
+{
+public:
+    FGWTRuntimeValue()
+        : FloatValue(0.0f)
+        , Type(EGWTVariableType::Float)
+    {
+    }
+
+    // Typed constructors
+    static FGWTRuntimeValue MakeFloat(float Value);
+    static FGWTRuntimeValue MakeInt(int32 Value);
+    static FGWTRuntimeValue MakeBool(bool Value);
+    static FGWTRuntimeValue MakeVector(const FVector& Value);
+    static FGWTRuntimeValue MakeTarget(AActor* Value);
+
+    // Conversion to and from the Blueprint-facing struct
+    static FGWTRuntimeValue FromVariableValue(const FGWTVariableValue& Value);
+    FGWTVariableValue ToVariableValue() const;
+
+    // Accessors, only the one matching GetType is meaningful
+    FORCEINLINE EGWTVariableType GetType() const { return Type; }
+    FORCEINLINE float GetFloat() const { return FloatValue; }
+    FORCEINLINE int32 GetInt() const { return IntValue; }
+    FORCEINLINE bool GetBool() const { return BoolValue; }
+    FORCEINLINE FVector GetVector() const { return FVector(VectorValue); }
+    AActor* GetTarget() const;
+
+    // Readable value for logging
+    FString ToString() const;
+
+private:
+    union
+    {
+        float FloatValue;
+        int32 IntValue;
+        bool BoolValue;
+        FVector3f VectorValue;
+        FWeakObjectPtr TargetValue;
+    };
+
+    EGWTVariableType Type;
+};
+
+static_assert(sizeof(FGWTRuntimeValue) == 16, "FGWTRuntimeValue should stay 16 bytes");
\ No newline at end of file
@@ -0,0 +1,110 @@
+// FGWTSpellCompiler.h
+// Lowers a spell node graph into a flat VM program
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FGWTSpellProgram.h"
+#include "FGWTSpellOptimizer.h"
+
+// Forward declarations
+class UGWTSpell;
+class UGWTSpellNode;
+
+// Outcome of compiling a spell graph
+enum class EGWTSpellCompileResult : uint8
+{
+    Success,
+    EmptyGraph,         // No root nodes to start from
+    CycleDetected,      // Execution could loop back on itself forever
+    UnsupportedNode,    // A node type the VM has no instruction for
+    TooManyNodes        // More nodes than an instruction can address
+};
+
+/**
+ * Compiler that turns a validated spell graph into an FGWTSpellProgram
+ * Only nodes that survive FGWTSpellOptimizer are lowered, the graph is split into regions (the spell itself and each loop body), and each
+ * region runs its nodes once in topological order, gated by join counters
+ * Roots that touch disjoint state get an entry region each, so they can run as parallel tasks
+ */
+class GWT_API FGWTSpellCompiler
+{
+public:
+    // Compile a spell, OutProgram is only set on success
+    static EGWTSpellCompileResult Compile(const UGWTSpell* Spell, TSharedPtr<const FGWTSpellProgram>& OutProgram);
+
+    // Readable name for a compile result, for logging
+    static const TCHAR* GetResultString(EGWTSpellCompileResult Result);
+
+private:
+    explicit FGWTSpellCompiler(FGWTSpellProgram& InProgram);
+
+    // Depth-first walk assigning node indices, returns false on a cycle
+    bool CollectNodes(UGWTSpellNode* Node);
+
+    // Nodes that a node can hand execution to, including loop bodies
+    static void GetExecutionSuccessors(UGWTSpellNode* Node, TArray<UGWTSpellNode*>& OutSuccessors);
+
+    // Live successors within the same region, loop bodies get a region of their own
+    void GetRegionSuccessors(UGWTSpellNode* Node, TArray<UGWTSpellNode*>& OutSuccessors) const;
+
+    // Flow nodes whose body runs in a loop region
+    bool IsLoopNode(UGWTSpellNode* Node) const;
+
+    // Region for a loop node's body, created on first use
+    int32 GetLoopBodyRegion(UGWTSpellNode* LoopNode);
+
+    // What a set of nodes reads and writes, used to find root groups that can run in parallel
+    struct FNodeAccess
+    {
+        uint8 Reads = 0;
+        uint8 Writes = 0;
+        TSet<FName> Variables;
+    };
+
+    // World state tracked by FNodeAccess
+    static constexpr uint8 AccessVitals = 1 << 0;     // Health, mana and status effects
+    static constexpr uint8 AccessLocation = 1 << 1;   // Actor positions
+
+    // Add what a single node reads and writes
+    void AddNodeAccess(UGWTSpellNode* Node, FNodeAccess& Access) const;
+
+    // Split the entry roots into groups that share no nodes, no variables and no read/write overlap
+    // Returns a single group when a split would not be safe to run in parallel
+    void PartitionEntryRoots(const TArray<UGWTSpellNode*>& EntryRoots, TArray<TArray<UGWTSpellNode*>>& OutGroups) const;
+
+    // Emit a region: reset its join counters, activate its roots, then every node in topological order
+    bool EmitRegion(int32 RegionIndex);
+
+    // Emit the work for a single firing of a node, ending with a jump back to its join check
+    bool EmitNodeBody(UGWTSpellNode* Node, const TMap<UGWTSpellNode*, int32>& Counters, int32 JoinCheck);
+
+    // Emission helpers
+    int32 Emit(EGWTSpellOpCode OpCode, int32 NodeIndex);
+    void EmitActivate(UGWTSpellNode* Target, const TMap<UGWTSpellNode*, int32>& Counters, int32 NodeIndex);
+    void EmitRegionCall(int32 RegionIndex, int32 NodeIndex);
+    int32 AddSlot(FName Name);
+
+    // Program being built
+    FGWTSpellProgram& Program;
+
+    // Reachable nodes, indexed by FGWTSpellInstruction::NodeIndex
+    TArray<UGWTSpellNode*> Nodes;
+    TMap<UGWTSpellNode*, int32> NodeIndices;
+
+    // Nodes on the current depth-first path, used for cycle detection
+    TSet<UGWTSpellNode*> ActivePath;
+
+    // Folded outcomes and live nodes
+    FGWTSpellOptimization Optimization;
+
+    // Root nodes of each region, region 0 is the spell entry
+    TArray<TArray<UGWTSpellNode*>> RegionRoots;
+    TMap<UGWTSpellNode*, int32> LoopBodyRegions;
+
+    // First instruction of each region
+    TArray<int32> RegionStarts;
+
+    // Call instructions waiting for their region's address (instruction, region index)
+    TArray<TPair<int32, int32>> CallFixups;
+};
\ No newline at end of file
@@ -0,0 +1,75 @@
+// FGWTSpellOptimizer.h
+// Graph-level optimization pass run before a spell is compiled
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FGWTSpellProgram.h"
+
+// Forward declarations
+class UGWTSpell;
+class UGWTSpellNode;
+
+/**
+ * Result of optimizing a spell graph
+ * The compiler only lowers live nodes and follows the folded outcomes recorded here
+ */
+struct FGWTSpellOptimization
+{
+    // Nodes that still run, in discovery order from the roots
+    TArray<UGWTSpellNode*> LiveOrder;
+    TSet<UGWTSpellNode*> LiveNodes;
+
+    // Conditions with a compile-time outcome
+    TMap<UGWTSpellNode*, bool> FoldedConditions;
+
+    // While loops whose condition can never be true, their body never runs
+    TSet<UGWTSpellNode*> SkippedLoops;
+
+    // Variable nodes kept for their connections but whose operation does nothing observable
+    TSet<UGWTSpellNode*> ElidedNodes;
+
+    // Memo slot for each pure condition, identical checks share a slot
+    TMap<UGWTSpellNode*, int32> MemoSlots;
+    int32 NumMemoSlots = 0;
+
+    // Summary of the changes
+    FGWTSpellOptimizationReport Report;
+
+    // Source node of each entry in Report.RemovedNodes
+    TArray<UGWTSpellNode*> RemovedNodes;
+
+    bool IsLive(const UGWTSpellNode* Node) const
+    {
+        return Node && LiveNodes.Contains(const_cast<UGWTSpellNode*>(Node));
+    }
+};
+
+/**
+ * Optimizer for spell node graphs
+ * Folds constant conditions and while loops, drops nodes with no observable effect,
+ * and marks pure checks for per-cast memoization so repeated and loop-invariant checks run once
+ */
+class GWT_API FGWTSpellOptimizer
+{
+public:
+    // Analyze a spell's graph, safe to call on graphs the compiler would reject
+    static void Optimize(const UGWTSpell* Spell, FGWTSpellOptimization& OutOptimization);
+
+    // Outcome of a condition known without running it, returns false if it depends on the cast
+    static bool TryFoldCondition(EGWTConditionType ConditionType, float ComparisonValue, bool& bOutResult);
+
+    // Conditions that only read world state and can be cached until the cast changes it
+    static bool IsPureCondition(EGWTConditionType ConditionType);
+
+    // Nodes execution moves to next, following folded outcomes
+    static void GetLiveSuccessors(UGWTSpellNode* Node, const FGWTSpellOptimization& Optimization, TArray<UGWTSpellNode*>& OutSuccessors);
+
+private:
+    // Whether a node or anything after it has an observable effect
+    static bool IsUseful(UGWTSpellNode* Node, const FGWTSpellOptimization& Optimization,
+        TMap<UGWTSpellNode*, bool>& Visited);
+
+    // A constant that a while condition would read as false
+    static bool IsFalseCondition(const FGWTRuntimeValue& Value);
+};
\ No newline at end of file
@@ -0,0 +1,173 @@
+// FGWTSpellProgram.h
+// Flat bytecode representation of a compiled spell graph
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GWTTypes.h"
+#include "FGWTRuntimeValue.h"
+
+/**
+ * Operations understood by the spell VM
+ * Each region (the spell and every loop body) is a block ending in Return,
+ * nodes inside it fire in topological order whenever their join counter allows
+ */
+enum class EGWTSpellOpCode : uint8
+{
+    Magic,          // Apply a magic payload, jump to Jump if there was no target in range
+    Effect,         // Apply an effect payload, jump to Jump if there was no caster
+    Trigger,        // Test a trigger, jump to Jump if it did not fire
+    Branch,         // Evaluate a condition (cached in memo slot Arg unless INDEX_NONE), jump to Jump if it was false
+    Variable,       // Read, write or modify the context variable in slot Arg
+    Wait,           // Suspend the cast for ValueA seconds (Delay flow and magic cast time)
+    LoopBegin,      // Push a loop counter that runs Arg iterations
+    RepeatNext,     // Advance the innermost loop, or pop it and jump to Jump when finished
+    ForEachNext,    // Same as RepeatNext but also publishes the iteration index to slot Arg
+    WhileNext,      // Same as RepeatNext but also stops when condition slot Arg is false
+    Jump,           // Unconditional jump to Jump
+    Call,           // Push the return address and jump to Jump (enters a loop body region)
+    Return,         // Pop the return address, or finish the program when the call stack is empty
+    RegionBegin,    // Zero the Aux join counters starting at Arg
+    Activate,       // Add one pending activation to join counter Arg
+    TakeActivation  // Consume from join counter Arg by join mode SubType, jump to Jump if there was none
+};
+
+/**
+ * A single VM instruction
+ * Node parameters are copied in so the VM never has to touch the node objects
+ */
+struct FGWTSpellInstruction
+{
+    // What to do
+    EGWTSpellOpCode OpCode = EGWTSpellOpCode::Return;
+
+    // Element, effect, trigger, condition or variable operation enum value
+    uint8 SubType = 0;
+
+    // Index into the program's node table, used for diagnostics
+    uint16 NodeIndex = 0;
+
+    // Absolute instruction index to branch to
+    int32 Jump = INDEX_NONE;
+
+    // Iteration count, variable slot or join counter depending on OpCode
+    int32 Arg = 0;
+
+    // Secondary operand (element type for Effect, constant index for Variable, counter count for RegionBegin)
+    int32 Aux = 0;
+
+    // Damage, effect value, trigger value, comparison value or wait time
+    float ValueA = 0.0f;
+
+    // Range or duration
+    float ValueB = 0.0f;
+};
+
+// A node the optimizer left out of the program, and why
+// Shared programs only keep the structural index, the ID and title are filled in per spell
+struct FGWTSpellRemovedNode
+{
+    int32 SourceIndex = INDEX_NONE;
+    FGuid NodeID;
+    FString NodeTitle;
+    FString Reason;
+};
+
+/**
+ * What FGWTSpellOptimizer changed while compiling a spell
+ * Kept on the program so the editor and logs can explain why a node never runs
+ */
+struct FGWTSpellOptimizationReport
+{
+    // Reachable nodes before and after optimization
+    int32 NodesBefore = 0;
+    int32 NodesAfter = 0;
+
+    // Nodes that were dropped entirely
+    TArray<FGWTSpellRemovedNode> RemovedNodes;
+
+    // Conditions and while loops with a compile-time outcome
+    int32 FoldedBranches = 0;
+    int32 FoldedLoops = 0;
+
+    // Variable nodes kept for their connections but whose operation was dropped
+    int32 ElidedVariableOps = 0;
+
+    // Pure checks cached per cast, and how many of them share a cache entry with another node
+    int32 MemoizedChecks = 0;
+    int32 SharedChecks = 0;
+
+    // One-line summary for logging
+    FString ToString() const
+    {
+        return FString::Printf(TEXT("%d -> %d nodes, %d removed, %d branches folded, %d loops folded, %d variable ops elided, %d checks memoized (%d shared)"),
+            NodesBefore, NodesAfter, RemovedNodes.Num(), FoldedBranches, FoldedLoops, ElidedVariableOps, MemoizedChecks, SharedChecks);
+    }
+};
+
+/**
+ * Compiled spell produced by FGWTSpellCompiler
+ * Immutable once built, execution state lives in the VM and the execution context
+ */
+struct FGWTSpellProgram
+{
+    // Instruction stream, execution starts at index 0
+    TArray<FGWTSpellInstruction> Instructions;
+
+    // Variable names, each name's index is its slot in the execution context
+    TArray<FName> SlotNames;
+
+    // Default values referenced by Variable instructions
+    TArray<FGWTRuntimeValue> Constants;
+
+    // Join counters needed across all regions
+    int32 NumJoinCounters = 0;
+
+    // Cached condition results needed by memoized Branch instructions
+    int32 NumMemoSlots = 0;
+
+    // Entry points of independent root groups, empty unless there are at least two
+    // Index 0 calls every group in order, or each group can run as its own task in parallel
+    TArray<int32> ParallelEntries;
+
+    // Structural index of each source node (see FGWTSpellSerializer::GetStructureNodes), indexed by
+    // FGWTSpellInstruction::NodeIndex, INDEX_NONE for nodes outside the spell's node list
+    // Programs are shared by every spell with the same structure, so node IDs and titles live on the spell
+    TArray<int32> NodeSourceIndices;
+
+    // What the optimizer removed or folded
+    FGWTSpellOptimizationReport OptimizationReport;
+
+    bool IsValid() const
+    {
+        return Instructions.Num() > 0;
+    }
+
+    // Approximate heap memory held by the program, used by the program cache
+    SIZE_T GetAllocatedSize() const
+    {
+        SIZE_T Size = sizeof(*this) + Instructions.GetAllocatedSize() + SlotNames.GetAllocatedSize() +
+            Constants.GetAllocatedSize() + ParallelEntries.GetAllocatedSize() + NodeSourceIndices.GetAllocatedSize() +
+            OptimizationReport.RemovedNodes.GetAllocatedSize();
+
+        for (const FGWTSpellRemovedNode& Removed : OptimizationReport.RemovedNodes)
+        {
+            Size += Removed.Reason.GetAllocatedSize();
+        }
+
+        return Size;
+    }
+};
+
+/**
+ * One spell's view of a shared program: its own node IDs and titles, and the optimization report naming its nodes
+ * Built by UGWTSpell when it picks up a program and handed to its casts for abort logs
+ */
+struct FGWTSpellDiagnostics
+{
+    // Indexed by FGWTSpellInstruction::NodeIndex
+    TArray<FGuid> NodeIDs;
+    TArray<FString> NodeTitles;
+
+    FGWTSpellOptimizationReport OptimizationReport;
+};
\ No newline at end of file
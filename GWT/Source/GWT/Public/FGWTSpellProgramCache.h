@@ -0,0 +1,82 @@
+// FGWTSpellProgramCache.h
+// Process-wide cache of compiled spell programs, keyed by graph structure
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/SecureHash.h"
+#include "FGWTSpellCompiler.h"
+
+// Forward declarations
+class UGWTSpell;
+
+// Counters for tuning the cache limits
+struct FGWTSpellProgramCacheStats
+{
+    int32 NumEntries = 0;
+    SIZE_T MemoryBytes = 0;
+    uint64 Hits = 0;
+    uint64 Misses = 0;
+    uint64 Evictions = 0;
+
+    FString ToString() const
+    {
+        return FString::Printf(TEXT("%d programs, %llu bytes, %llu hits, %llu misses, %llu evictions"),
+            NumEntries, (uint64)MemoryBytes, Hits, Misses, Evictions);
+    }
+};
+
+/**
+ * Content-addressed store of compiled spell programs
+ * Spells with the same structure share one immutable program no matter who owns them,
+ * so a wave of enemies casting the same spell compiles it once
+ */
+class GWT_API FGWTSpellProgramCache
+{
+public:
+    // Defaults sized for a few hundred distinct spells
+    static constexpr int32 DefaultMaxEntries = 512;
+    static constexpr SIZE_T DefaultMaxMemoryBytes = 16 * 1024 * 1024;
+
+    static FGWTSpellProgramCache& Get();
+
+    // Hash of everything that affects the compiled program, cosmetic fields are ignored
+    static FSHAHash ComputeStructuralHash(const UGWTSpell* Spell);
+
+    // Shared program for the spell's structure, compiling it on a miss
+    // Failed compiles are cached too, so a broken spell is only rejected once
+    EGWTSpellCompileResult FindOrCompile(const UGWTSpell* Spell, TSharedPtr<const FGWTSpellProgram>& OutProgram);
+
+    // Change the limits, evicting right away if the cache is over them
+    void SetLimits(int32 InMaxEntries, SIZE_T InMaxMemoryBytes);
+
+    FGWTSpellProgramCacheStats GetStats() const;
+
+    // Drop every entry, spells keep the programs they already hold
+    void Empty();
+
+private:
+    FGWTSpellProgramCache() = default;
+
+    struct FEntry
+    {
+        TSharedPtr<const FGWTSpellProgram> Program;
+        EGWTSpellCompileResult Result = EGWTSpellCompileResult::Success;
+        SIZE_T Size = 0;
+        uint64 LastUsed = 0;
+    };
+
+    // Remove least recently used entries until both limits hold, caller holds the lock
+    void EvictToLimits();
+
+    mutable FCriticalSection Lock;
+    TMap<FSHAHash, FEntry> Entries;
+
+    int32 MaxEntries = DefaultMaxEntries;
+    SIZE_T MaxMemoryBytes = DefaultMaxMemoryBytes;
+
+    // Use clock for LRU ordering
+    uint64 UseCounter = 0;
+
+    FGWTSpellProgramCacheStats Stats;
+};
\ No newline at end of file
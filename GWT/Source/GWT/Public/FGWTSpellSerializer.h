@@ -0,0 +1,83 @@
+// FGWTSpellSerializer.h
+// Compact binary save format for spells
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Forward declarations
+class UGWTSpell;
+class UGWTSpellNode;
+
+/**
+ * Reads and writes spells as versioned binary blobs
+ * Layout is a header, a node table with per-node parameters, an edge table and the root list,
+ * so a spell loads in a single pass and the same bytes work on disk and over the network
+ */
+class GWT_API FGWTSpellSerializer
+{
+public:
+    // "GWTS", little endian
+    static constexpr uint32 SpellMagic = 0x53545747;
+
+    // "GWTG", header of a grimoire blob holding several spells
+    static constexpr uint32 GrimoireMagic = 0x47545747;
+
+    // Bump when the layout changes, older versions must stay readable
+    static constexpr uint16 CurrentVersion = 1;
+
+    // Save a spell to a standalone blob
+    static void SaveSpell(const UGWTSpell* Spell, TArray<uint8>& OutData);
+
+    // Load a spell from a blob, legacy SaveToString text is accepted as well
+    static UGWTSpell* LoadSpell(const TArray<uint8>& Data, UObject* Outer = nullptr);
+
+    // True if the data starts with a binary spell header
+    static bool IsBinarySpell(const TArray<uint8>& Data);
+
+    // Archive versions, used to embed spells in other blobs such as grimoires
+    static void WriteSpell(FArchive& Ar, const UGWTSpell* Spell);
+    static UGWTSpell* ReadSpell(FArchive& Ar, UObject* Outer);
+
+    // Only what affects execution: no names, titles, node IDs or editor positions
+    // Structurally identical spells write identical bytes, used to key the program cache
+    static void WriteStructure(FArchive& Ar, const UGWTSpell* Spell);
+
+    // Nodes in the order the node table is written, a node's position here is its structural index
+    // Spells with the same structure have corresponding nodes at the same index
+    static void GetStructureNodes(const UGWTSpell* Spell, TArray<UGWTSpellNode*>& OutNodes);
+
+    // Node class named by a stored path, null unless it is an already loaded, concrete spell node class
+    // Blobs can arrive over the network, so they never get to choose which packages are loaded
+    static UClass* FindNodeClass(const FString& ClassPath);
+
+    // Smallest possible spell blob, a header with nothing after it, used to bound counts read from data
+    static constexpr int32 MinSpellSize = sizeof(uint32) + sizeof(uint16) * 2;
+
+private:
+    // Node class tags, anything else is stored by class path
+    enum class ENodeKind : uint8
+    {
+        Magic,
+        Effect,
+        Trigger,
+        Condition,
+        Variable,
+        Flow,
+        Custom = 255
+    };
+
+    // Role bits for an edge, plain outputs have none
+    static constexpr uint8 EdgeRoleTruePath = 1 << 0;
+    static constexpr uint8 EdgeRoleFalsePath = 1 << 1;
+    static constexpr uint8 EdgeRoleBody = 1 << 2;
+
+    // Shared body of WriteSpell and WriteStructure
+    static void WriteSpellInternal(FArchive& Ar, const UGWTSpell* Spell, bool bStructureOnly);
+
+    static ENodeKind GetNodeKind(const UGWTSpellNode* Node);
+    static UClass* GetNodeClass(ENodeKind Kind);
+
+    // Parameters specific to each node type, one function for both directions keeps the layout in one place
+    static void SerializeNodeParameters(FArchive& Ar, UGWTSpellNode* Node, uint16 Version);
+};
\ No newline at end of file
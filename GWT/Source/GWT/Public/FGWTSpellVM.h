@@ -0,0 +1,171 @@
+// FGWTSpellVM.h
+// Interpreter for compiled spell programs
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FGWTSpellProgram.h"
+#include "UGWTSpellExecutionContext.h"
+#include <atomic>
+
+// Forward declarations
+class UGWTSpellExecutionContext;
+
+// How a slice of spell execution ended
+enum class EGWTSpellRunResult : uint8
+{
+    Finished,   // Program returned from its entry region
+    Suspended,  // Waiting on a delay, cast time or the loop budget, resume at ResumeTime
+    Aborted,    // Stopped by a resource limit, see FGWTSpellTask::AbortReason
+    Failed      // Malformed program or invalid context
+};
+
+// Which resource limit stopped a cast
+enum class EGWTSpellAbortReason : uint8
+{
+    None,
+    OpBudget,       // Ran too many instructions
+    EffectLimit,    // Applied too many magic or effect payloads
+    CallDepth       // Loops nested too deeply
+};
+
+/**
+ * Resource limits applied to every cast
+ * Spells are written by players, so a single spell must never be able to stall the tick
+ */
+struct FGWTSpellLimits
+{
+    // Instructions a cast may execute over its whole lifetime
+    int32 MaxOps = 10000;
+
+    // Magic and effect payloads a cast may apply
+    int32 MaxEffects = 64;
+
+    // Nested loop body regions before the cast is considered runaway
+    int32 MaxCallDepth = 128;
+};
+
+// Metering shared by the sibling tasks of a parallel cast, so the cast as a whole stays within its limits
+struct FGWTSpellSharedMeter
+{
+    std::atomic<int32> OpsExecuted{ 0 };
+    std::atomic<int32> EffectsApplied{ 0 };
+};
+
+// Counter for an active Repeat/ForEach/While loop
+struct FGWTSpellLoopFrame
+{
+    int32 Index = 0;
+    int32 Count = 0;
+};
+
+// Cached result of a memoized condition, valid while Epoch matches the task's MemoEpoch
+struct FGWTSpellMemoEntry
+{
+    uint32 Epoch = 0;
+    bool bResult = false;
+};
+
+/**
+ * Resumable state of one cast running on the spell VM
+ * Everything needed to continue after a yield lives here,
+ * so suspended casts can sit in the scheduler between ticks
+ */
+struct FGWTSpellTask
+{
+    FGWTSpellTask() = default;
+
+    FGWTSpellTask(TSharedPtr<const FGWTSpellProgram> InProgram, UGWTSpellExecutionContext* InContext)
+        : Program(MoveTemp(InProgram))
+        , Context(InContext)
+    {
+    }
+
+    // Program being run, shared so recompiling the spell does not pull it out from under the cast
+    TSharedPtr<const FGWTSpellProgram> Program;
+
+    // Execution context, owned by the world's context pool
+    UGWTSpellExecutionContext* Context = nullptr;
+
+    // Casting spell's node names for abort logs, may be null
+    TSharedPtr<const FGWTSpellDiagnostics> Diagnostics;
+
+    // Next instruction to run, INDEX_NONE until the task has started
+    int32 PC = INDEX_NONE;
+
+    // Where the first slice starts, a root group's entry for the sibling tasks of a parallel cast
+    int32 EntryPC = 0;
+
+    // Non-zero for the sibling tasks of a parallel cast, the scheduler resumes siblings together
+    uint32 SiblingGroup = 0;
+    TSharedPtr<FGWTSpellSharedMeter, ESPMode::ThreadSafe> SharedMeter;
+
+    // While set, magic and effect payloads are recorded as instruction indices instead of applied
+    bool bDeferPayloads = false;
+    TArray<int32, TInlineAllocator<8>> DeferredPayloads;
+
+    // Actor state the kernels read while the task runs on a worker thread, taken on the game thread just before
+    FGWTSpellWorldSnapshot WorldSnapshot;
+
+    // Return addresses and loop counters, inline so typical spells never allocate
+    TArray<int32, TInlineAllocator<32>> CallStack;
+    TArray<FGWTSpellLoopFrame, TInlineAllocator<8>> LoopStack;
+
+    // Pending activations per node, see FGWTSpellProgram::NumJoinCounters
+    TArray<int32, TInlineAllocator<32>> JoinCounters;
+
+    // Pure condition results, invalidated by bumping MemoEpoch whenever the cast may have changed the world
+    TArray<FGWTSpellMemoEntry, TInlineAllocator<8>> MemoEntries;
+    uint32 MemoEpoch = 1;
+
+    // World time at which a suspended task wants to continue
+    double ResumeTime = 0.0;
+
+    // Set when the cast should be dropped at its next resume
+    bool bCancelled = false;
+
+    // Metering
+    FGWTSpellLimits Limits;
+    int32 OpsExecuted = 0;
+    int32 EffectsApplied = 0;
+
+    // Why and where the cast was aborted, for reporting
+    EGWTSpellAbortReason AbortReason = EGWTSpellAbortReason::None;
+    int32 AbortNodeIndex = INDEX_NONE;
+};
+
+/**
+ * Runs FGWTSpellProgram instructions for a task
+ * A single switch-dispatch loop, node work goes through the static kernels on each node class
+ * Waits and long loops yield back to the caller instead of blocking the frame
+ */
+class GWT_API FGWTSpellVM
+{
+public:
+    // Loop iterations a task may run in one slice before yielding to the next tick
+    static constexpr int32 LoopIterationsPerSlice = 32;
+
+    // Sibling programs smaller than this run one after another, the task graph costs more than they do
+    static constexpr int32 MinParallelInstructions = 64;
+
+    // Ops a sibling task runs between updates of its cast's shared meter
+    static constexpr int32 SharedMeterBatch = 64;
+
+    // Run a task until it finishes, fails or yields
+    // With bAllowSuspend false waits complete instantly and loops never yield
+    static EGWTSpellRunResult Run(FGWTSpellTask& Task, double CurrentTime, bool bAllowSuspend);
+
+    // Run the sibling tasks of one cast, on the task graph when the program is big enough
+    // Payloads are deferred during the parallel run and applied afterwards in task order on the calling thread
+    static void RunSiblings(TArrayView<FGWTSpellTask*> Tasks, double CurrentTime, bool bAllowSuspend, TArray<EGWTSpellRunResult, TInlineAllocator<8>>& OutResults);
+
+    // Apply a task's deferred payloads in the order they were recorded, game thread only
+    static void CommitDeferredPayloads(FGWTSpellTask& Task);
+
+    // Readable name for an abort reason, for logging
+    static const TCHAR* GetAbortReasonString(EGWTSpellAbortReason Reason);
+
+private:
+    // Record an abort and report the node that caused it
+    static EGWTSpellRunResult Abort(FGWTSpellTask& Task, EGWTSpellAbortReason Reason, int32 NodeIndex);
+};
\ No newline at end of file
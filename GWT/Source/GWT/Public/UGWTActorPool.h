@@ -0,0 +1,121 @@
+// UGWTActorPool.h
+// Per-world pool of reusable actors, enemies first
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/Interface.h"
+#include "UObject/ObjectKey.h"
+#include "UGWTActorPool.generated.h"
+
+UINTERFACE(MinimalAPI)
+class UGWTPooledActor : public UInterface
+{
+    GENERATED_BODY()
+};
+
+/**
+ * Implemented by actors that need more than hiding to sit in UGWTActorPool
+ * The pool hides the actor, turns off its collision and tick, and parks it out of the way,
+ * these hooks undo and redo whatever the actor registered at BeginPlay
+ */
+class GWT_API IGWTPooledActor
+{
+    GENERATED_BODY()
+
+public:
+    // Handed out again, already moved into place, visible and colliding
+    virtual void OnAcquiredFromPool() {}
+
+    // Going back, leave every world registry and stop all timers
+    virtual void OnReleasedToPool() {}
+};
+
+// Counters for one pooled class
+struct FGWTActorPoolStats
+{
+    // Acquires, and those served without a spawn
+    int32 NumAcquires = 0;
+    int32 NumHits = 0;
+
+    // Instances handed out and not yet released, and the most there have ever been at once
+    int32 NumInUse = 0;
+    int32 HighWaterMark = 0;
+
+    // Instances ready to hand out
+    int32 NumFree = 0;
+
+    float GetHitRate() const { return NumAcquires > 0 ? (float)NumHits / NumAcquires : 1.0f; }
+};
+
+/**
+ * World subsystem that recycles actors instead of spawning and destroying them
+ * Classes are pre-warmed between waves, Acquire hands out a parked instance moved into place
+ * and Release parks it again, so a warm pool serves a whole wave without a spawn
+ */
+UCLASS()
+class GWT_API UGWTActorPool : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Height pooled actors are parked at, below every room and above the kill plane
+    static constexpr float ParkingHeight = -100000.0f;
+
+    // Subsystem lifetime
+    virtual void Deinitialize() override;
+
+    // Spawn parked instances until Class has Count, in use or free, spawning at most MaxSpawns
+    // Returns the number spawned
+    int32 Prewarm(UClass* Class, int32 Count, int32 MaxSpawns = MAX_int32);
+
+    // Get an instance of Class at Transform, spawning one only when none is free
+    AActor* Acquire(UClass* Class, const FTransform& Transform);
+
+    template<class T>
+    T* Acquire(TSubclassOf<T> Class, const FTransform& Transform)
+    {
+        return Cast<T>(Acquire(Class.Get(), Transform));
+    }
+
+    // Park an instance until it is acquired again
+    // Returns false for actors the pool did not hand out, those are left alone
+    bool Release(AActor* Actor);
+
+    // Whether the pool handed out this actor and it has not come back yet
+    bool IsInUse(const AActor* Actor) const { return InUseActors.Contains(FObjectKey(Actor)); }
+
+    // Find the pool for an actor's world, may be null outside gameplay worlds
+    static UGWTActorPool* Get(const AActor* WorldContext);
+
+    // Stats
+    FGWTActorPoolStats GetStats(UClass* Class) const;
+    FGWTActorPoolStats GetTotalStats() const;
+
+protected:
+    // Free instances and counters of one class
+    struct FClassPool
+    {
+        TArray<TWeakObjectPtr<AActor>> FreeActors;
+        FGWTActorPoolStats Stats;
+    };
+
+    // Spawn a new instance of Class, live at Transform
+    AActor* SpawnInstance(UClass* Class, const FTransform& Transform);
+
+    // Hide, silence and move an instance out of the way
+    static void Park(AActor* Actor);
+
+    // Drop free instances that were destroyed behind the pool's back
+    static void PruneFreeActors(FClassPool& Pool);
+
+    TMap<UClass*, FClassPool> Pools;
+
+    // Instances handed out and not yet released
+    TSet<FObjectKey> InUseActors;
+
+    // Every instance the pool has spawned, keeps parked actors referenced
+    UPROPERTY()
+    TArray<AActor*> AllActors;
+};
\ No newline at end of file
@@ -0,0 +1,98 @@
+// UGWTCharacterSpatialHash.h
+// Per-world spatial hash of living characters for proximity queries
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UGWTCharacterSpatialHash.generated.h"
+
+// Forward declarations
+class AGWTCharacter;
+class AGWTRoom;
+
+/**
+ * Narrows a proximity query
+ * All conditions must hold, an empty filter accepts every character
+ */
+struct FGWTSpatialQueryFilter
+{
+    // Only characters of this class, such as AGWTPlayerCharacter
+    UClass* Class = nullptr;
+
+    // Only characters inside this room's trigger, see AGWTRoom occupants
+    const AGWTRoom* Room = nullptr;
+
+    // Characters to leave out, such as the caster and the primary target
+    TArray<const AActor*, TInlineAllocator<2>> Ignored;
+};
+
+/**
+ * World subsystem keeping living characters in a uniform grid hashed by cell
+ * Characters register at BeginPlay, move cells as they tick and leave when they die,
+ * so radius and nearest queries only visit nearby cells and compare squared distances
+ */
+UCLASS()
+class GWT_API UGWTCharacterSpatialHash : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Cell edge length, about the range of a chain or melee query
+    static constexpr float CellSize = 500.0f;
+
+    // Subsystem lifetime
+    virtual void Deinitialize() override;
+
+    // Membership, called by AGWTCharacter
+    void AddCharacter(AGWTCharacter* Character);
+    void RemoveCharacter(AGWTCharacter* Character);
+
+    // Move a character to its current cell, cheap when it has not left the cell
+    void UpdateCharacter(AGWTCharacter* Character);
+
+    // Every character within Radius of Location, in no particular order
+    void QueryRadius(const FVector& Location, float Radius, TArray<AGWTCharacter*>& OutCharacters,
+        const FGWTSpatialQueryFilter& Filter = FGWTSpatialQueryFilter()) const;
+
+    // Up to Count characters within MaxRadius, nearest first
+    void QueryNearest(const FVector& Location, int32 Count, float MaxRadius, TArray<AGWTCharacter*>& OutCharacters,
+        const FGWTSpatialQueryFilter& Filter = FGWTSpatialQueryFilter()) const;
+
+    // Nearest character within MaxRadius, or null
+    AGWTCharacter* FindNearest(const FVector& Location, float MaxRadius,
+        const FGWTSpatialQueryFilter& Filter = FGWTSpatialQueryFilter()) const;
+
+    // Find the hash for an actor's world, may be null outside gameplay worlds
+    static UGWTCharacterSpatialHash* Get(const AActor* WorldContext);
+
+    // Stats
+    int32 GetNumCharacters() const { return CharacterCells.Num(); }
+    int32 GetNumCells() const { return Cells.Num(); }
+
+protected:
+    // Characters paired with their squared distance to the query point
+    using FCandidateArray = TArray<TPair<float, AGWTCharacter*>, TInlineAllocator<16>>;
+
+    static FIntVector GetCell(const FVector& Location);
+
+    void RemoveFromCell(const FIntVector& Cell, AGWTCharacter* Character);
+
+    // Filter checks that do not depend on distance
+    static bool PassesFilter(const AGWTCharacter* Character, const FGWTSpatialQueryFilter& Filter);
+
+    // Characters of one cell within a squared radius that pass the filter
+    static void GatherCell(const TArray<AGWTCharacter*>& CellCharacters, const FVector& Location, float RadiusSquared,
+        const FGWTSpatialQueryFilter& Filter, FCandidateArray& OutCandidates);
+
+    // Shared by QueryNearest and FindNearest, leaves the nearest Count candidates sorted
+    void GatherNearest(const FVector& Location, int32 Count, float MaxRadius, const FGWTSpatialQueryFilter& Filter,
+        FCandidateArray& OutCandidates) const;
+
+    // Characters per occupied cell, empty cells are removed
+    // Characters leave at EndPlay and OnDeath, so the raw pointers never outlive their actors
+    TMap<FIntVector, TArray<AGWTCharacter*>> Cells;
+
+    // Cell each registered character is filed under
+    TMap<const AGWTCharacter*, FIntVector> CharacterCells;
+};
\ No newline at end of file
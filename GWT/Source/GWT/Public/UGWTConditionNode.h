@@ -20,13 +20,20 @@ class GWT_API UGWTConditionNode : public UGWTSpellNode
 public:
     UGWTConditionNode();
 
-    // Condition properties
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Condition")
+    // Condition properties, read-only to Blueprint so every change goes through a setter below
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Condition")
     EGWTConditionType ConditionType;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Condition")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Condition")
     float ComparisonValue = 0.0f;
 
+    // Setters, each marks the node modified so the spell's compiled program is rebuilt
+    UFUNCTION(BlueprintCallable, Category = "Condition")
+    void SetConditionType(EGWTConditionType NewConditionType) { ConditionType = NewConditionType; MarkModified(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Condition")
+    void SetComparisonValue(float NewComparisonValue) { ComparisonValue = NewComparisonValue; MarkModified(); }
+
     // These pointers track the connected nodes for true/false paths
     // These are redundant with OutputNodes but help clarify which node is which
     UPROPERTY()
@@ -55,12 +62,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Condition")
     virtual bool EvaluateCondition(UGWTSpellExecutionContext* Context);
 
+    // Evaluates a condition without needing a node instance
+    // Shared by EvaluateCondition and the spell VM
+    static bool EvaluateConditionType(UGWTSpellExecutionContext* Context, EGWTConditionType InConditionType, float InComparisonValue);
+
 protected:
     // Helper methods for different condition types
-    bool EvaluateHealthCheck(UGWTSpellExecutionContext* Context);
-    bool EvaluateManaCheck(UGWTSpellExecutionContext* Context);
-    bool EvaluateDistanceCheck(UGWTSpellExecutionContext* Context);
-    bool EvaluateElementalCheck(UGWTSpellExecutionContext* Context);
-    bool EvaluateStatusEffectCheck(UGWTSpellExecutionContext* Context);
-    bool EvaluateRandomChance(UGWTSpellExecutionContext* Context);
+    static bool EvaluateHealthCheck(UGWTSpellExecutionContext* Context, float InComparisonValue);
+    static bool EvaluateManaCheck(UGWTSpellExecutionContext* Context, float InComparisonValue);
+    static bool EvaluateDistanceCheck(UGWTSpellExecutionContext* Context, float InComparisonValue);
+    static bool EvaluateElementalCheck(UGWTSpellExecutionContext* Context, float InComparisonValue);
+    static bool EvaluateStatusEffectCheck(UGWTSpellExecutionContext* Context, float InComparisonValue);
+    static bool EvaluateRandomChance(UGWTSpellExecutionContext* Context, float InComparisonValue);
 };
\ No newline at end of file
@@ -19,31 +19,52 @@ class GWT_API UGWTEffectNode : public UGWTSpellNode
 public:
     UGWTEffectNode();
 
-    // Effect properties
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Effect")
+    // Effect properties, read-only to Blueprint so every change goes through a setter below
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Effect")
     EGWTEffectType EffectType = EGWTEffectType::Damage;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Effect")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Effect")
     float EffectValue = 10.0f;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Effect")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Effect")
     float EffectDuration = 0.0f;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Effect")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Effect")
     EGWTElementType ElementType = EGWTElementType::None;
 
+    // Setters, each marks the node modified so the spell's compiled program is rebuilt
+    UFUNCTION(BlueprintCallable, Category = "Effect")
+    void SetEffectType(EGWTEffectType NewEffectType) { EffectType = NewEffectType; MarkModified(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Effect")
+    void SetEffectValue(float NewEffectValue) { EffectValue = NewEffectValue; MarkModified(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Effect")
+    void SetEffectDuration(float NewEffectDuration) { EffectDuration = NewEffectDuration; MarkModified(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Effect")
+    void SetElementType(EGWTElementType NewElementType) { ElementType = NewElementType; MarkModified(); }
+
     // Implementation
     virtual void Execute(UGWTSpellExecutionContext* Context) override;
     virtual EGWTSpellComponentType GetNodeType() const override;
     virtual FString GetNodeTypeAsString() const override;
 
+    // Applies an effect payload without needing a node instance
+    // Shared by Execute and the spell VM, returns false if there was no caster
+    static bool ApplyEffectPayload(UGWTSpellExecutionContext* Context, EGWTEffectType InEffectType,
+        EGWTElementType InElementType, float Value, float Duration);
+
+    // Whether ApplyEffectPayload would run, only reads the context
+    static bool CanApplyEffectPayload(const UGWTSpellExecutionContext* Context);
+
 protected:
-    // Effect implementation methods
-    void ApplyDamageEffect(AActor* Target, UGWTSpellExecutionContext* Context);
-    void ApplyHealEffect(AActor* Target, UGWTSpellExecutionContext* Context);
-    void ApplyStatusEffect(AActor* Target, UGWTSpellExecutionContext* Context);
-    void ApplyTeleportEffect(AActor* Target, UGWTSpellExecutionContext* Context);
-    void ApplyKnockbackEffect(AActor* Target, UGWTSpellExecutionContext* Context);
-    void ApplyShieldEffect(AActor* Target, UGWTSpellExecutionContext* Context);
-    void ApplySummonEffect(UGWTSpellExecutionContext* Context);
+    // Effect implementation methods, these record commands on the context rather than touching the world
+    static void ApplyDamageEffect(AActor* Target, UGWTSpellExecutionContext* Context, EGWTElementType InElementType, float Value);
+    static void ApplyHealEffect(AActor* Target, UGWTSpellExecutionContext* Context, float Value);
+    static void ApplyStatusEffect(AActor* Target, UGWTSpellExecutionContext* Context, EGWTElementType InElementType, float Value, float Duration);
+    static void ApplyTeleportEffect(AActor* Target, UGWTSpellExecutionContext* Context);
+    static void ApplyKnockbackEffect(AActor* Target, UGWTSpellExecutionContext* Context, float Value);
+    static void ApplyShieldEffect(AActor* Target, UGWTSpellExecutionContext* Context, float Value, float Duration);
+    static void ApplySummonEffect(UGWTSpellExecutionContext* Context);
 };
\ No newline at end of file
@@ -0,0 +1,142 @@
+// UGWTEnemyAIManager.h
+// Runs every enemy's AI decisions in one data-oriented pass
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GWTTypes.h"
+#include "UGWTEnemyAIManager.generated.h"
+
+// Forward declarations
+class AGWTEnemyCharacter;
+class AGWTLevelGenerator;
+class AGWTRoom;
+struct FGWTFlowField;
+
+// What an enemy does this frame, decided in parallel and carried out serially
+enum class EGWTEnemyAIAction : uint8
+{
+    None,
+    LoseTarget,
+    Attack,
+    Chase
+};
+
+// How often an enemy at one level of detail thinks, senses and animates, in seconds
+struct FGWTAILODSettings
+{
+    // 0 decides every frame
+    float UpdateInterval = 0.0f;
+    float SensingInterval = 0.5f;
+    float AnimationInterval = 0.0f;
+};
+
+/**
+ * World subsystem that ticks enemy AI in place of each enemy's own Tick
+ * Enemy state is copied into parallel arrays, decisions run in a ParallelFor over that
+ * read-only snapshot, and movement, rotation and targeting are applied in one serial pass
+ * Finding targets is left to UGWTSensingService, chase steering comes from UGWTFlowFieldService
+ * Enemies rooms away from every player think less often, and sleep in rooms nobody has visited
+ */
+UCLASS()
+class GWT_API UGWTEnemyAIManager : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Below this many enemies the decisions are cheaper on the game thread alone
+    static constexpr int32 MinParallelEnemies = 32;
+
+    // Door steps from the nearest player's room covered by each level of detail
+    static constexpr int32 FullDetailRooms = 1;
+    static constexpr int32 ReducedDetailRooms = 2;
+
+    // Seconds between room distance rebuilds while the players stay put, catches cube swaps
+    static constexpr float RoomDistanceRefreshInterval = 1.0f;
+
+    // Subsystem lifetime
+    virtual void Deinitialize() override;
+
+    // Tickable interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Membership, called by AGWTEnemyCharacter
+    // A registered enemy has its actor tick turned off until it leaves
+    void RegisterEnemy(AGWTEnemyCharacter* Enemy);
+    void UnregisterEnemy(AGWTEnemyCharacter* Enemy);
+
+    // Find the manager for an actor's world, may be null outside gameplay worlds
+    static UGWTEnemyAIManager* Get(const AActor* WorldContext);
+
+    // Throttling for a level of detail
+    static const FGWTAILODSettings& GetLODSettings(EGWTAILOD LOD);
+
+    // Stats
+    int32 GetNumEnemies() const { return Enemies.Num(); }
+    int32 GetNumEnemiesAtLOD(EGWTAILOD LOD) const { return LODCounts[(int32)LOD]; }
+
+protected:
+    // Bits of StateFlags
+    static constexpr uint8 FlagHasTarget = 1 << 0;
+    static constexpr uint8 FlagAttacking = 1 << 1;
+
+    // Rebuild the room distances when a player changed room, or the refresh interval ran out
+    void UpdateRoomDistances(float DeltaTime);
+
+    // Assign levels of detail and work out which enemies are due a decision this tick
+    void UpdateLODs(float DeltaTime);
+    EGWTAILOD ComputeLOD(const AGWTEnemyCharacter* Enemy) const;
+
+    // Copy what the decisions read out of the actors, game thread only
+    void GatherSnapshot();
+
+    // Decide for one enemy, reads the snapshot and writes only its own slot
+    void Decide(int32 Index);
+
+    // Carry out the decisions on the actors, game thread only
+    void ApplyDecisions();
+
+    // Drop a slot from every array, swapping the last enemy into it
+    void RemoveAtSwap(int32 Index);
+
+    // Index i of every array below belongs to Enemies[i]
+    // Slots are nulled rather than removed while a tick is walking them
+    UPROPERTY()
+    TArray<AGWTEnemyCharacter*> Enemies;
+
+    TMap<const AGWTEnemyCharacter*, int32> EnemyIndices;
+
+    // Snapshot, written by GatherSnapshot
+    TArray<FVector> Positions;
+    TArray<FVector> TargetPositions;
+    TArray<float> AttackRanges;
+    TArray<float> AggroRanges;
+
+    // Flow field toward each target, null when the target has none yet
+    TArray<const FGWTFlowField*> TargetFields;
+    TArray<uint8> StateFlags;
+
+    // Decisions, written by Decide
+    TArray<EGWTEnemyAIAction> Actions;
+    TArray<FVector> MoveDirections;
+    TArray<FRotator> Facings;
+
+    // Time since each enemy last ran, and whether it runs this tick
+    TArray<float> PendingDeltaTimes;
+    TArray<bool> DueThisTick;
+
+    // Room graph the levels of detail are measured on, found on first use
+    TWeakObjectPtr<AGWTLevelGenerator> LevelGenerator;
+
+    // Rooms the players were in at the last rebuild, and door steps from them
+    TArray<const AGWTRoom*> PlayerRooms;
+    TMap<const AGWTRoom*, int32> RoomDistances;
+    float TimeSinceRoomDistances = 0.0f;
+
+    int32 LODCounts[4] = {};
+
+    // Set while Tick walks the arrays
+    bool bTicking = false;
+};
\ No newline at end of file
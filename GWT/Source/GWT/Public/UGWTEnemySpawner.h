@@ -16,6 +16,8 @@ class AGWTEnemyCharacter;
  * Enemy spawner component for Grand Wizard Tournament
  * Handles spawning enemies in rooms based on wave number and difficulty
  * Manages enemy populations and distributions
+ * Enemies come from UGWTActorPool, which is topped up for the next wave while this one plays
+ * Waves are queued on UGWTSpawnQueue, which calls back SpawnEnemyInRoom a few at a time
  */
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class GWT_API UGWTEnemySpawner : public UActorComponent
@@ -41,7 +43,15 @@ public:
 
     // Global enemy cap
     UPROPERTY(EditDefaultsOnly, Category = "Limits")
-    int32 MaxConcurrentEnemies = 20;
+    int32 MaxConcurrentEnemies = 50;
+
+    // Pooled enemies kept per wave, in use or free, split across the wave's enemy types
+    UPROPERTY(EditDefaultsOnly, Category = "Pooling")
+    int32 PrewarmEnemyCount = 20;
+
+    // Enemies pre-warmed per spawner tick, keeps the top-up from becoming a hitch of its own
+    UPROPERTY(EditDefaultsOnly, Category = "Pooling")
+    int32 MaxPrewarmSpawnsPerTick = 4;
 
     // Active enemies
     UPROPERTY(BlueprintReadOnly, Category = "Tracking")
@@ -55,12 +65,20 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Spawning")
     void SpawnEnemiesForWave(int32 WaveNumber, AGWTRoom* Room);
 
+    // One enemy of the wave in the room, checked against the cap, called by UGWTSpawnQueue
+    UFUNCTION(BlueprintCallable, Category = "Spawning")
+    AGWTEnemyCharacter* SpawnEnemyInRoom(AGWTRoom* Room, int32 WaveNumber);
+
     UFUNCTION(BlueprintCallable, Category = "Spawning")
     AGWTEnemyCharacter* SpawnEnemy(TSubclassOf<AGWTEnemyCharacter> EnemyClass, FVector Location, int32 WaveNumber);
 
     UFUNCTION(BlueprintCallable, Category = "Spawning")
     TSubclassOf<AGWTEnemyCharacter> SelectEnemyTypeForWave(int32 WaveNumber);
 
+    // Fill the pool for a wave's enemy types, spawning at most MaxSpawns, returns the number spawned
+    UFUNCTION(BlueprintCallable, Category = "Pooling")
+    int32 PrewarmForWave(int32 WaveNumber, int32 MaxSpawns);
+
     UFUNCTION(BlueprintCallable, Category = "Spawning")
     int32 CalculateEnemyCountForRoom(AGWTRoom* Room, int32 WaveNumber);
 
@@ -98,4 +116,10 @@ protected:
 
     // Enemy classes when none are specified in editor
     void SetupDefaultEnemyClasses();
+
+    // Wave the game mode is on, 1 without one
+    int32 GetCurrentWave() const;
+
+    // Draws made on this spawner's random stream
+    mutable uint32 SpawnRollCount = 0;
 };
\ No newline at end of file
@@ -0,0 +1,153 @@
+// UGWTFlowFieldService.h
+// Shared chase directions toward each player, across rooms and through doors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "UGWTFlowFieldService.generated.h"
+
+// Forward declarations
+class AGWTLevelGenerator;
+class AGWTRoom;
+
+// One reached cell of a flow field
+struct FGWTFlowCell
+{
+    // Path cost to the goal, 10 per straight step and 14 per diagonal one
+    int32 Cost = 0;
+
+    // Offset to the next cell toward the goal, Z steps through a floor or ceiling door
+    int8 StepX = 0;
+    int8 StepY = 0;
+    int8 StepZ = 0;
+};
+
+/**
+ * Directions toward one player for every cell within reach
+ * Cells are global, X and Y count cells across the labyrinth floor and Z is the room layer
+ * Reading a direction is a single map lookup, safe from worker threads while the service is not ticking
+ */
+struct GWT_API FGWTFlowField
+{
+    // Steer from Location toward the next cell, false in the goal cell or off the field
+    bool GetDirection(const FVector& Location, FVector& OutDirection) const;
+
+    FIntVector WorldToCell(const FVector& Location) const;
+    FVector CellToWorld(const FIntVector& Cell) const;
+
+    // Cell geometry, copied from the level generator when the field is built
+    float RoomSize = 1000.0f;
+    float CellSize = 100.0f;
+
+    FIntVector GoalCell = FIntVector::ZeroValue;
+    TMap<FIntVector, FGWTFlowCell> Cells;
+};
+
+/**
+ * World subsystem building one flow field per live player
+ * A field is a Dijkstra walk out from the player's cell over the open cells of nearby rooms,
+ * crossing into the next room only through the door cells of an open door
+ * Fields are rebuilt when their player changes cell, a few thousand cells per tick,
+ * and the previous field stays readable until the new one is finished
+ */
+UCLASS()
+class GWT_API UGWTFlowFieldService : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Cells along each side of a room
+    static constexpr int32 CellsPerRoom = 10;
+
+    // Cells either side of a wall's middle that make up a doorway
+    static constexpr int32 DoorHalfWidthCells = 1;
+
+    // Door steps from the player's room a field reaches
+    static constexpr int32 MaxFieldRooms = 3;
+
+    // Cells settled per tick across all fields being built
+    static constexpr int32 MaxCellsPerTick = 2048;
+
+    // Seconds before a field is rebuilt while its player stands still, picks up doors and cube swaps
+    static constexpr float FieldRefreshInterval = 2.0f;
+
+    // Subsystem lifetime
+    virtual void Deinitialize() override;
+
+    // Tickable interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Finished field toward a player, null until the first build completes
+    const FGWTFlowField* FindField(const AActor* Target) const;
+
+    // Find the service for an actor's world, may be null outside gameplay worlds
+    static UGWTFlowFieldService* Get(const AActor* WorldContext);
+
+    // Stats
+    int32 GetNumFields() const { return Fields.Num(); }
+    int32 GetNumCellsSettledLastTick() const { return NumCellsSettledLastTick; }
+
+protected:
+    // Open heap entry of a build in progress
+    struct FOpenCell
+    {
+        int32 Cost;
+        FIntVector Cell;
+
+        bool operator<(const FOpenCell& Other) const { return Cost < Other.Cost; }
+    };
+
+    // A player's finished field, and the one replacing it
+    struct FPlayerField
+    {
+        TWeakObjectPtr<AActor> Player;
+        FGWTFlowField Current;
+        FGWTFlowField Building;
+        TArray<FOpenCell> OpenCells;
+        TMap<const AGWTRoom*, int32> ReachableRooms;
+        bool bHasCurrent = false;
+        bool bBuilding = false;
+        float TimeSinceBuild = 0.0f;
+    };
+
+    // Which cells of a room are free of obstacles, probed once per room placement
+    struct FRoomCells
+    {
+        FVector ProbedLocation = FVector::ZeroVector;
+        TBitArray<> Blocked;
+    };
+
+    // Add fields for new players, drop those of players who left
+    void SyncPlayers();
+
+    // Start a new build from the player's current cell
+    void BeginBuild(FPlayerField& Field, const FIntVector& GoalCell, const AGWTRoom* GoalRoom);
+
+    // Settle up to Budget cells, returns the number settled
+    int32 ContinueBuild(FPlayerField& Field, int32 Budget);
+
+    // Relax one step from a settled cell into a neighbour
+    void TryStep(FPlayerField& Field, const FIntVector& From, int32 FromCost, const FIntVector& Step, int32 StepCost);
+
+    // Grid position of the room a global cell lies in
+    static FIntVector CellToRoomPosition(const FIntVector& Cell);
+
+    // Room a global cell lies in, null when it is off the grid or outside the field's reach
+    const AGWTRoom* GetCellRoom(const FPlayerField& Field, const FIntVector& Cell) const;
+
+    // Whether a step between two cells crosses an open door or stays inside one room
+    bool CanCross(const FIntVector& From, const AGWTRoom* FromRoom, const FIntVector& To, const AGWTRoom* ToRoom) const;
+
+    bool IsCellBlocked(const AGWTRoom* Room, const FIntVector& Cell);
+
+    TMap<FObjectKey, FPlayerField> Fields;
+    TMap<const AGWTRoom*, FRoomCells> RoomCells;
+
+    // Room grid the fields are laid over, found on first use
+    TWeakObjectPtr<AGWTLevelGenerator> LevelGenerator;
+
+    int32 NumCellsSettledLastTick = 0;
+};
\ No newline at end of file
@@ -7,6 +7,9 @@
 #include "UGWTSpellNode.h"
 #include "UGWTFlowNode.generated.h"
 
+// Forward declarations
+struct FGWTRuntimeValue;
+
 /**
  * Flow node that controls the execution flow of spells
  * Implements programming concepts like loops, delays, and branching
@@ -20,19 +23,32 @@ class GWT_API UGWTFlowNode : public UGWTSpellNode
 public:
     UGWTFlowNode();
 
-    // Flow properties
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Flow")
+    // Flow properties, read-only to Blueprint so every change goes through a setter below
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Flow")
     EGWTFlowType FlowType = EGWTFlowType::Repeat;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Flow")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Flow")
     int32 IterationCount = 3;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Flow")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Flow")
     float TimeLimit = 5.0f;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Flow")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Flow")
     FName ConditionVariableName;
 
+    // Setters, each marks the node modified so the spell's compiled program is rebuilt
+    UFUNCTION(BlueprintCallable, Category = "Flow")
+    void SetFlowType(EGWTFlowType NewFlowType) { FlowType = NewFlowType; MarkModified(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Flow")
+    void SetIterationCount(int32 NewIterationCount) { IterationCount = NewIterationCount; MarkModified(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Flow")
+    void SetTimeLimit(float NewTimeLimit) { TimeLimit = NewTimeLimit; MarkModified(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Flow")
+    void SetConditionVariableName(FName NewConditionVariableName) { ConditionVariableName = NewConditionVariableName; MarkModified(); }
+
     // Special node connections - body is the node(s) that get executed in the loop
     UPROPERTY()
     UGWTSpellNode* BodyNode;
@@ -50,13 +66,22 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Connections")
     void SetBodyNode(UGWTSpellNode* Node);
 
+    // Safety limit for While loops so a student's spell can never spin forever
+    static constexpr int32 MaxWhileIterations = 100;
+
+    // Variable ForEach loops publish their iteration index to
+    static const FName IndexVariableName;
+
+    // Check a while condition by variable name, used by ExecuteWhile
+    static bool EvaluateWhileCondition(UGWTSpellExecutionContext* Context, FName InConditionVariableName);
+
+    // Check an already resolved condition value (null if unset), shared with the spell VM
+    static bool EvaluateWhileValue(const FGWTRuntimeValue* ConditionValue, FName InConditionVariableName);
+
 protected:
     // Flow implementation methods
     void ExecuteRepeat(UGWTSpellExecutionContext* Context);
     void ExecuteWhile(UGWTSpellExecutionContext* Context);
     void ExecuteForEach(UGWTSpellExecutionContext* Context);
     void ExecuteDelay(UGWTSpellExecutionContext* Context);
-
-    // Helper to check a while condition
-    bool EvaluateWhileCondition(UGWTSpellExecutionContext* Context);
 };
\ No newline at end of file
@@ -55,6 +55,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Save")
     static UGWTGrimoire* LoadFromString(const FString& GrimoireData);
 
+    // Binary form holding every spell in full, see FGWTSpellSerializer
+    UFUNCTION(BlueprintCallable, Category = "Save")
+    void SaveToBinary(TArray<uint8>& OutData) const;
+
+    // Also accepts data written by SaveToString
+    UFUNCTION(BlueprintCallable, Category = "Save")
+    static UGWTGrimoire* LoadFromBinary(const TArray<uint8>& GrimoireData);
+
     // Utility methods
     UFUNCTION(BlueprintCallable, Category = "Spells")
     int32 GetSpellCount() const;
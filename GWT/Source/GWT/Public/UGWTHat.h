@@ -52,4 +52,8 @@ public:
 
     UFUNCTION(BlueprintCallable, Category = "Hat")
     bool ShouldDiscountMana() const;
+
+protected:
+    // Mana discount rolls made, each roll is its own draw on this item's stream
+    mutable uint32 DiscountRollCount = 0;
 };
\ No newline at end of file
@@ -0,0 +1,87 @@
+// UGWTLineOfSightService.h
+// Batched asynchronous line-of-sight traces for AI perception
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+#include "UObject/ObjectKey.h"
+#include "UGWTLineOfSightService.generated.h"
+
+/**
+ * Cached visibility between one viewer and one target
+ * The answer may be a few frames old, a refresh is traced while it is being used
+ */
+struct FGWTSightEntry
+{
+    TWeakObjectPtr<AActor> Viewer;
+    TWeakObjectPtr<AActor> Target;
+
+    bool bHasResult = false;
+    bool bVisible = false;
+
+    // Frame the current answer was traced for
+    uint64 ResultFrame = 0;
+
+    // Last frame anyone asked about this pair, idle pairs are evicted
+    uint64 RequestFrame = 0;
+
+    // Refresh in flight, invalid when none
+    FTraceHandle PendingTrace;
+};
+
+/**
+ * World subsystem that answers line-of-sight questions from last frame's traces
+ * Requests are deduplicated per (viewer, target) pair and issued together as async traces
+ * once per tick, so perception never blocks the game thread on physics
+ */
+UCLASS()
+class GWT_API UGWTLineOfSightService : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Subsystem lifetime
+    virtual void Deinitialize() override;
+
+    // Tickable interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Latest answer for the pair, and keep it fresh while it is asked for
+    // Returns false until a trace for the pair has landed recently, as for a new pair or one asked about rarely
+    bool GetLineOfSight(AActor* Viewer, AActor* Target, bool& bOutVisible);
+
+    // Frames an answer is reused before it is traced again, at least 1
+    void SetCacheFrames(int32 NewCacheFrames) { CacheFrames = FMath::Max(1, NewCacheFrames); }
+    int32 GetCacheFrames() const { return CacheFrames; }
+
+    // Find the service for an actor's world, may be null outside gameplay worlds
+    static UGWTLineOfSightService* Get(const AActor* WorldContext);
+
+    // Stats
+    int32 GetNumPairs() const { return Entries.Num(); }
+    int32 GetNumTracesLastTick() const { return NumTracesLastTick; }
+
+protected:
+    using FSightKey = TPair<FObjectKey, FObjectKey>;
+
+    // Pick up a finished trace, returns true when the entry has no trace in flight anymore
+    bool CollectResult(FGWTSightEntry& Entry, uint64 Frame) const;
+
+    // Queue the async trace refreshing an entry
+    void IssueTrace(FGWTSightEntry& Entry) const;
+
+    // Frames an answer is reused before it is traced again
+    int32 CacheFrames = 3;
+
+    // Frames a pair survives without being asked about
+    static constexpr int32 EvictFrames = 30;
+
+    // Every pair asked about recently
+    TMap<FSightKey, FGWTSightEntry> Entries;
+
+    int32 NumTracesLastTick = 0;
+};
\ No newline at end of file
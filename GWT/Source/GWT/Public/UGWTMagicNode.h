@@ -19,31 +19,57 @@ class GWT_API UGWTMagicNode : public UGWTSpellNode
 public:
     UGWTMagicNode();
 
-    // Magic properties
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Magic")
+    // Magic properties, read-only to Blueprint so every change goes through a setter below
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Magic")
     float BaseDamage = 10.0f;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Magic")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Magic")
     float Range = 10.0f;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Magic")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Magic")
     float CastTime = 1.0f;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Magic")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Magic")
     float ManaCost = 5.0f;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Magic")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Magic")
     EGWTElementType ElementType = EGWTElementType::Fire;
 
+    // Setters, each marks the node modified so the spell's cached cost and program are rebuilt
+    UFUNCTION(BlueprintCallable, Category = "Magic")
+    void SetBaseDamage(float NewBaseDamage) { BaseDamage = NewBaseDamage; MarkModified(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Magic")
+    void SetRange(float NewRange) { Range = NewRange; MarkModified(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Magic")
+    void SetCastTime(float NewCastTime) { CastTime = NewCastTime; MarkModified(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Magic")
+    void SetManaCost(float NewManaCost) { ManaCost = NewManaCost; MarkModified(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Magic")
+    void SetElementType(EGWTElementType NewElementType) { ElementType = NewElementType; MarkModified(); }
+
     // Implementation
     virtual void Execute(UGWTSpellExecutionContext* Context) override;
     virtual EGWTSpellComponentType GetNodeType() const override;
     virtual FString GetNodeTypeAsString() const override;
 
+    // Applies the magic payload without needing a node instance
+    // Shared by Execute and the spell VM, returns false if there was no target in range
+    static bool ApplyMagic(UGWTSpellExecutionContext* Context, EGWTElementType InElementType, float Damage, float InRange);
+
+    // Whether ApplyMagic would find a target in range, only reads the world
+    static bool CanApplyMagic(UGWTSpellExecutionContext* Context, float InRange);
+
 protected:
-    // Helper methods for specific elemental effects
-    void ApplyFireEffect(AActor* Target, float Damage, UGWTSpellExecutionContext* Context);
-    void ApplyIceEffect(AActor* Target, float Damage, UGWTSpellExecutionContext* Context);
-    void ApplyLightningEffect(AActor* Target, float Damage, UGWTSpellExecutionContext* Context);
-    void ApplyElementalEffect(AActor* Target, float Damage, UGWTSpellExecutionContext* Context);
+    // Target for the payload, false with a warning if there is none in range
+    static bool FindMagicTarget(UGWTSpellExecutionContext* Context, float InRange, AActor*& OutTarget);
+
+    // Helper methods for specific elemental effects, recorded on the context and applied when it flushes
+    static void ApplyFireEffect(AActor* Target, float Damage, UGWTSpellExecutionContext* Context);
+    static void ApplyIceEffect(AActor* Target, float Damage, UGWTSpellExecutionContext* Context);
+    static void ApplyLightningEffect(AActor* Target, float Damage, UGWTSpellExecutionContext* Context);
+    static void ApplyElementalEffect(AActor* Target, EGWTElementType InElementType, float Damage, UGWTSpellExecutionContext* Context);
 };
\ No newline at end of file
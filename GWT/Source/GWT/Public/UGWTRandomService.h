@@ -0,0 +1,94 @@
+// UGWTRandomService.h
+// Per-match deterministic random numbers for spells and combat
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UGWTRandomService.generated.h"
+
+// What a random draw is for, keeps unrelated systems on separate streams
+enum class EGWTRandomDomain : uint32
+{
+    SpellCondition,
+    StatusProc,
+    CriticalHit,
+    ManaDiscount,
+    Spawner
+};
+
+/**
+ * Position of a single draw: domain, owner stream, event index and sub-index
+ * A draw is a pure function of the match seed and its key, so order of evaluation never matters
+ */
+struct FGWTRandomKey
+{
+    FGWTRandomKey() = default;
+
+    FGWTRandomKey(EGWTRandomDomain InDomain, uint32 InStream, uint32 InIndex, uint32 InSubIndex = 0)
+        : Domain(InDomain)
+        , Stream(InStream)
+        , Index(InIndex)
+        , SubIndex(InSubIndex)
+    {
+    }
+
+    EGWTRandomDomain Domain = EGWTRandomDomain::SpellCondition;
+
+    // Usually the owning object, see UGWTRandomService::GetStreamID
+    uint32 Stream = 0;
+
+    // Event counter on the owner, such as a cast or damage event
+    uint32 Index = 0;
+
+    // Position within the event, such as a node or an axis
+    uint32 SubIndex = 0;
+};
+
+/**
+ * World subsystem holding the match seed and producing counter-based random numbers (Philox4x32-10)
+ * Replaying a match with the same seed reproduces every roll, which makes fights re-simulable and balance bugs reproducible
+ * Pass -GWTSeed=<n> on the command line to fix the seed, otherwise one is picked and logged at startup
+ */
+UCLASS()
+class GWT_API UGWTRandomService : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Subsystem lifetime
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    // Seed for every draw in this world
+    void SetMatchSeed(uint64 InSeed);
+    uint64 GetMatchSeed() const { return MatchSeed; }
+
+    // Next cast number for a caster, casts by different casters never share a stream
+    uint32 NextCastID(const AActor* Caster);
+
+    // Uniform draws for a key
+    float FRand(const FGWTRandomKey& Key) const;
+    float FRandRange(const FGWTRandomKey& Key, float Min, float Max) const;
+    int32 RandRange(const FGWTRandomKey& Key, int32 Min, int32 Max) const;
+
+    // Find the service for an object's world, may be null outside gameplay worlds
+    static UGWTRandomService* Get(const UObject* WorldContext);
+
+    // Draw through the object's world, falling back to seed 0 without one so results stay deterministic
+    static float FRand(const UObject* WorldContext, const FGWTRandomKey& Key);
+
+    // Stable id for an object, derived from its path so a replayed match gets the same ids
+    static uint32 GetStreamID(const UObject* Object);
+
+    // Raw generator: four 32 bit words of output for a counter and key
+    static void Philox4x32(const uint32 Counter[4], uint64 Key, uint32 OutWords[4]);
+
+    // Uniform float in [0, 1) for a seed and key
+    static float ToUnitFloat(uint64 Seed, const FGWTRandomKey& Key);
+
+protected:
+    uint64 MatchSeed = 0;
+
+    // Casts started per caster
+    TMap<TWeakObjectPtr<const AActor>, uint32> CastCounters;
+};
\ No newline at end of file
@@ -0,0 +1,114 @@
+// UGWTSensingService.h
+// Sight and hearing for every enemy, evaluated in one budgeted pass
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UGWTSensingService.generated.h"
+
+// Forward declarations
+class AGWTEnemyCharacter;
+class UGWTLineOfSightService;
+
+/**
+ * What one enemy currently perceives
+ * Players stay in VisiblePlayers while seen, OnSeePlayer fires only when one is added
+ */
+struct FGWTSenseState
+{
+    AGWTEnemyCharacter* Enemy = nullptr;
+
+    // Seconds until this enemy looks again
+    float TimeUntilSense = 0.0f;
+
+    TArray<TWeakObjectPtr<APawn>, TInlineAllocator<2>> VisiblePlayers;
+};
+
+// A sound made by a player, heard by enemies at the next tick
+struct FGWTNoiseEvent
+{
+    TWeakObjectPtr<APawn> Instigator;
+    FVector Location = FVector::ZeroVector;
+    float Loudness = 1.0f;
+};
+
+// A noise an enemy hears only with a clear line, waiting for the line-of-sight trace to land
+struct FGWTPendingHearing
+{
+    TWeakObjectPtr<AGWTEnemyCharacter> Enemy;
+    FGWTNoiseEvent Noise;
+
+    // Seconds left before the noise is given up as unheard
+    float TimeRemaining = 0.0f;
+};
+
+/**
+ * World subsystem replacing per-enemy perception components
+ * Sight cones are checked against nearby players from the spatial hash, confirmed with the
+ * batched line-of-sight traces, at each enemy's level-of-detail interval and within a per-tick budget
+ */
+UCLASS()
+class GWT_API UGWTSensingService : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Most enemies whose sight is evaluated in one tick, the rest wait their turn
+    static constexpr int32 MaxSightChecksPerTick = 32;
+
+    // Seconds a noise waits for its line-of-sight trace, a trace normally lands the next tick
+    static constexpr float HearingTraceTimeout = 0.25f;
+
+    // Subsystem lifetime
+    virtual void Deinitialize() override;
+
+    // Tickable interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Membership, called by AGWTEnemyCharacter
+    void RegisterEnemy(AGWTEnemyCharacter* Enemy);
+    void UnregisterEnemy(AGWTEnemyCharacter* Enemy);
+
+    // A player made a sound, Loudness scales every enemy's hearing range
+    void ReportNoise(APawn* Instigator, const FVector& Location, float Loudness = 1.0f);
+
+    // Find the service for an actor's world, may be null outside gameplay worlds
+    static UGWTSensingService* Get(const AActor* WorldContext);
+
+    // Stats
+    int32 GetNumEnemies() const { return SenseStates.Num(); }
+    int32 GetNumSightChecksLastTick() const { return NumSightChecksLastTick; }
+
+protected:
+    // Look for players in the enemy's sight cone, and raise OnSeePlayer for new ones
+    void UpdateSight(FGWTSenseState& State);
+
+    // Deliver the queued noises to every enemy in earshot
+    void DeliverNoises();
+
+    // Deliver the noises whose line-of-sight trace has landed, drop the ones that waited too long
+    void ResolvePendingHearings(float DeltaTime);
+
+    // Hear a noise from beyond the hearing threshold if the line is clear, returns false while the trace is pending
+    static bool TryHearWithLineOfSight(UGWTLineOfSightService* LineOfSight, AGWTEnemyCharacter* Enemy, const FGWTNoiseEvent& Noise);
+
+    // Whether a player stands inside an enemy's cone and range
+    static bool IsInSightCone(const AGWTEnemyCharacter* Enemy, const FVector& PlayerLocation);
+
+    // One entry per registered enemy, order is irrelevant
+    TArray<FGWTSenseState> SenseStates;
+    TMap<const AGWTEnemyCharacter*, int32> StateIndices;
+
+    // Where the next budgeted pass starts, so every enemy gets its turn
+    int32 NextSightIndex = 0;
+
+    TArray<FGWTNoiseEvent> PendingNoises;
+    TArray<FGWTPendingHearing> PendingHearings;
+
+    // Largest LOSHearingThreshold of any registered enemy, bounds the listener query
+    float MaxHearingRange = 0.0f;
+
+    int32 NumSightChecksLastTick = 0;
+};
\ No newline at end of file
@@ -0,0 +1,94 @@
+// UGWTSpawnQueue.h
+// Enemy spawns spread over frames, nearest rooms first
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UGWTSpawnQueue.generated.h"
+
+// Forward declarations
+class AGWTRoom;
+class AGWTLevelGenerator;
+class UGWTEnemySpawner;
+
+// One enemy waiting to be spawned
+struct FGWTSpawnRequest
+{
+    TWeakObjectPtr<AGWTRoom> Room;
+    int32 WaveNumber = 1;
+
+    // World time it was queued, for the latency stats
+    double EnqueueTime = 0.0;
+
+    // Queue order, keeps requests of equally near rooms first come first served
+    uint64 Sequence = 0;
+
+    // Door steps from the nearest player, refreshed every tick
+    int32 RoomDistance = MAX_int32;
+};
+
+/**
+ * World subsystem that spawns queued enemies under a per-frame time budget
+ * Rooms queue their enemies at wave start instead of spawning them on the spot,
+ * each tick the queue is ordered by room distance from the players and drained
+ * until the budget is spent, always at least one spawn so the queue keeps moving
+ */
+UCLASS()
+class GWT_API UGWTSpawnQueue : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Subsystem lifetime
+    virtual void Deinitialize() override;
+
+    // Tickable interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // The spawner that carries out the requests, set by UGWTEnemySpawner at BeginPlay
+    void SetSpawner(UGWTEnemySpawner* NewSpawner) { Spawner = NewSpawner; }
+
+    // Queue Count enemies for a room
+    void EnqueueRoom(AGWTRoom* Room, int32 WaveNumber, int32 Count);
+
+    // Milliseconds of spawning allowed per frame
+    void SetFrameBudgetMs(float NewFrameBudgetMs) { FrameBudgetMs = FMath::Max(0.0f, NewFrameBudgetMs); }
+    float GetFrameBudgetMs() const { return FrameBudgetMs; }
+
+    // Find the queue for an actor's world, may be null outside gameplay worlds
+    static UGWTSpawnQueue* Get(const AActor* WorldContext);
+
+    // Stats
+    int32 GetQueueDepth() const { return Requests.Num(); }
+    int32 GetPeakQueueDepth() const { return PeakQueueDepth; }
+    int32 GetNumSpawnedLastTick() const { return NumSpawnedLastTick; }
+    float GetMillisecondsLastTick() const { return MillisecondsLastTick; }
+
+    // Seconds from queueing to spawning
+    float GetAverageLatency() const { return NumSpawned > 0 ? (float)(TotalLatency / NumSpawned) : 0.0f; }
+    float GetMaxLatency() const { return MaxLatency; }
+
+protected:
+    // Refresh every request's room distance and sort nearest first
+    void PrioritizeRequests();
+
+    // Requests in the order they will be spawned, after PrioritizeRequests
+    TArray<FGWTSpawnRequest> Requests;
+    uint64 NextSequence = 0;
+
+    TWeakObjectPtr<UGWTEnemySpawner> Spawner;
+
+    // Room graph the priorities are measured on, found on first use
+    TWeakObjectPtr<AGWTLevelGenerator> LevelGenerator;
+
+    float FrameBudgetMs = 2.0f;
+
+    int32 PeakQueueDepth = 0;
+    int32 NumSpawnedLastTick = 0;
+    float MillisecondsLastTick = 0.0f;
+    int32 NumSpawned = 0;
+    double TotalLatency = 0.0;
+    float MaxLatency = 0.0f;
+};
\ No newline at end of file
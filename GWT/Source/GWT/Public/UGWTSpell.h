@@ -11,6 +11,29 @@
 // Forward declarations
 class UGWTSpellNode;
 class UGWTSpellExecutionContext;
+struct FGWTSpellProgram;
+struct FGWTSpellOptimizationReport;
+struct FGWTSpellDiagnostics;
+
+// Graph-derived spell stats, valid while Version matches the spell's graph version
+struct FGWTSpellStatsCache
+{
+    int32 Version = INDEX_NONE;
+    bool bValid = false;
+    float ManaCost = 0.0f;
+    float BaseDamage = 0.0f;
+    int32 NodeCount = 0;
+    int32 ConnectionCount = 0;
+    TMap<EGWTSpellComponentType, TArray<UGWTSpellNode*>> NodesByType;
+};
+
+// Final mana cost for one caster, valid while both versions match
+struct FGWTCasterManaCost
+{
+    int32 GraphVersion = INDEX_NONE;
+    int32 CasterVersion = INDEX_NONE;
+    float ManaCost = 0.0f;
+};
 
 /**
  * Represents a complete spell composed of multiple connected nodes
@@ -68,12 +91,32 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Spell")
     float CalculateBaseDamage();
 
+    // Mana cost after the caster's wand, robe and skill multipliers
+    UFUNCTION(BlueprintCallable, Category = "Spell")
+    float GetFinalManaCost(AActor* Caster);
+
+    // Bumped by every node, connection and property edit
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Spell")
+    int32 GetGraphVersion() const { return GraphVersion; }
+
+    // Invalidate cached stats and the compiled program after an edit
+    UFUNCTION(BlueprintCallable, Category = "Spell")
+    void MarkGraphChanged();
+
     UFUNCTION(BlueprintCallable, Category = "Save")
     void SaveToString(FString& OutString);
 
     UFUNCTION(BlueprintCallable, Category = "Save")
     static UGWTSpell* LoadFromString(const FString& SpellData);
 
+    // Lossless binary form, see FGWTSpellSerializer
+    UFUNCTION(BlueprintCallable, Category = "Save")
+    void SaveToBinary(TArray<uint8>& OutData) const;
+
+    // Also accepts data written by SaveToString
+    UFUNCTION(BlueprintCallable, Category = "Save")
+    static UGWTSpell* LoadFromBinary(const TArray<uint8>& SpellData);
+
     // Complexity analysis for educational tracking
     UFUNCTION(BlueprintCallable, Category = "Analysis")
     int32 CountNodes() const;
@@ -90,4 +133,53 @@ public:
 
     UFUNCTION(BlueprintCallable, Category = "Editor")
     void UpdateNodeConnections();
+
+    // Compilation
+    UFUNCTION(BlueprintCallable, Category = "Spell")
+    bool CompileSpell();
+
+    UFUNCTION(BlueprintCallable, Category = "Spell")
+    void InvalidateCompiledProgram();
+
+    // Program the next cast will run, null until the spell compiles or if it runs through its nodes
+    TSharedPtr<const FGWTSpellProgram> GetCompiledProgram() const { return CompiledProgram; }
+
+    // What the optimizer removed from the compiled program, null until the spell compiles
+    const FGWTSpellOptimizationReport* GetOptimizationReport() const;
+
+    // This spell's node IDs and titles for the compiled program, null until the spell compiles
+    TSharedPtr<const FGWTSpellDiagnostics> GetDiagnostics() const { return Diagnostics; }
+
+protected:
+    // Recompute cached stats if the graph changed since they were built
+    const FGWTSpellStatsCache& GetCachedStats() const;
+
+    // Full validation walk, only run when the graph version changes
+    bool ValidateGraph() const;
+
+    // Rebuild NodeLookup if AllNodes was changed directly
+    void SyncNodeLookup();
+
+    // Current graph version and the stats built for it
+    int32 GraphVersion = 0;
+    mutable FGWTSpellStatsCache StatsCache;
+
+    // Final cost per caster
+    TMap<TWeakObjectPtr<AActor>, FGWTCasterManaCost> CasterManaCosts;
+
+    // Membership lookup for AllNodes
+    TSet<UGWTSpellNode*> NodeLookup;
+
+    // Name the compiled program's nodes after this spell's own, the program may have been compiled from another spell
+    void BuildDiagnostics();
+
+    // Program built from the node graph, shared so casts never copy it
+    TSharedPtr<const FGWTSpellProgram> CompiledProgram;
+    TSharedPtr<const FGWTSpellDiagnostics> Diagnostics;
+
+    // Graph changed since the last compile attempt
+    bool bProgramDirty = true;
+
+    // Graph contains nodes the VM cannot run, cast through the nodes instead
+    bool bUseNodeExecution = false;
 };
\ No newline at end of file
@@ -0,0 +1,91 @@
+// UGWTSpellBenchmarkCommandlet.h
+// Headless benchmark for spell compilation and casting
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UGWTSpellBenchmarkCommandlet.generated.h"
+
+// Forward declarations
+class UGWTSpell;
+class UGWTSpellNode;
+class AGWTCharacter;
+struct FGWTSpellProgram;
+
+/**
+ * Casts synthetic spell graphs against dummy characters in a minimal world and reports the cost as CSV
+ * Run with: GWT -run=GWTSpellBenchmark -nullrhi [-llm] [-Casts=N] [-Targets=N] [-Output=File.csv] [-Baseline=File.csv]
+ * NsPerCast times the full UGWTSpell::Cast path, VmNsPerCast the same program run directly on the VM
+ * TrackedBytesPerCast needs -llm, it is left empty without
+ * Spell engine changes should be compared against a baseline from the previous build
+ */
+UCLASS()
+class GWT_API UGWTSpellBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UGWTSpellBenchmarkCommandlet();
+
+    // Commandlet entry point, returns non-zero on failure
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    // One row of the report
+    struct FBenchmarkResult
+    {
+        FString Name;
+        int32 NumNodes = 0;
+        int32 NumCasts = 0;
+        double CompileMicroseconds = 0.0;
+        double NanosecondsPerCast = 0.0;
+        double VmNanosecondsPerCast = 0.0;
+
+        // Bytes the measured casts left allocated under the benchmark's LLM tag, unset without -llm
+        TOptional<double> TrackedBytesPerCast;
+        double ObjectsPerCast = 0.0;
+    };
+
+    // The numbers an earlier report is compared on
+    struct FBaselineResult
+    {
+        double NanosecondsPerCast = 0.0;
+        TOptional<double> TrackedBytesPerCast;
+    };
+
+    // Graph shapes, each returns a spell that is ready to compile
+    static UGWTSpell* BuildChain(UObject* Outer, int32 Length);
+    static UGWTSpell* BuildDiamond(UObject* Outer, int32 Width);
+    static UGWTSpell* BuildNestedRepeat(UObject* Outer, int32 Depth, int32 IterationsPerLevel);
+    static UGWTSpell* BuildWhileCountdown(UObject* Outer, int32 Iterations);
+    static UGWTSpell* BuildVariableHeavy(UObject* Outer, int32 NumOperations);
+    static UGWTSpell* BuildIndependentRoots(UObject* Outer, int32 NumRoots, int32 ChainLength);
+
+    // Create a node inside a spell
+    template<typename NodeType>
+    static NodeType* NewNode(UGWTSpell* Spell);
+
+    // Connect two nodes in both directions, the way the editor does
+    static void Connect(UGWTSpellNode* From, UGWTSpellNode* To);
+
+    // Compile a spell, then cast it repeatedly against the targets in turn
+    static bool RunCase(const FString& Name, UGWTSpell* Spell, AGWTCharacter* Caster,
+        const TArray<AGWTCharacter*>& Targets, int32 NumCasts, FBenchmarkResult& OutResult);
+
+    // One complete cast through UGWTSpell::Cast, validation, mana and the scheduler included
+    static void CastOnce(UGWTSpell* Spell, AGWTCharacter* Caster, AGWTCharacter* Target);
+
+    // One run of a compiled program on the VM through the world's context pool, waits finish instantly
+    // Programs with independent root groups run them as sibling tasks, like the scheduler does
+    static void RunProgramOnce(const TSharedPtr<const FGWTSpellProgram>& Program, AGWTCharacter* Caster, AGWTCharacter* Target);
+
+    // Bytes currently held under the benchmark's LLM tag, unset when LLM is not running
+    static TOptional<int64> GetTrackedBytes();
+
+    // Results from an earlier report, keyed by case name
+    static void LoadBaseline(const FString& Path, TMap<FString, FBaselineResult>& OutBaseline);
+
+    // Write the report, with the change against the baseline when there is one
+    static bool WriteReport(const FString& Path, const TArray<FBenchmarkResult>& Results, const TMap<FString, FBaselineResult>& Baseline);
+};
\ No newline at end of file
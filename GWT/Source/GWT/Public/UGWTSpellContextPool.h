@@ -0,0 +1,60 @@
+// UGWTSpellContextPool.h
+// Per-world pool of reusable spell execution contexts
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UGWTSpellContextPool.generated.h"
+
+// Forward declarations
+class UGWTSpellExecutionContext;
+
+/**
+ * World subsystem that recycles spell execution contexts
+ * Casts acquire a reset context and release it when they finish,
+ * so steady-state casting creates no new UObjects
+ */
+UCLASS()
+class GWT_API UGWTSpellContextPool : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Variable slots reserved up front in every pooled context
+    static constexpr int32 ReservedVariables = 16;
+
+    // Subsystem lifetime
+    virtual void Deinitialize() override;
+
+    // Get a clean context for a cast
+    UGWTSpellExecutionContext* Acquire(AActor* Caster, AActor* Target);
+
+    // Get a context for another task of the same cast, sharing its participants, hit and random stream
+    UGWTSpellExecutionContext* AcquireSibling(const UGWTSpellExecutionContext* Source);
+
+    // Return a context once its cast has finished
+    void Release(UGWTSpellExecutionContext* Context);
+
+    // Find the pool for an actor's world, may be null outside gameplay worlds
+    static UGWTSpellContextPool* Get(const AActor* WorldContext);
+
+    // Stats
+    UFUNCTION(BlueprintCallable, Category = "Spell")
+    int32 GetNumContexts() const { return AllContexts.Num(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Spell")
+    int32 GetNumFreeContexts() const { return FreeContexts.Num(); }
+
+protected:
+    // Pop a free context or create one
+    UGWTSpellExecutionContext* TakeFreeContext();
+
+    // Every context the pool has created, keeps in-flight contexts referenced
+    UPROPERTY()
+    TArray<UGWTSpellExecutionContext*> AllContexts;
+
+    // Contexts ready to hand out
+    UPROPERTY()
+    TArray<UGWTSpellExecutionContext*> FreeContexts;
+};
\ No newline at end of file
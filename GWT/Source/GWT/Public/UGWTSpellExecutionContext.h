@@ -6,11 +6,49 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "GWTTypes.h"
+#include "FGWTRuntimeValue.h"
+#include "FGWTEffectCommandBuffer.h"
 #include "UGWTSpellExecutionContext.generated.h"
 
 // Forward declarations
 class UGWTSpellNode;
 class AGWTCharacter;
+struct FGWTRandomKey;
+
+// Participants of a cast the kernels can read
+enum class EGWTSpellActor : uint8
+{
+    Caster,
+    Target,
+    HitActor
+};
+
+// What the spell kernels read from a participant, copied so worker threads never touch the actor
+struct FGWTSpellActorState
+{
+    // Identity only, compared but never dereferenced off the game thread
+    const AActor* Actor = nullptr;
+    bool bIsCharacter = false;
+    FVector Location = FVector::ZeroVector;
+    float CurrentHealth = 0.0f;
+    float MaxHealth = 0.0f;
+    float CurrentMana = 0.0f;
+    float MaxMana = 0.0f;
+    TArray<EGWTStatusEffectType, TInlineAllocator<8>> StatusEffects;
+
+    bool IsValid() const { return Actor != nullptr; }
+};
+
+// The world as a cast's kernels see it, taken on the game thread before sibling tasks run on workers
+struct FGWTSpellWorldSnapshot
+{
+    FGWTSpellActorState Caster;
+    FGWTSpellActorState Target;
+    FGWTSpellActorState HitActor;
+
+    // Match seed of the world's random service
+    uint64 RandomSeed = 0;
+};
 
 /**
  * Context object for spell execution
@@ -40,10 +78,48 @@ public:
     UPROPERTY()
     TMap<FName, FGWTVariableValue> Variables;
 
+    // Variable slots for compiled spells, names are resolved to indices at compile time
+    // Targets are held weakly so the slots need no GC references
+    TArray<FGWTRuntimeValue> VariableSlots;
+
+    // Which slots have been written this cast
+    TBitArray<> VariableSlotsSet;
+
+    // Names of the bound slots, owned by the running program
+    const TArray<FName>* VariableSlotNames = nullptr;
+
     // Flow control
     UPROPERTY()
     TArray<UGWTSpellNode*> ExecutionStack;
 
+    // Random draws for this cast, see UGWTRandomService
+    // RandomStream and CastID are set when the context is acquired, RandomNode by whoever evaluates a random node
+    uint32 RandomStream = 0;
+    uint32 CastID = 0;
+    uint32 RandomNode = 0;
+
+    // Effects this cast has produced, applied when a slice ends, the cast ends,
+    // or something is about to read the state they change
+    FGWTEffectCommandBuffer EffectCommands;
+
+    // Set while the cast runs on a worker thread, kernels then read the world from it and must not write
+    const FGWTSpellWorldSnapshot* WorldSnapshot = nullptr;
+
+    // Participant state for the kernels, from the snapshot while one is set, otherwise read on the game thread
+    FGWTSpellActorState ReadActor(EGWTSpellActor Which) const;
+
+    // The participant itself, game thread only
+    AActor* GetActor(EGWTSpellActor Which) const;
+
+    // Copy everything ReadActor and RandomFRand can be asked for, game thread only
+    void CaptureWorld(FGWTSpellWorldSnapshot& OutSnapshot) const;
+
+    // Uniform draw in [0, 1) for this cast, see UGWTRandomService
+    float RandomFRand(const FGWTRandomKey& Key) const;
+
+    // Land queued effects before a kernel reads the state they change
+    void FlushBeforeRead();
+
     // Methods
     UFUNCTION(BlueprintCallable, Category = "Variables")
     void SetVariable(FName Name, const FGWTVariableValue& Value);
@@ -51,6 +127,24 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Variables")
     FGWTVariableValue GetVariable(FName Name);
 
+    // Look up a variable by name in the slots or the named map, returns false if it has not been set
+    bool TryGetVariable(FName Name, FGWTRuntimeValue& OutValue) const;
+
+    // Size the slot array for a compiled program, all slots start unset
+    void BindVariableSlots(const TArray<FName>& SlotNames);
+
+    // Slot access for the spell VM
+    FORCEINLINE const FGWTRuntimeValue* FindSlot(int32 Slot) const
+    {
+        return VariableSlotsSet[Slot] ? &VariableSlots[Slot] : nullptr;
+    }
+
+    FORCEINLINE void SetSlot(int32 Slot, const FGWTRuntimeValue& Value)
+    {
+        VariableSlots[Slot] = Value;
+        VariableSlotsSet[Slot] = true;
+    }
+
     UFUNCTION(BlueprintCallable, Category = "Execution")
     void PushToStack(UGWTSpellNode* Node);
 
@@ -67,6 +161,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Utility")
     void ClearVariables();
 
+    // Clear all per-cast state while keeping allocated storage, used by the context pool
+    void ResetContext();
+
     UFUNCTION(BlueprintCallable, Category = "Utility")
     void LogContextState();
 };
\ No newline at end of file
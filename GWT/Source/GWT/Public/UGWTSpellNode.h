@@ -10,6 +10,7 @@
 
 // Forward declarations
 class UGWTSpellExecutionContext;
+class UGWTSpell;
 
 /**
  * Base class for all spell nodes in the visual programming system
@@ -46,6 +47,15 @@ public:
     UPROPERTY()
     TArray<UGWTSpellNode*> OutputNodes;
 
+    // Whether a node reached through several paths fires once or once per incoming activation
+    // Read-only to Blueprint like every parameter that shapes the program, set it through SetJoinMode
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Node")
+    EGWTJoinMode JoinMode = EGWTJoinMode::Once;
+
+    // Spell this node belongs to, set by UGWTSpell::AddNode
+    UPROPERTY()
+    UGWTSpell* OwningSpell = nullptr;
+
     // Node position in editor
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Editor")
     FVector2D NodePosition;
@@ -77,6 +87,21 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Connections")
     virtual void RemoveOutputConnection(UGWTSpellNode* Node);
 
+    // True if execution can already flow from this node to Node through output connections
+    UFUNCTION(BlueprintCallable, Category = "Connections")
+    bool CanReach(const UGWTSpellNode* Node) const;
+
+    // Tell the owning spell that this node's connections or properties changed
+    UFUNCTION(BlueprintCallable, Category = "Node")
+    void MarkModified();
+
+    UFUNCTION(BlueprintCallable, Category = "Node")
+    void SetJoinMode(EGWTJoinMode NewJoinMode) { JoinMode = NewJoinMode; MarkModified(); }
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
     // Serialization
     UFUNCTION(BlueprintCallable, Category = "Serialization")
     virtual void Serialize(FArchive& Ar);
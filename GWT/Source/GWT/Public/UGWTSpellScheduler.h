@@ -0,0 +1,68 @@
+// UGWTSpellScheduler.h
+// Resumes latent spell casts once per tick
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FGWTSpellVM.h"
+#include "UGWTSpellScheduler.generated.h"
+
+/**
+ * World subsystem that owns every suspended spell cast
+ * Casts that yield on a delay, cast time or loop budget are parked in one list
+ * and resumed together once per tick, then their contexts go back to the pool
+ * Programs with independent root groups run as sibling tasks that are resumed side by side
+ */
+UCLASS()
+class GWT_API UGWTSpellScheduler : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Subsystem lifetime
+    virtual void Deinitialize() override;
+
+    // Tickable interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Run the first slice of a cast now and keep it if it suspends
+    // The context must come from the world's UGWTSpellContextPool
+    void StartCast(TSharedPtr<const FGWTSpellProgram> Program, UGWTSpellExecutionContext* Context,
+        TSharedPtr<const FGWTSpellDiagnostics> Diagnostics = nullptr);
+
+    // Drop every suspended cast belonging to an actor, e.g. when it dies
+    UFUNCTION(BlueprintCallable, Category = "Spell")
+    void CancelCastsFor(AActor* Caster);
+
+    // Stats
+    UFUNCTION(BlueprintCallable, Category = "Spell")
+    int32 GetNumSuspendedCasts() const { return ActiveTasks.Num() + IncomingTasks.Num(); }
+
+    // Find the scheduler for an actor's world, may be null outside gameplay worlds
+    static UGWTSpellScheduler* Get(const AActor* WorldContext);
+
+protected:
+    // Start one sibling task per root group, each with its own context
+    void StartParallelCast(TSharedPtr<const FGWTSpellProgram> Program, UGWTSpellExecutionContext* Context,
+        TSharedPtr<const FGWTSpellDiagnostics> Diagnostics);
+
+    // Resume every due sibling of the task at FirstIndex together, results are keyed by task index
+    void ResumeSiblings(int32 FirstIndex, double CurrentTime, TMap<int32, EGWTSpellRunResult>& OutResults);
+
+    // Whether a parked task can still run
+    static bool CanResume(const FGWTSpellTask& Task);
+
+    // Hand a finished cast's context back to the pool
+    void FinishTask(FGWTSpellTask& Task);
+
+    // Last sibling group handed out, 0 means none
+    uint32 LastSiblingGroup = 0;
+
+    // Casts resumed by Tick
+    TArray<FGWTSpellTask> ActiveTasks;
+
+    // Casts that suspended since the last tick, merged at the start of the next one
+    TArray<FGWTSpellTask> IncomingTasks;
+};
\ No newline at end of file
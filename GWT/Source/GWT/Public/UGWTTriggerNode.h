@@ -19,13 +19,20 @@ class GWT_API UGWTTriggerNode : public UGWTSpellNode
 public:
     UGWTTriggerNode();
 
-    // Trigger properties
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Trigger")
+    // Trigger properties, read-only to Blueprint so every change goes through a setter below
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trigger")
     EGWTTriggerType TriggerType = EGWTTriggerType::OnCast;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Trigger")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trigger")
     float TriggerValue = 0.0f;
 
+    // Setters, each marks the node modified so the spell's compiled program is rebuilt
+    UFUNCTION(BlueprintCallable, Category = "Trigger")
+    void SetTriggerType(EGWTTriggerType NewTriggerType) { TriggerType = NewTriggerType; MarkModified(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Trigger")
+    void SetTriggerValue(float NewTriggerValue) { TriggerValue = NewTriggerValue; MarkModified(); }
+
     // Implementation
     virtual void Execute(UGWTSpellExecutionContext* Context) override;
     virtual EGWTSpellComponentType GetNodeType() const override;
@@ -35,12 +42,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Trigger")
     virtual bool ShouldTrigger(UGWTSpellExecutionContext* Context);
 
+    // Tests a trigger without needing a node instance
+    // Shared by Execute and the spell VM, returns true if connected nodes should run
+    static bool EvaluateTrigger(UGWTSpellExecutionContext* Context, EGWTTriggerType InTriggerType, float InTriggerValue);
+
 protected:
-    // Event handlers for different trigger types
-    void HandleOnCast(UGWTSpellExecutionContext* Context);
-    void HandleOnHit(UGWTSpellExecutionContext* Context);
-    void HandleOnEnemyEnter(UGWTSpellExecutionContext* Context);
-    void HandleOnHealthBelow(UGWTSpellExecutionContext* Context);
-    void HandleOnManaAbove(UGWTSpellExecutionContext* Context);
-    void HandleOnTimerExpired(UGWTSpellExecutionContext* Context);
+    // Event handlers for different trigger types, each returns whether the trigger fired
+    static bool HandleOnCast(UGWTSpellExecutionContext* Context);
+    static bool HandleOnHit(UGWTSpellExecutionContext* Context);
+    static bool HandleOnEnemyEnter(UGWTSpellExecutionContext* Context);
+    static bool HandleOnHealthBelow(UGWTSpellExecutionContext* Context, float InTriggerValue);
+    static bool HandleOnManaAbove(UGWTSpellExecutionContext* Context, float InTriggerValue);
+    static bool HandleOnTimerExpired(UGWTSpellExecutionContext* Context, float InTriggerValue);
 };
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "UGWTSpellNode.h"
 #include "GWTTypes.h"
+#include "FGWTRuntimeValue.h"
 #include "UGWTVariableNode.generated.h"
 
 /**
@@ -21,18 +22,18 @@ class GWT_API UGWTVariableNode : public UGWTSpellNode
 public:
     UGWTVariableNode();
 
-    // Variable properties
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Variable")
+    // Variable properties, read-only to Blueprint so every change goes through a setter below
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Variable")
     FName VariableName;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Variable")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Variable")
     EGWTVariableType VariableType = EGWTVariableType::Float;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Variable")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Variable")
     FGWTVariableValue DefaultValue;
 
     // The operation to perform (Read, Write, Modify)
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Variable")
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Variable")
     enum class EVariableOperation : uint8
     {
         Read,   // Get value
@@ -43,17 +44,45 @@ public:
         Divide  // Divide value
     } Operation = EVariableOperation::Read;
 
+    // Setters, each marks the node modified so the spell's compiled program is rebuilt
+    UFUNCTION(BlueprintCallable, Category = "Variable")
+    void SetVariableName(FName NewVariableName) { VariableName = NewVariableName; MarkModified(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Variable")
+    void SetVariableType(EGWTVariableType NewVariableType) { VariableType = NewVariableType; MarkModified(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Variable")
+    void SetDefaultValue(const FGWTVariableValue& NewDefaultValue) { DefaultValue = NewDefaultValue; MarkModified(); }
+
+    void SetOperation(EVariableOperation NewOperation) { Operation = NewOperation; MarkModified(); }
+
     // Implementation
     virtual void Execute(UGWTSpellExecutionContext* Context) override;
     virtual EGWTSpellComponentType GetNodeType() const override;
     virtual FString GetNodeTypeAsString() const override;
 
+    // Performs a variable operation by name without needing a node instance, used by Execute
+    static void ApplyVariableOperation(UGWTSpellExecutionContext* Context, FName InVariableName,
+        EVariableOperation InOperation, const FGWTVariableValue& InDefaultValue);
+
+    // Performs a variable operation on a slot resolved by the spell compiler, used by the spell VM
+    static void ApplyVariableOperationToSlot(UGWTSpellExecutionContext* Context, int32 Slot, FName InVariableName,
+        EVariableOperation InOperation, const FGWTRuntimeValue& InDefaultValue);
+
 protected:
+    // Works out the value to store, returns false if the variable should be left as it is
+    // CurrentValue is null when the variable has not been set yet
+    static bool ResolveOperation(UGWTSpellExecutionContext* Context, FName InVariableName, EVariableOperation InOperation,
+        const FGWTRuntimeValue* CurrentValue, const FGWTRuntimeValue& InDefaultValue, FGWTRuntimeValue& OutValue);
+
     // Operation handling methods
-    void ReadVariable(UGWTSpellExecutionContext* Context);
-    void WriteVariable(UGWTSpellExecutionContext* Context);
-    void ModifyVariable(UGWTSpellExecutionContext* Context);
+    static bool ReadVariable(FName InVariableName, const FGWTRuntimeValue* CurrentValue,
+        const FGWTRuntimeValue& InDefaultValue, FGWTRuntimeValue& OutValue);
+    static void WriteVariable(UGWTSpellExecutionContext* Context, FName InVariableName,
+        const FGWTRuntimeValue& InDefaultValue, FGWTRuntimeValue& OutValue);
+    static void ModifyVariable(UGWTSpellExecutionContext* Context, FName InVariableName, EVariableOperation InOperation,
+        const FGWTRuntimeValue* ExistingValue, const FGWTRuntimeValue& InDefaultValue, FGWTRuntimeValue& OutValue);
 
     // Helper for getting operation value from context
-    FGWTVariableValue GetOperationValue(UGWTSpellExecutionContext* Context);
+    static FGWTRuntimeValue GetOperationValue(UGWTSpellExecutionContext* Context, const FGWTRuntimeValue& InDefaultValue);
 };
\ No newline at end of file
@@ -52,4 +52,8 @@ public:
 
     UFUNCTION(BlueprintCallable, Category = "Wand")
     bool ShouldCrit() const;
+
+protected:
+    // Critical hit rolls made, each roll is its own draw on this item's stream
+    mutable uint32 CritRollCount = 0;
 };
\ No newline at end of file